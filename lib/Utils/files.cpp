@@ -326,6 +326,41 @@ bool Files::fileExists(const std::string &path)
     return false;
 }
 
+bool Files::fileStamp(const std::string &path, int64_t &mtime, int64_t &size)
+{
+    mtime = 0;
+    size = 0;
+
+    if(path.empty() || Archives::has_prefix(path))
+        return false;
+
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA attr;
+    std::wstring wpath = Str2WStr(path);
+
+    if(!GetFileAttributesExW(wpath.c_str(), GetFileExInfoStandard, &attr))
+        return false;
+
+    ULARGE_INTEGER t;
+    t.LowPart = attr.ftLastWriteTime.dwLowDateTime;
+    t.HighPart = attr.ftLastWriteTime.dwHighDateTime;
+
+    // FILETIME counts 100ns intervals since 1601-01-01
+    mtime = (int64_t)(t.QuadPart / 10000000ULL) - 11644473600LL;
+    size = ((int64_t)attr.nFileSizeHigh << 32) | (int64_t)attr.nFileSizeLow;
+#else
+    struct stat st;
+
+    if(::stat(path.c_str(), &st) != 0)
+        return false;
+
+    mtime = (int64_t)st.st_mtime;
+    size = (int64_t)st.st_size;
+#endif
+
+    return true;
+}
+
 bool Files::deleteFile(const std::string &path)
 {
 #ifdef _WIN32
@@ -26,6 +26,7 @@
 #define FILES_H
 
 #include <string>
+#include <stdint.h>
 
 struct SDL_RWops;
 
@@ -126,6 +127,14 @@ public:
     int skipBom(SDL_RWops *file, const char **charset = nullptr);
 
     bool fileExists(const std::string &path);
+    /*!
+     * \brief Get the modification time and the size of a file on the real filesystem
+     * \param path Path to the file (archive paths are not supported)
+     * \param mtime Modification time in seconds since the epoch
+     * \param size File size in bytes
+     * \return true if the file exists and its stamp has been retrieved
+     */
+    bool fileStamp(const std::string &path, int64_t &mtime, int64_t &size);
     bool deleteFile(const std::string &path);
     bool copyFile(const std::string &to, const std::string &from, bool override = false);
     bool moveFile(const std::string &to, const std::string &from, bool override = false);
@@ -45,6 +45,7 @@
 #include "graphics/gfx_update.h"
 #include "npc/npc_queues.h"
 #include "main/trees.h"
+#include "main/block_type_index.h"
 #include "main/game_loop_interrupt.h"
 
 void s_makeCoin(Block_t& b)
@@ -236,18 +237,22 @@ void BlockHit(int A, bool HitDown, int whatPlayer)
         PlaySoundSpatial(SFX_PSwitch, b.Location);
         BeltDirection = -BeltDirection; // for the blet direction changing block
 
-        for(auto B = 1; B <= numBlock; B++)
+        for(int type_l = BLKID_CONVEYOR_L_START; type_l <= BLKID_CONVEYOR_L_END; type_l++)
         {
-            if(Block[B].Type >= BLKID_CONVEYOR_L_START && Block[B].Type <= BLKID_CONVEYOR_L_END)
+            int type_r = type_l + (BLKID_CONVEYOR_R_START - BLKID_CONVEYOR_L_START);
+
+            BlockTypeIndex::swapAll(type_l, type_r);
+
+            // the new right conveyors were left ones, and vice versa
+            BlockTypeIndex::for_each(type_r, [](int B)
             {
-                Block[B].Type += BLKID_CONVEYOR_R_START - BLKID_CONVEYOR_L_START;
                 Block[B].Location.SpeedX = (num_t)Layer[Block[B].Layer].ApplySpeedX + 0.8_n;
-            }
-            else if(Block[B].Type >= BLKID_CONVEYOR_R_START && Block[B].Type <= BLKID_CONVEYOR_R_END)
+            });
+
+            BlockTypeIndex::for_each(type_l, [](int B)
             {
-                Block[B].Type -= BLKID_CONVEYOR_R_START - BLKID_CONVEYOR_L_START;
                 Block[B].Location.SpeedX = (num_t)Layer[Block[B].Layer].ApplySpeedX - 0.8_n;
-            }
+            });
         }
     }
 
@@ -267,13 +272,7 @@ void BlockHit(int A, bool HitDown, int whatPlayer)
     if(switch_npc != NPCID_NULL) // switch blocks
     {
         PlaySoundSpatial(SFX_PSwitch, b.Location);
-        for(auto B = 1; B <= numBlock; B++)
-        {
-            if(Block[B].Type == b.Type + 1)
-                Block[B].Type = b.Type + 2;
-            else if(Block[B].Type == b.Type + 2)
-                Block[B].Type = b.Type + 1;
-        }
+        BlockTypeIndex::swapAll(b.Type + 1, b.Type + 2);
 
         for(auto B = 1; B <= numNPCs; B++)
         {
@@ -457,6 +456,7 @@ void BlockHit(int A, bool HitDown, int whatPlayer)
             b.Type = newBlock;
             b.Location.Height = BlockHeight[newBlock];
             b.Location.Width = BlockWidth[newBlock];
+            BlockTypeIndex::update(A);
         }
     }
     else if(b.Special >= 100) // New spawn code
@@ -541,6 +541,7 @@ void BlockHit(int A, bool HitDown, int whatPlayer)
             if(b.Type != 55) // 55 is the bouncy note block
             {
                 b.Type = newBlock;
+                BlockTypeIndex::update(A);
                 b.Location.Height = BlockHeight[newBlock];
 
                 // Was always set in SMBX64. Doing this check here keeps the easy bonus pickup and prevents movement. -- ds-sloth
@@ -1396,6 +1397,7 @@ bool UpdateBlocks()
                                     NewEffect(EFFID_SMOKE_S3_CENTER, b.Location);
                                 b.Special = b.DefaultSpecial;
                                 b.Type = b.DefaultType;
+                                BlockTypeIndex::update(A);
                             }
 
                             b.RespawnDelay_ScreensLeft = 0;
@@ -1423,7 +1425,8 @@ resume_iBlocks:
         else
             is_resume = false;
 
-        auto &ib = Block[iBlock[A]];
+        const int ib_A = iBlock[A];
+        auto &ib = Block[ib_A];
 
         if(is_resume)
         {
@@ -1500,6 +1503,8 @@ resume_TriggerHit:
                 else if(ib.Type == 283)
                     ib.Type = 282;
 
+                BlockTypeIndex::update(ib_A);
+
                 // spin block
                 if(ib.Type == 90 && (ib.ShakeCounter == SHAKE_DOWNUP12_MID || ib.Special == 0) && !ib.forceSmashable)
                 {
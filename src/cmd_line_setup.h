@@ -53,6 +53,8 @@ struct CmdLineSetup_t
     bool testMagicHand = false;
     //! Open in editor
     bool testEditor = false;
+    //! Edit journal to replay on the level opened in the editor, logging the timings
+    std::string editJournalBench;
 
     //! Force log output into console
     bool verboseLogging = false;
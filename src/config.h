@@ -154,6 +154,15 @@ public:
         "vsync", "V-Sync", nullptr,
         config_res_set};
 
+    opt<bool> precise_pacing{this, defaults(false), {}, Scope::Config,
+        "precise-pacing", "Precise frame pacing", "Spin for the last part of each frame wait, uses more CPU"};
+
+    opt_range<int> frame_delay{this, {0, 12, 1}, defaults(0), {}, Scope::Config,
+        "frame-delay", "Frame delay (ms)", "Read the controls later in each frame to reduce the input lag"};
+
+    opt_range<int> run_ahead{this, {0, 3, 1}, defaults(0), {}, Scope::Config,
+        "run-ahead", "Run-ahead frames", "Show the level some frames ahead to reduce the input lag, uses more CPU"};
+
     /* ---- Main - Multiplayer ----*/
     subsection main_multiplayer{this, "multiplayer", "Multiplayer"};
 
@@ -699,10 +708,20 @@ public:
         defaults(g_audioDefaults.bufferSize), {}, Scope::Config,
         "audio-buffer-size", "Buffer size", "Increase for fewer pops but more lag",
         config_audio_set};
+
+#   ifdef LOW_MEM
+    static constexpr int audio_sfx_cache_default = 8;
+#   else
+    static constexpr int audio_sfx_cache_default = 64;
+#   endif
+
+    opt_range<int> audio_sfx_cache{this, {0, 256, 8}, defaults(audio_sfx_cache_default), {}, Scope::Config,
+        "audio-sfx-cache", "SFX memory (MiB)", "Decoded sounds of past levels are kept while all sounds fit"};
 #else
     static constexpr int audio_sample_rate = 44100;
     static constexpr int audio_format = AUDIO_F32SYS;
     static constexpr int audio_buffer_size = 1024;
+    static constexpr int audio_sfx_cache = 8;
 #endif
 
 
@@ -28,6 +28,7 @@
 #include "../controls.h"
 #include "../main/record.h"
 #include "../main/speedrunner.h"
+#include "../main/run_ahead.h"
 #include "message.h"
 #include "change_res.h"
 
@@ -1294,7 +1295,7 @@ MenuControls_t GetMenuControls(int limit_player)
 // player is 1-indexed :(
 void Rumble(int player, int ms, float strength)
 {
-    if(GameMenu || GameOutro)
+    if(GameMenu || GameOutro || RunAhead::hiddenFrame())
         return;
 
     const Screen_t& screen = ScreenByPlayer(player);
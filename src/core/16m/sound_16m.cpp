@@ -581,6 +581,12 @@ void StartMusicIfOnscreen(int section)
     }
 }
 
+void PrefetchSectionMusic(int section)
+{
+    // music modules are already resident in the soundbank
+    UNUSED(section);
+}
+
 void StopMusic()
 {
     if(!musicPlaying || !g_mixerLoaded)
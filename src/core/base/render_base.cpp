@@ -788,6 +788,47 @@ void AbstractRender_t::renderLighting()
 }
 #endif
 
+void AbstractRender_t::renderTextureTiled(int xDst, int yDst, int wDst, int hDst,
+                                          StdPicture &tx,
+                                          int xSrc, int ySrc,
+                                          int wSrc, int hSrc,
+                                          XTColor color)
+{
+    if(wSrc <= 0 || hSrc <= 0)
+        return;
+
+    int right = xDst + wDst;
+    int bottom = yDst + hDst;
+
+    int viewport_w, viewport_h;
+
+    getViewportSize(&viewport_w, &viewport_h);
+
+    if(right > viewport_w)
+        right = viewport_w;
+
+    if(bottom > viewport_h)
+        bottom = viewport_h;
+
+    // skip the tiles fully above or to the left of the viewport
+    if(xDst < 0)
+        xDst += (-xDst / wSrc) * wSrc;
+
+    if(yDst < 0)
+        yDst += (-yDst / hSrc) * hSrc;
+
+    for(int dst_y = yDst; dst_y < bottom; dst_y += hSrc)
+    {
+        int h = (bottom - dst_y < hSrc) ? bottom - dst_y : hSrc;
+
+        for(int dst_x = xDst; dst_x < right; dst_x += wSrc)
+        {
+            int w = (right - dst_x < wSrc) ? right - dst_x : wSrc;
+            renderTexture(dst_x, dst_y, w, h, tx, xSrc, ySrc, color);
+        }
+    }
+}
+
 void AbstractRender_t::renderSizableBlock(int bLeftOnscreen, int bTopOnscreen, int wDst, int hDst, StdPicture &tx)
 {
     int bRightOnscreen = bLeftOnscreen + wDst;
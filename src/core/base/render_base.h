@@ -319,6 +319,12 @@ public:
     virtual void renderTexture(int xDst, int yDst, StdPicture &tx,
                                XTColor color = XTColor()) = 0;
 
+    virtual void renderTextureTiled(int xDst, int yDst, int wDst, int hDst,
+                                    StdPicture &tx,
+                                    int xSrc, int ySrc,
+                                    int wSrc, int hSrc,
+                                    XTColor color = XTColor());
+
     void renderSizableBlock(int xDst, int yDst, int wDst, int hDst, StdPicture &tx);
 
     virtual void renderParticleSystem(StdPicture &tx,
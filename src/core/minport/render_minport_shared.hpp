@@ -568,6 +568,43 @@ void renderTextureScaleEx(int xDst, int yDst, int wDst, int hDst,
         color);
 }
 
+void renderTextureTiled(int xDst, int yDst, int wDst, int hDst,
+                        StdPicture &tx,
+                        int xSrc, int ySrc,
+                        int wSrc, int hSrc,
+                        XTColor color)
+{
+    if(wSrc <= 0 || hSrc <= 0)
+        return;
+
+    int right = xDst + wDst;
+    int bottom = yDst + hDst;
+
+    if(right > g_viewport_w * 2)
+        right = g_viewport_w * 2;
+
+    if(bottom > g_viewport_h * 2)
+        bottom = g_viewport_h * 2;
+
+    // skip the tiles fully above or to the left of the viewport
+    if(xDst < 0)
+        xDst += (-xDst / wSrc) * wSrc;
+
+    if(yDst < 0)
+        yDst += (-yDst / hSrc) * hSrc;
+
+    for(int dst_y = yDst; dst_y < bottom; dst_y += hSrc)
+    {
+        int h = (bottom - dst_y < hSrc) ? bottom - dst_y : hSrc;
+
+        for(int dst_x = xDst; dst_x < right; dst_x += wSrc)
+        {
+            int w = (right - dst_x < wSrc) ? right - dst_x : wSrc;
+            renderTextureBasic(dst_x, dst_y, w, h, tx, xSrc, ySrc, color);
+        }
+    }
+}
+
 #ifndef __16M__
 void renderSizableBlock(int bLeftOnscreen, int bTopOnscreen, int wDst, int hDst, StdPicture &tx)
 {
@@ -442,6 +442,10 @@ void renderTextureScaleEx(int xDst, int yDst, int wDst, int hDst,
         color);
 }
 
+void renderTextureTiled(int, int, int, int, StdPicture&, int, int, int, int, XTColor)
+{
+}
+
 void renderSizableBlock(int, int, int, int, StdPicture&)
 {
 }
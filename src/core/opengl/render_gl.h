@@ -773,6 +773,12 @@ public:
     void renderTexture(int xDst, int yDst, StdPicture &tx,
                        XTColor color = XTColor()) override;
 
+    void renderTextureTiled(int xDst, int yDst, int wDst, int hDst,
+                            StdPicture &tx,
+                            int xSrc, int ySrc,
+                            int wSrc, int hSrc,
+                            XTColor color = XTColor()) override;
+
     void renderParticleSystem(StdPicture &tx,
                               double camX,
                               double camY) override;
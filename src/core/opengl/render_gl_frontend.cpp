@@ -1624,6 +1624,85 @@ void RenderGL::renderTexture(int xDst, int yDst, int wDst, int hDst,
     m_drawQueued = true;
 }
 
+void RenderGL::renderTextureTiled(int xDst, int yDst, int wDst, int hDst,
+                                  StdPicture &tx,
+                                  int xSrc, int ySrc,
+                                  int wSrc, int hSrc,
+                                  XTColor color)
+{
+#ifdef USE_RENDER_BLOCKING
+    SDL_assert(!m_blockRender);
+#endif
+
+    if(!tx.inited || wSrc <= 0 || hSrc <= 0)
+        return;
+
+    if(!tx.d.texture_id && tx.l.lazyLoaded)
+        lazyLoad(tx);
+
+    if(!tx.d.texture_id)
+    {
+        D_pLogWarningNA("Attempt to render an empty texture!");
+        return;
+    }
+
+    SDL_assert_release(tx.d.texture_id);
+
+    // Don't go more than size of texture
+    int tile_w = SDL_min(wSrc, tx.w - xSrc);
+    int tile_h = SDL_min(hSrc, tx.h - ySrc);
+
+    if(tile_w <= 0 || tile_h <= 0)
+        return;
+
+    int right = SDL_min(xDst + wDst, m_viewport.w);
+    int bottom = SDL_min(yDst + hDst, m_viewport.h);
+
+    // skip the tiles fully above or to the left of the viewport
+    if(xDst < 0)
+        xDst += (-xDst / wSrc) * wSrc;
+
+    if(yDst < 0)
+        yDst += (-yDst / hSrc) * hSrc;
+
+    if(xDst >= right || yDst >= bottom)
+        return;
+
+    // all tiles share a single draw context and depth
+    DrawContext_t context = {tx.d.shader_program ? *tx.d.shader_program : m_standard_program, &tx};
+
+    Vertex_t::Tint tint = F_TO_B(color);
+
+    int16_t cur_depth = m_render_planes.next();
+
+    bool draw_opaque = (tx.d.use_depth_test && tint[3] == 255 && !tx.d.shader_program);
+    auto& vertex_list = (draw_opaque ? m_unordered_draw_queue[context] : getOrderedDrawVertexList(context, cur_depth));
+
+    for(int dst_y = yDst; dst_y < bottom; dst_y += hSrc)
+    {
+        int h = SDL_min(tile_h, bottom - dst_y);
+
+        for(int dst_x = xDst; dst_x < right; dst_x += wSrc)
+        {
+            int w = SDL_min(tile_w, right - dst_x);
+
+            RectI draw_loc = RectI(dst_x, dst_y, dst_x + w, dst_y + h);
+
+            RectF draw_source_raw = RectF(xSrc, ySrc, xSrc + w, ySrc + h);
+            RectF draw_source = draw_source_raw * PointF(tx.d.w_scale, tx.d.h_scale);
+
+            addVertices(vertex_list, draw_loc, draw_source, cur_depth, tint);
+
+#ifdef THEXTECH_BUILD_GL_MODERN
+            if(tx.l.light_info)
+                addLights(*tx.l.light_info, QuadI(draw_loc), draw_source_raw, cur_depth);
+#endif
+        }
+    }
+
+    m_drawQueued = true;
+}
+
 void RenderGL::renderTextureFL(int xDst, int yDst, int wDst, int hDst,
                                   StdPicture &tx,
                                   int xSrc, int ySrc,
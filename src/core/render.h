@@ -715,6 +715,37 @@ E_INLINE void renderTextureBasic(int xDst, int yDst, StdPicture &tx,
 void renderTextureBasic(float xDst, float yDst, StdPicture &tx,
                            XTColor color = XTColor()) = delete;
 
+/*!
+ * \brief Fills a region by repeating a part of the texture
+ * \param xDst left x coordinate of the region (in viewport coordinates), the first tile is placed here
+ * \param yDst top y coordinate of the region (in viewport coordinates), the first tile is placed here
+ * \param wDst width of the region
+ * \param hDst height of the region
+ * \param tx Source texture
+ * \param xSrc left x coordinate of the repeated part of the texture
+ * \param ySrc top y coordinate of the repeated part of the texture
+ * \param wSrc width of the repeated part (the horizontal stride of the tiles)
+ * \param hSrc height of the repeated part (the vertical stride of the tiles)
+ * \param color Tint
+ *
+ * Equivalent to a renderTextureBasic call per tile, with the tiles at the right and bottom
+ * edges of the region cropped, and the tiles outside of the viewport skipped.
+ */
+E_INLINE void renderTextureTiled(int xDst, int yDst, int wDst, int hDst,
+                                 StdPicture &tx,
+                                 int xSrc, int ySrc,
+                                 int wSrc, int hSrc,
+                                 XTColor color = XTColor()) TAIL
+#ifndef RENDER_CUSTOM
+{
+    g_render->renderTextureTiled(xDst, yDst, wDst, hDst,
+                                 tx,
+                                 xSrc, ySrc,
+                                 wSrc, hSrc,
+                                 color);
+}
+#endif
+
 /*!
  * \brief Draws a sizable block
  * \param xDst left x coordinate of block (in viewport coordinates)
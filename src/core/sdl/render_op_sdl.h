@@ -27,6 +27,7 @@
 #include <vector>
 
 #include <SDL2/SDL_assert.h>
+#include <SDL2/SDL_stdinc.h>
 
 #include "std_picture.h"
 
@@ -40,7 +41,8 @@ struct XRenderOp
         texture = 0,
         rect,
         circle,
-        circle_hole
+        circle_hole,
+        texture_tiled
     };
 
     struct Traits
@@ -72,7 +74,7 @@ struct XRenderOp
         return wDst;
     }
 
-    int16_t xSrc, ySrc, wSrc, hSrc; // used if (traits & Traits::src_rect) is set
+    int16_t xSrc, ySrc, wSrc, hSrc; // used if (traits & Traits::src_rect) is set, wSrc and hSrc are the tile strides for texture_tiled
 
     uint16_t angle; // used if (traits & Traits::rotation) is set
 
@@ -85,10 +87,30 @@ struct XRenderQueue
     std::vector<int32_t> indices;
     uint16_t size = 0;
 
+    // execution order of the ops after batching, and the end positions of the batches in it
+    std::vector<uint16_t> order;
+    std::vector<uint16_t> batch_ends;
+
+    // how many batches back an op may be moved to join a batch of the same texture
+    static constexpr int c_batchLookback = 8;
+
+    struct Batch
+    {
+        StdPicture* texture;
+        uint8_t plane;
+        uint16_t head, tail;
+        int16_t left, top, right, bottom;
+    };
+
+    std::vector<Batch> m_batches;
+    std::vector<uint16_t> m_next;
+
     inline void clear()
     {
         ops.clear();
         indices.clear();
+        order.clear();
+        batch_ends.clear();
         size = 0;
     }
 
@@ -109,6 +131,129 @@ struct XRenderQueue
     {
         pdqsort(indices.begin(), indices.end());
     }
+
+    // conservative screen bounds of an op
+    static inline void bounds(const XRenderOp& op, int& l, int& t, int& r, int& b)
+    {
+        switch(op.type)
+        {
+        case XRenderOp::Type::circle:
+            l = op.xDst - op.radius();
+            t = op.yDst - op.radius();
+            r = op.xDst + op.radius();
+            b = op.yDst + op.radius();
+            break;
+
+        case XRenderOp::Type::circle_hole:
+            // covers everything around the hole
+            l = t = INT16_MIN;
+            r = b = INT16_MAX;
+            break;
+
+        default:
+            l = op.xDst;
+            t = op.yDst;
+            r = op.xDst + op.wDst;
+            b = op.yDst + op.hDst;
+
+            if(op.traits & XRenderOp::Traits::rotation)
+            {
+                int ext = (op.wDst > op.hDst) ? op.wDst : op.hDst;
+                l -= ext;
+                t -= ext;
+                r += ext;
+                b += ext;
+            }
+
+            break;
+        }
+    }
+
+    /*!
+     * \brief Sorts the queue by plane, and groups the ops of the same texture into batches
+     *
+     * Within a plane, a texture op is moved back to join the latest batch of its texture
+     * only if it doesn't overlap any op queued in between, so the result on the screen
+     * is the same as the one of the submission order. All SDL textures share the same
+     * blend mode, so the texture alone decides if the ops can be batched.
+     */
+    inline void batch()
+    {
+        sort();
+
+        m_batches.clear();
+        m_next.resize(size);
+
+        for(int32_t index : indices)
+        {
+            uint16_t i = (uint16_t)(index & 0xFFFF);
+            uint8_t plane = (uint8_t)(index >> 16);
+            const XRenderOp& op = ops[i];
+
+            int l, t, r, b;
+            bounds(op, l, t, r, b);
+
+            StdPicture* texture = (op.type == XRenderOp::Type::texture || op.type == XRenderOp::Type::texture_tiled) ? op.texture : nullptr;
+
+            Batch* target = nullptr;
+
+            if(texture)
+            {
+                int end = (int)m_batches.size() - c_batchLookback;
+
+                for(int j = (int)m_batches.size() - 1; j >= 0 && j >= end; j--)
+                {
+                    Batch& cand = m_batches[j];
+
+                    if(cand.plane != plane)
+                        break;
+
+                    if(cand.texture == texture)
+                    {
+                        target = &cand;
+                        break;
+                    }
+
+                    if(cand.left < r && l < cand.right && cand.top < b && t < cand.bottom)
+                        break;
+                }
+            }
+
+            m_next[i] = UINT16_MAX;
+
+            if(!target)
+            {
+                Batch nb;
+                nb.texture = texture;
+                nb.plane = plane;
+                nb.head = nb.tail = i;
+                nb.left = (int16_t)SDL_max(l, INT16_MIN);
+                nb.top = (int16_t)SDL_max(t, INT16_MIN);
+                nb.right = (int16_t)SDL_min(r, INT16_MAX);
+                nb.bottom = (int16_t)SDL_min(b, INT16_MAX);
+                m_batches.push_back(nb);
+                continue;
+            }
+
+            m_next[target->tail] = i;
+            target->tail = i;
+            target->left = (int16_t)SDL_max(SDL_min((int)target->left, l), INT16_MIN);
+            target->top = (int16_t)SDL_max(SDL_min((int)target->top, t), INT16_MIN);
+            target->right = (int16_t)SDL_min(SDL_max((int)target->right, r), INT16_MAX);
+            target->bottom = (int16_t)SDL_min(SDL_max((int)target->bottom, b), INT16_MAX);
+        }
+
+        order.clear();
+        batch_ends.clear();
+
+        for(const Batch& cur : m_batches)
+        {
+            for(uint16_t i = cur.head; i != UINT16_MAX; i = m_next[i])
+                order.push_back(i);
+
+            batch_ends.push_back((uint16_t)order.size());
+        }
+    }
 };
 
 #endif // #ifndef RENDER_OP_SDL_H
@@ -38,6 +38,7 @@
 
 #include "graphics.h"
 #include "controls.h"
+#include "frame_timer.h"
 #include "sound.h"
 
 #ifndef UNUSED
@@ -273,6 +274,7 @@ void RenderSDL::repaint()
         flushRenderQueue();
 
         SDL_RenderPresent(m_gRenderer);
+        publishQueueStats();
         return;
     }
 
@@ -301,10 +303,22 @@ void RenderSDL::repaint()
     flushRenderQueue();
 
     SDL_RenderPresent(m_gRenderer);
+    publishQueueStats();
 
     m_recent_draw_plane = 0;
 }
 
+void RenderSDL::publishQueueStats()
+{
+    g_stats.renderOps = m_frame_ops;
+    g_stats.renderBatches = m_frame_batches;
+    g_stats.renderGeometryCalls = m_frame_geometry;
+
+    m_frame_ops = 0;
+    m_frame_batches = 0;
+    m_frame_geometry = 0;
+}
+
 void RenderSDL::updateViewport()
 {
     flushRenderQueue();
@@ -665,14 +679,162 @@ void RenderSDL::flushRenderQueue()
     if(!m_render_queue.size)
         return;
 
-    m_render_queue.sort();
+    m_render_queue.batch();
+
+    m_frame_ops += m_render_queue.size;
+    m_frame_batches += (int)m_render_queue.batch_ends.size();
 
-    for(uint32_t i : m_render_queue.indices)
-        execute(m_render_queue.ops[i & 0xFFFF]);
+    size_t begin = 0;
+
+    for(uint16_t end : m_render_queue.batch_ends)
+    {
+#if SDL_COMPILEDVERSION >= SDL_VERSIONNUM(2, 0, 18)
+        const XRenderOp& first = m_render_queue.ops[m_render_queue.order[begin]];
+
+        if(end - begin > 1 && (first.type == XRenderOp::Type::texture || first.type == XRenderOp::Type::texture_tiled))
+        {
+            executeBatch(&m_render_queue.order[begin], end - begin);
+            begin = end;
+            continue;
+        }
+#endif
+
+        for(; begin < end; begin++)
+            execute(m_render_queue.ops[m_render_queue.order[begin]]);
+    }
 
     m_render_queue.clear();
 }
 
+#if SDL_COMPILEDVERSION >= SDL_VERSIONNUM(2, 0, 18)
+// vertices of the current texture batch
+static std::vector<SDL_Vertex> s_geometry_vertices;
+static std::vector<int> s_geometry_indices;
+
+static void s_addGeometryQuad(int x, int y, int w, int h, float u1, float v1, float u2, float v2, XTColor color)
+{
+    SDL_Color c = {color.r, color.g, color.b, color.a};
+    int base = (int)s_geometry_vertices.size();
+
+    s_geometry_vertices.push_back({{(float)x, (float)y}, c, {u1, v1}});
+    s_geometry_vertices.push_back({{(float)(x + w), (float)y}, c, {u2, v1}});
+    s_geometry_vertices.push_back({{(float)(x + w), (float)(y + h)}, c, {u2, v2}});
+    s_geometry_vertices.push_back({{(float)x, (float)(y + h)}, c, {u1, v2}});
+
+    const int quad[6] = {0, 1, 2, 0, 2, 3};
+    for(int i : quad)
+        s_geometry_indices.push_back(base + i);
+}
+
+// returns false if the op can't be represented by plain quads
+static bool s_addGeometry(const XRenderOp& op, float tex_w, float tex_h)
+{
+    const auto& tx = *op.texture;
+
+    // these need the special paths of execute()
+    if(op.traits & XRenderOp::Traits::rotoflip)
+        return false;
+
+    if(tx.d.w_scale == 0.5f)
+        return false;
+
+    // same source rectangles as the ones of execute()
+    if(op.type == XRenderOp::Type::texture && !(op.traits & XRenderOp::Traits::src_rect))
+    {
+        s_addGeometryQuad(op.xDst, op.yDst, op.wDst, op.hDst, 0.f, 0.f, 1.f, 1.f, op.color);
+        return true;
+    }
+
+    if(op.type == XRenderOp::Type::texture)
+    {
+        int sx = (int)(op.xSrc * tx.d.w_scale), sy = (int)(op.ySrc * tx.d.h_scale);
+        int sw = (int)(op.wSrc * tx.d.w_scale), sh = (int)(op.hSrc * tx.d.h_scale);
+
+        s_addGeometryQuad(op.xDst, op.yDst, op.wDst, op.hDst,
+                            sx / tex_w, sy / tex_h, (sx + sw) / tex_w, (sy + sh) / tex_h,
+                          op.color);
+        return true;
+    }
+
+    // texture_tiled: same expansion as at execute()
+    int tile_w = SDL_min((int)op.wSrc, tx.w - op.xSrc);
+    int tile_h = SDL_min((int)op.hSrc, tx.h - op.ySrc);
+
+    if(tile_w <= 0 || tile_h <= 0)
+        return true;
+
+    int right = op.xDst + op.wDst;
+    int bottom = op.yDst + op.hDst;
+
+    int sx = (int)(op.xSrc * tx.d.w_scale), sy = (int)(op.ySrc * tx.d.h_scale);
+
+    for(int dst_y = op.yDst; dst_y < bottom; dst_y += op.hSrc)
+    {
+        int h = SDL_min(tile_h, bottom - dst_y);
+        int sh = (int)(h * tx.d.h_scale);
+
+        for(int dst_x = op.xDst; dst_x < right; dst_x += op.wSrc)
+        {
+            int w = SDL_min(tile_w, right - dst_x);
+            int sw = (int)(w * tx.d.w_scale);
+
+            s_addGeometryQuad(dst_x, dst_y, w, h,
+                              sx / tex_w, sy / tex_h, (sx + sw) / tex_w, (sy + sh) / tex_h,
+                              op.color);
+        }
+    }
+
+    return true;
+}
+
+void RenderSDL::flushGeometry(StdPicture& tx)
+{
+    if(s_geometry_indices.empty())
+        return;
+
+    // the tint is taken from the vertex colors
+    txColorMod(tx.d, XTColor());
+
+    SDL_RenderGeometry(m_gRenderer, tx.d.texture,
+                       s_geometry_vertices.data(), (int)s_geometry_vertices.size(),
+                       s_geometry_indices.data(), (int)s_geometry_indices.size());
+
+    m_frame_geometry++;
+
+    s_geometry_vertices.clear();
+    s_geometry_indices.clear();
+}
+
+void RenderSDL::executeBatch(const uint16_t* order, size_t count)
+{
+    StdPicture* texture = m_render_queue.ops[order[0]].texture;
+
+    if(!texture || !texture->inited || !texture->d.texture)
+    {
+        for(size_t i = 0; i < count; i++)
+            execute(m_render_queue.ops[order[i]]);
+
+        return;
+    }
+
+    int tex_w = 1, tex_h = 1;
+    SDL_QueryTexture(texture->d.texture, nullptr, nullptr, &tex_w, &tex_h);
+
+    for(size_t i = 0; i < count; i++)
+    {
+        const XRenderOp& op = m_render_queue.ops[order[i]];
+
+        if(!s_addGeometry(op, (float)tex_w, (float)tex_h))
+        {
+            flushGeometry(*texture);
+            execute(op);
+        }
+    }
+
+    flushGeometry(*texture);
+}
+#endif
+
 void RenderSDL::execute(const XRenderOp& op)
 {
 #ifdef USE_RENDER_BLOCKING
@@ -920,6 +1082,47 @@ void RenderSDL::execute(const XRenderOp& op)
         break;
     }
 
+    case XRenderOp::Type::texture_tiled:
+    {
+        if(!op.texture || !op.texture->inited)
+            break;
+
+        const auto& tx = *op.texture;
+
+        // don't go more than size of texture
+        int tile_w = SDL_min((int)op.wSrc, tx.w - op.xSrc);
+        int tile_h = SDL_min((int)op.hSrc, tx.h - op.ySrc);
+
+        if(tile_w <= 0 || tile_h <= 0)
+            break;
+
+        // expand into the regular texture ops
+        XRenderOp tile = op;
+        tile.type = XRenderOp::Type::texture;
+        tile.traits = XRenderOp::Traits::src_rect;
+
+        int right = op.xDst + op.wDst;
+        int bottom = op.yDst + op.hDst;
+
+        for(int dst_y = op.yDst; dst_y < bottom; dst_y += op.hSrc)
+        {
+            tile.yDst = dst_y;
+            tile.hDst = SDL_min(tile_h, bottom - dst_y);
+            tile.hSrc = tile.hDst;
+
+            for(int dst_x = op.xDst; dst_x < right; dst_x += op.wSrc)
+            {
+                tile.xDst = dst_x;
+                tile.wDst = SDL_min(tile_w, right - dst_x);
+                tile.wSrc = tile.wDst;
+
+                execute(tile);
+            }
+        }
+
+        break;
+    }
+
     default:
         SDL_assert_release(false); // illegal render op type!
         break;
@@ -1186,6 +1389,62 @@ void RenderSDL::renderTexture(int xDst, int yDst, int wDst, int hDst,
     op.color = color;
 }
 
+void RenderSDL::renderTextureTiled(int xDst, int yDst, int wDst, int hDst,
+                                   StdPicture &tx,
+                                   int xSrc, int ySrc,
+                                   int wSrc, int hSrc,
+                                   XTColor color)
+{
+#ifdef USE_RENDER_BLOCKING
+    SDL_assert(!m_blockRender);
+#endif
+
+    if(!tx.inited || wSrc <= 0 || hSrc <= 0)
+        return;
+
+    if(!tx.d.texture && tx.l.lazyLoaded)
+        lazyLoad(tx);
+
+    if(!tx.d.texture)
+    {
+        D_pLogWarningNA("Attempt to render an empty texture!");
+        return;
+    }
+
+    int right = SDL_min(xDst + wDst, m_viewport_w);
+    int bottom = SDL_min(yDst + hDst, m_viewport_h);
+
+    // skip the tiles fully above or to the left of the viewport
+    if(xDst < 0)
+        xDst += (-xDst / wSrc) * wSrc;
+
+    if(yDst < 0)
+        yDst += (-yDst / hSrc) * hSrc;
+
+    if(xDst >= right || yDst >= bottom)
+        return;
+
+    // a single queue entry for the whole region, it gets expanded at execute()
+    XRenderOp& op = m_render_queue.push(m_recent_draw_plane);
+
+    op.type = XRenderOp::Type::texture_tiled;
+    op.traits = XRenderOp::Traits::src_rect;
+
+    op.texture = &tx;
+
+    op.xDst = xDst + m_viewport_offset_x;
+    op.yDst = yDst + m_viewport_offset_y;
+    op.wDst = right - xDst;
+    op.hDst = bottom - yDst;
+
+    op.xSrc = xSrc;
+    op.ySrc = ySrc;
+    op.wSrc = wSrc;
+    op.hSrc = hSrc;
+
+    op.color = color;
+}
+
 void RenderSDL::renderTextureFL(int xDst, int yDst, int wDst, int hDst,
                                   StdPicture &tx,
                                   int xSrc, int ySrc,
@@ -52,6 +52,11 @@ class RenderSDL final : public AbstractRender_t
     // current draw plane
     uint8_t m_recent_draw_plane = 0;
 
+    // render queue counters of the current frame
+    int m_frame_ops = 0;
+    int m_frame_batches = 0;
+    int m_frame_geometry = 0;
+
     // Scale of virtual and window resolutuins
     float m_scale_x = 1.f;
     float m_scale_y = 1.f;
@@ -211,6 +216,21 @@ public:
      */
     void execute(const XRenderOp& op);
 
+    /*!
+     * \brief Executes a batch of ops of the same texture, merging them into SDL_RenderGeometry calls where possible (SDL 2.0.18+)
+     */
+    void executeBatch(const uint16_t* order, size_t count);
+
+    /*!
+     * \brief Submits the geometry collected by executeBatch()
+     */
+    void flushGeometry(StdPicture& tx);
+
+    /*!
+     * \brief Passes the render queue counters of the finished frame to the performance stats
+     */
+    void publishQueueStats();
+
     // Draw primitives
 
     void renderRect(int x, int y, int w, int h,
@@ -259,6 +279,12 @@ public:
     void renderTexture(int xDst, int yDst, StdPicture &tx,
                        XTColor color = XTColor()) override;
 
+    void renderTextureTiled(int xDst, int yDst, int wDst, int hDst,
+                            StdPicture &tx,
+                            int xSrc, int ySrc,
+                            int wSrc, int hSrc,
+                            XTColor color = XTColor()) override;
+
 
 
 
@@ -30,6 +30,8 @@
 enum NPCID : vbint_t;
 
 extern std::string Backup_FullFileName;
+//! NEW: in-memory copy of the level being tested from the editor (empty if the level is tested from the file)
+extern std::string Backup_LevelData;
 extern int editor_section_toast;
 
 extern bool HasCursor;
@@ -67,6 +69,11 @@ void SetSection(int i);
 void EditorBackup();
 void EditorRestore();
 
+// NEW: keeps the level in memory to test it from the editor, falls back to the temporary file
+void EditorSaveTestLevel();
+// NEW: opens the tested level at FullFileName, from the memory copy if it exists
+bool EditorOpenTestLevel();
+
 // this sub handles the level editor
 // it is still called when the player is testing a level in the editor in windowed mode
 extern void UpdateEditor();
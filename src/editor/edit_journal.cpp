@@ -0,0 +1,1315 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "editor/edit_journal.h"
+
+#ifndef LOW_MEM
+
+#include <vector>
+#include <cstring>
+#include <stdint.h>
+
+#include <AppPath/app_path.h>
+#include <Logger/logger.h>
+#include <Utils/files.h>
+#include <Utils/elapsed_timer.h>
+#include <SDL2/SDL_rwops.h>
+#include <PGE_File_Formats/file_formats.h>
+#include <fmt_format_ne.h>
+
+#include "../version.h"
+#include "globals.h"
+#include "global_strings.h"
+#include "layers.h"
+#include "main/level_file.h"
+#include "write_level.h"
+
+
+//! Bump this when the layout of the journal file changes
+static constexpr uint32_t c_journalVersion = 2;
+static const char c_journalMagic[4] = {'T', 'X', 'E', 'J'};
+
+//! Editor frames without further edits of the sections, layers, or events before the journal gets compacted
+static constexpr int c_settleFrames = 33;
+//! The appended part is never compacted while the journal is smaller than this
+static constexpr size_t c_compactMinBytes = 256 * 1024;
+
+enum JournalKind
+{
+    JK_BLOCK = EditJournal::OBJ_BLOCK,
+    JK_BGO = EditJournal::OBJ_BGO,
+    JK_NPC = EditJournal::OBJ_NPC,
+    JK_WARP = EditJournal::OBJ_WARP,
+    JK_WATER = EditJournal::OBJ_WATER,
+    JK_START = EditJournal::OBJ_START,
+    JK_COUNT
+};
+
+enum JournalRecord
+{
+    // layer names, event names, and snapshot of the level in the format of its file, always the first record
+    JR_BASE = 1,
+    // count of the objects of a kind
+    JR_COUNT,
+    // fields of a single object slot, see s_slotFields()
+    JR_SLOT,
+    // records since the previous commit are complete
+    JR_COMMIT
+};
+
+static const int c_kindMax[JK_COUNT] = {maxBlocks, maxBackgrounds, maxNPCs, maxWarps, maxWater, 2};
+
+struct KindState_t
+{
+    int count = 0;
+    // serialized fields of the slots 1...count
+    std::vector<std::string> recs;
+    // slots reported by the editor since the previous append
+    std::vector<int> dirty;
+    std::vector<bool> is_dirty;
+
+    void resize(int n)
+    {
+        count = n;
+        recs.resize((size_t)n);
+    }
+
+    void mark(int i, int max)
+    {
+        if(is_dirty.empty())
+            is_dirty.resize((size_t)max + 1);
+
+        if(i >= 1 && i <= max && !is_dirty[(size_t)i])
+        {
+            is_dirty[(size_t)i] = true;
+            dirty.push_back(i);
+        }
+    }
+};
+
+// the state of the level as it has been written into the journal
+static KindState_t s_shadow[JK_COUNT];
+
+static std::string s_levelPath;
+static bool s_active = false;
+static bool s_recoveryPending = false;
+static bool s_needCompact = false;
+static int s_settleFrames = 0;
+static uint32_t s_namesHash = 0;
+static size_t s_baseBytes = 0;
+static size_t s_journalBytes = 0;
+
+// player starts are a fixed pair
+static int s_startCount = 2;
+
+
+static uint32_t s_hashBytes(uint32_t h, const void *data, size_t size)
+{
+    const uint8_t *p = reinterpret_cast<const uint8_t*>(data);
+
+    for(size_t i = 0; i < size; i++)
+    {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+
+    return h;
+}
+
+static uint32_t s_hashStr(uint32_t h, const std::string &s)
+{
+    uint32_t len = (uint32_t)s.size();
+    h = s_hashBytes(h, &len, sizeof(len));
+    return s_hashBytes(h, s.data(), s.size());
+}
+
+static std::string s_journalPath(const std::string &levelPath)
+{
+    return AppPathManager::settingsRoot() + fmt::format_ne("editor-journal-{0:08x}.bin", s_hashStr(2166136261u, levelPath));
+}
+
+// the slot records store the indexes of types and enums, so a journal is only replayed by the same build
+static uint32_t s_layoutSignature()
+{
+    uint32_t h = s_hashBytes(2166136261u, &c_journalVersion, sizeof(c_journalVersion));
+
+    h = s_hashStr(h, V_BUILD_VER);
+
+#ifdef THEXTECH_FIXED_POINT
+    const uint8_t fixed_point = 1;
+#else
+    const uint8_t fixed_point = 0;
+#endif
+
+    return s_hashBytes(h, &fixed_point, sizeof(fixed_point));
+}
+
+// slot records refer to layers and events by index, so any change of the names needs a new base
+static uint32_t s_calcNamesHash()
+{
+    uint32_t h = s_hashBytes(2166136261u, &numLayers, sizeof(numLayers));
+
+    for(int i = 0; i < numLayers; i++)
+        h = s_hashStr(h, Layer[i].Name);
+
+    h = s_hashBytes(h, &numEvents, sizeof(numEvents));
+
+    for(int i = 0; i < numEvents; i++)
+        h = s_hashStr(h, Events[i].Name);
+
+    return h;
+}
+
+static int &s_count(int kind)
+{
+    switch(kind)
+    {
+    case JK_BLOCK:
+        return numBlock;
+    case JK_BGO:
+        return numBackground;
+    case JK_NPC:
+        return numNPCs;
+    case JK_WARP:
+        return numWarps;
+    case JK_WATER:
+        return numWater;
+    default:
+        return s_startCount;
+    }
+}
+
+// string fields of the slot
+static void s_freeStrings(int kind, int i)
+{
+    if(kind == JK_NPC)
+        FreeS(NPC[i].Text);
+    else if(kind == JK_WARP)
+    {
+        FreeS(Warp[i].level);
+        FreeS(Warp[i].StarsMsg);
+    }
+}
+
+static void s_remapSlot(int kind, int i, const layerindex_t *layers, const eventindex_t *events)
+{
+    switch(kind)
+    {
+    case JK_BLOCK:
+    {
+        Block_t &b = Block[i];
+        b.Layer = layers[b.Layer];
+        b.TriggerHit = events[b.TriggerHit];
+        b.TriggerDeath = events[b.TriggerDeath];
+        b.TriggerLast = events[b.TriggerLast];
+        break;
+    }
+    case JK_BGO:
+        Background[i].Layer = layers[Background[i].Layer];
+        break;
+    case JK_NPC:
+    {
+        NPC_t &n = NPC[i];
+        n.Layer = layers[n.Layer];
+        n.AttLayer = layers[n.AttLayer];
+        n.TriggerActivate = events[n.TriggerActivate];
+        n.TriggerDeath = events[n.TriggerDeath];
+        n.TriggerTalk = events[n.TriggerTalk];
+        n.TriggerLast = events[n.TriggerLast];
+        break;
+    }
+    case JK_WARP:
+    {
+        Warp_t &w = Warp[i];
+        w.Layer = layers[w.Layer];
+        w.eventEnter = events[w.eventEnter];
+        w.eventExit = events[w.eventExit];
+        break;
+    }
+    case JK_WATER:
+        Water[i].Layer = layers[Water[i].Layer];
+        break;
+    default:
+        break;
+    }
+}
+
+
+static void s_put32(std::vector<uint8_t> &out, uint32_t v)
+{
+    out.push_back((uint8_t)(v & 0xFF));
+    out.push_back((uint8_t)((v >> 8) & 0xFF));
+    out.push_back((uint8_t)((v >> 16) & 0xFF));
+    out.push_back((uint8_t)((v >> 24) & 0xFF));
+}
+
+static void s_put64(std::vector<uint8_t> &out, int64_t v)
+{
+    s_put32(out, (uint32_t)((uint64_t)v & 0xFFFFFFFF));
+    s_put32(out, (uint32_t)((uint64_t)v >> 32));
+}
+
+static void s_putStr(std::vector<uint8_t> &out, const std::string &s)
+{
+    s_put32(out, (uint32_t)s.size());
+    out.insert(out.end(), s.begin(), s.end());
+}
+
+struct JournalReader
+{
+    const uint8_t *cur;
+    const uint8_t *end;
+    bool ok = true;
+
+    uint8_t get8()
+    {
+        if(cur + 1 > end)
+        {
+            ok = false;
+            return 0;
+        }
+
+        return *(cur++);
+    }
+
+    uint32_t get32()
+    {
+        if(cur + 4 > end)
+        {
+            ok = false;
+            return 0;
+        }
+
+        uint32_t ret = (uint32_t)cur[0]
+            | ((uint32_t)cur[1] << 8)
+            | ((uint32_t)cur[2] << 16)
+            | ((uint32_t)cur[3] << 24);
+
+        cur += 4;
+
+        return ret;
+    }
+
+    int64_t get64()
+    {
+        uint64_t lo = get32();
+        uint64_t hi = get32();
+        return (int64_t)(lo | (hi << 32));
+    }
+
+    const uint8_t *getBytes(size_t len)
+    {
+        if(!ok || len > (size_t)(end - cur))
+        {
+            ok = false;
+            return nullptr;
+        }
+
+        const uint8_t *ret = cur;
+        cur += len;
+
+        return ret;
+    }
+
+    void getStr(std::string &s)
+    {
+        uint32_t len = get32();
+        const uint8_t *p = getBytes(len);
+
+        if(!p)
+        {
+            s.clear();
+            return;
+        }
+
+        s.assign(reinterpret_cast<const char*>(p), len);
+    }
+};
+
+// writes the fields of a slot, see s_slotFields()
+struct SlotWriter
+{
+    std::vector<uint8_t> &out;
+
+    template<class T>
+    void val(T &v)
+    {
+        s_put32(out, (uint32_t)(int32_t)v);
+    }
+
+    void num(num_t &v)
+    {
+        int64_t raw;
+        static_assert(sizeof(raw) == sizeof(v.i), "unexpected size of num_t");
+        memcpy(&raw, &v.i, sizeof(raw));
+        s_put64(out, raw);
+    }
+
+    void str(stringindex_t &idx)
+    {
+        s_putStr(out, GetS(idx));
+    }
+};
+
+// reads the fields of a slot reset to its defaults, the strings must have been freed before
+struct SlotReader
+{
+    JournalReader &r;
+
+    template<class T>
+    void val(T &v)
+    {
+        v = static_cast<T>((int32_t)r.get32());
+    }
+
+    void num(num_t &v)
+    {
+        int64_t raw = r.get64();
+        memcpy(&v.i, &raw, sizeof(raw));
+    }
+
+    void str(stringindex_t &idx)
+    {
+        std::string s;
+        r.getStr(s);
+
+        idx = STRINGINDEX_NONE;
+        if(!s.empty())
+            SetS(idx, s);
+    }
+};
+
+template<class IO, class Loc>
+static void s_locFields(IO &io, Loc &loc)
+{
+    io.num(loc.X);
+    io.num(loc.Y);
+    io.num(loc.Width);
+    io.num(loc.Height);
+}
+
+// the fields of the objects that are set by the level loader and by the editor (runtime state is not kept),
+// bump c_journalVersion when changing them
+template<class IO>
+static void s_slotFields(IO &io, int kind, int i)
+{
+    switch(kind)
+    {
+    case JK_BLOCK:
+    {
+        Block_t &b = Block[i];
+        s_locFields(io, b.Location);
+        io.val(b.Type);
+        io.val(b.DefaultType);
+        io.val(b.Special);
+        io.val(b.DefaultSpecial);
+        io.val(b.forceSmashable);
+        io.val(b.Invis);
+        io.val(b.Slippy);
+        io.val(b.Hidden);
+        io.val(b.Layer);
+        io.val(b.TriggerHit);
+        io.val(b.TriggerDeath);
+        io.val(b.TriggerLast);
+        break;
+    }
+
+    case JK_BGO:
+    {
+        Background_t &b = Background[i];
+        s_locFields(io, b.Location);
+        io.val(b.Type);
+        io.val(b.SortPriority);
+        io.val(b.Hidden);
+        io.val(b.Layer);
+        break;
+    }
+
+    case JK_NPC:
+    {
+        NPC_t &n = NPC[i];
+        s_locFields(io, n.Location);
+        io.val(n.Type);
+        io.val(n.DefaultType);
+        io.val(n.Direction);
+        io.val(n.DefaultDirection);
+        io.num(n.DefaultLocationX);
+        io.num(n.DefaultLocationY);
+        io.val(n.Special);
+        io.val(n.DefaultSpecial);
+        io.val(n.Special3);
+        io.val(n.Special4);
+        io.val(n.Variant);
+        io.val(n.Inert);
+        io.val(n.Hidden);
+        io.val(n.Wings);
+        io.val(n.DefaultWings);
+
+        // bitfields
+        bool generator = n.Generator, stuck = n.Stuck, default_stuck = n.DefaultStuck, legacy = n.Legacy;
+        io.val(generator);
+        io.val(stuck);
+        io.val(default_stuck);
+        io.val(legacy);
+        n.Generator = generator;
+        n.Stuck = stuck;
+        n.DefaultStuck = default_stuck;
+        n.Legacy = legacy;
+
+        io.val(n.Layer);
+        io.val(n.AttLayer);
+        io.val(n.TriggerActivate);
+        io.val(n.TriggerDeath);
+        io.val(n.TriggerTalk);
+        io.val(n.TriggerLast);
+        io.str(n.Text);
+        break;
+    }
+
+    case JK_WARP:
+    {
+        Warp_t &w = Warp[i];
+        s_locFields(io, w.Entrance);
+        s_locFields(io, w.Exit);
+        io.val(w.Locked);
+        io.val(w.WarpNPC);
+        io.val(w.NoYoshi);
+        io.val(w.Layer);
+        io.val(w.Hidden);
+        io.val(w.PlacedEnt);
+        io.val(w.PlacedExit);
+        io.val(w.Stars);
+        io.val(w.Effect);
+        io.str(w.level);
+        io.val(w.LevelWarp);
+        io.val(w.LevelEnt);
+        io.val(w.Direction);
+        io.val(w.Direction2);
+        io.val(w.MapWarp);
+        io.val(w.MapX);
+        io.val(w.MapY);
+        io.val(w.curStars);
+        io.val(w.save_info_idx);
+        io.val(w.twoWay);
+        io.val(w.noPrintStars);
+        io.val(w.noEntranceScene);
+        io.val(w.cannonExit);
+        io.val(w.cannonExitSpeed);
+        io.val(w.stoodRequired);
+        io.val(w.eventEnter);
+        io.val(w.eventExit);
+        io.str(w.StarsMsg);
+        io.val(w.transitEffect);
+        break;
+    }
+
+    case JK_WATER:
+    {
+        Water_t &w = Water[i];
+        s_locFields(io, w.Location);
+        io.val(w.Type);
+        io.val(w.Layer);
+        io.val(w.Hidden);
+        break;
+    }
+
+    default:
+    {
+        PlayerStart_t &p = PlayerStart[i];
+        io.val(p.X);
+        io.val(p.Y);
+        io.val(p.Width);
+        io.val(p.Height);
+        io.val(p.Direction);
+        break;
+    }
+    }
+}
+
+// resets the slot to the defaults, without freeing its strings
+static void s_clearSlot(int kind, int i)
+{
+    switch(kind)
+    {
+    case JK_BLOCK:
+        Block[i] = Block_t();
+        break;
+    case JK_BGO:
+        Background[i] = Background_t();
+        break;
+    case JK_NPC:
+        NPC[i] = NPC_t();
+        break;
+    case JK_WARP:
+        Warp[i] = Warp_t();
+        break;
+    case JK_WATER:
+        Water[i] = Water_t();
+        break;
+    default:
+        PlayerStart[i] = PlayerStart_t();
+        break;
+    }
+}
+
+// resets the slot and fills it from the record, the same way as the level loader does
+static bool s_loadSlot(int kind, int i, const std::string &rec, bool in_use)
+{
+    // slots past the count may keep stale string indexes
+    if(in_use)
+        s_freeStrings(kind, i);
+
+    s_clearSlot(kind, i);
+
+    JournalReader r;
+    r.cur = reinterpret_cast<const uint8_t*>(rec.data());
+    r.end = r.cur + rec.size();
+
+    SlotReader io{r};
+    s_slotFields(io, kind, i);
+
+    if(kind == JK_NPC)
+    {
+        // allow every NPC to be active for one frame to initialize its internal state
+        NPC[i].TimeLeft = 1;
+        NPC[i].Active = true;
+        NPC[i].JustActivated = 1;
+    }
+
+    return r.ok && r.cur == r.end;
+}
+
+static void s_syncSlot(int kind, int i)
+{
+    switch(kind)
+    {
+    case JK_BLOCK:
+        syncLayersTrees_Block(i);
+        break;
+    case JK_BGO:
+        syncLayers_BGO(i);
+        break;
+    case JK_NPC:
+        syncLayers_NPC(i);
+        break;
+    case JK_WARP:
+        syncLayers_Warp(i);
+        break;
+    case JK_WATER:
+        syncLayers_Water(i);
+        break;
+    default:
+        break;
+    }
+}
+
+// appends the changed counts and the reported slots that differ from the shadow, and updates the shadow
+static void s_diff(std::vector<uint8_t> &out)
+{
+    std::vector<uint8_t> rec;
+    SlotWriter io{rec};
+
+    for(int k = 0; k < JK_COUNT; k++)
+    {
+        KindState_t &sh = s_shadow[k];
+        int n = s_count(k);
+        int old_count = sh.count;
+
+        if(n != old_count)
+        {
+            out.push_back(JR_COUNT);
+            out.push_back((uint8_t)k);
+            s_put32(out, (uint32_t)n);
+            sh.resize(n);
+
+            // new slots are always written, even if they haven't been reported
+            for(int i = old_count + 1; i <= n; i++)
+                sh.mark(i, c_kindMax[k]);
+        }
+
+        for(int i : sh.dirty)
+        {
+            sh.is_dirty[(size_t)i] = false;
+
+            if(i > n)
+                continue;
+
+            rec.clear();
+            s_slotFields(io, k, i);
+
+            std::string &img = sh.recs[(size_t)(i - 1)];
+
+            if(i <= old_count && img.size() == rec.size() && memcmp(img.data(), rec.data(), rec.size()) == 0)
+                continue;
+
+            img.assign(rec.begin(), rec.end());
+
+            out.push_back(JR_SLOT);
+            out.push_back((uint8_t)k);
+            s_put32(out, (uint32_t)i);
+            s_put32(out, (uint32_t)rec.size());
+            out.insert(out.end(), rec.begin(), rec.end());
+        }
+
+        sh.dirty.clear();
+    }
+}
+
+static bool s_hasPending()
+{
+    for(int k = 0; k < JK_COUNT; k++)
+    {
+        if(!s_shadow[k].dirty.empty() || s_shadow[k].count != s_count(k))
+            return true;
+    }
+
+    return false;
+}
+
+static bool s_writeFile(const std::vector<uint8_t> &out, const char *mode)
+{
+    std::string path = s_journalPath(s_levelPath);
+
+    SDL_RWops *f = Files::open_file(path, mode);
+    if(!f)
+    {
+        pLogWarning("EditJournal: failed to write [%s]", path.c_str());
+        return false;
+    }
+
+    size_t written = SDL_RWwrite(f, out.data(), 1, out.size());
+    SDL_RWclose(f);
+
+    return written == out.size();
+}
+
+// rewrites the journal as a new base image of the current level
+static void s_compact()
+{
+    std::string snapshot;
+
+    // don't reorder the objects while the editor is running
+    if(!SaveLevelSnapshot(snapshot, FileFormat, false))
+    {
+        pLogWarning("EditJournal: failed to make the base snapshot of [%s], journal disabled", s_levelPath.c_str());
+        s_active = false;
+        return;
+    }
+
+    int64_t mtime = 0, size = 0;
+    Files::fileStamp(s_levelPath, mtime, size);
+
+    std::vector<uint8_t> out;
+    out.reserve(snapshot.size() * 2 + 4096);
+
+    out.insert(out.end(), c_journalMagic, c_journalMagic + sizeof(c_journalMagic));
+    s_put32(out, c_journalVersion);
+    s_put32(out, s_layoutSignature());
+    s_putStr(out, s_levelPath);
+    s_put64(out, mtime);
+    s_put64(out, size);
+
+    out.push_back(JR_BASE);
+
+    s_put32(out, (uint32_t)numLayers);
+    for(int i = 0; i < numLayers; i++)
+        s_putStr(out, Layer[i].Name);
+
+    s_put32(out, (uint32_t)numEvents);
+    for(int i = 0; i < numEvents; i++)
+        s_putStr(out, Events[i].Name);
+
+    s_putStr(out, snapshot);
+
+    // full image of the object arrays
+    for(int k = 0; k < JK_COUNT; k++)
+        s_shadow[k].resize(0);
+
+    s_diff(out);
+    out.push_back(JR_COMMIT);
+
+    if(!s_writeFile(out, "wb"))
+    {
+        s_active = false;
+        return;
+    }
+
+    s_namesHash = s_calcNamesHash();
+    s_baseBytes = out.size();
+    s_journalBytes = out.size();
+    s_needCompact = false;
+    s_settleFrames = 0;
+}
+
+static void s_append()
+{
+    std::vector<uint8_t> out;
+    s_diff(out);
+
+    if(out.empty())
+        return;
+
+    out.push_back(JR_COMMIT);
+
+    if(!s_writeFile(out, "ab"))
+    {
+        s_active = false;
+        return;
+    }
+
+    s_journalBytes += out.size();
+}
+
+static void s_flush(bool force)
+{
+    if(!s_active)
+        return;
+
+    if(s_needCompact && (force || s_settleFrames >= c_settleFrames))
+    {
+        s_compact();
+        return;
+    }
+
+    if(!s_hasPending())
+        return;
+
+    // the records refer to the layers and events by their indexes at the base
+    if(s_calcNamesHash() != s_namesHash)
+        s_compact();
+    else if(s_journalBytes > c_compactMinBytes && s_journalBytes - s_baseBytes > s_baseBytes)
+        s_compact();
+    else
+        s_append();
+}
+
+struct JournalOp_t
+{
+    uint8_t type = 0;
+    uint8_t kind = 0;
+    uint32_t value = 0;
+    std::string rec;
+};
+
+struct JournalData_t
+{
+    std::vector<std::string> layer_names;
+    std::vector<std::string> event_names;
+    std::string snapshot;
+    // committed records in their order, the ones of the base image go first
+    std::vector<JournalOp_t> ops;
+    size_t base_ops = 0;
+    size_t commits = 0;
+    // records of an incomplete append at the end
+    size_t skipped = 0;
+};
+
+// reads and validates a journal file, check_level also requires it to belong to the unchanged level file at s_levelPath
+static bool s_readJournal(const std::string &path, JournalData_t &j, bool check_level)
+{
+    if(!Files::fileExists(path))
+        return false;
+
+    Files::Data data = Files::load_file(path);
+    if(!data.valid() || data.size() < sizeof(c_journalMagic))
+        return false;
+
+    JournalReader r;
+    r.cur = data.begin();
+    r.end = data.end();
+
+    if(memcmp(r.cur, c_journalMagic, sizeof(c_journalMagic)) != 0)
+        return false;
+
+    r.cur += sizeof(c_journalMagic);
+
+    std::string level_path;
+    uint32_t version = r.get32();
+    uint32_t layout = r.get32();
+    r.getStr(level_path);
+    int64_t mtime = r.get64();
+    int64_t size = r.get64();
+
+    if(!r.ok || version != c_journalVersion || layout != s_layoutSignature() || (check_level && level_path != s_levelPath))
+    {
+        pLogWarning("EditJournal: journal [%s] is incompatible, dropped", path.c_str());
+        return false;
+    }
+
+    if(check_level)
+    {
+        int64_t cur_mtime = 0, cur_size = 0;
+        Files::fileStamp(s_levelPath, cur_mtime, cur_size);
+
+        if(mtime != cur_mtime || size != cur_size)
+        {
+            pLogWarning("EditJournal: [%s] has been changed since the leftover journal was written, journal dropped", s_levelPath.c_str());
+            return false;
+        }
+    }
+
+    if(r.get8() != JR_BASE)
+        return false;
+
+    j.layer_names.resize(SDL_min(r.get32(), (uint32_t)maxLayers + 1));
+    for(std::string &s : j.layer_names)
+        r.getStr(s);
+
+    j.event_names.resize(SDL_min(r.get32(), (uint32_t)maxEvents + 1));
+    for(std::string &s : j.event_names)
+        r.getStr(s);
+
+    r.getStr(j.snapshot);
+
+    int count[JK_COUNT] = {0};
+    std::vector<JournalOp_t> pending;
+
+    while(r.ok && r.cur < r.end)
+    {
+        JournalOp_t op;
+        op.type = r.get8();
+
+        if(op.type == JR_COMMIT)
+        {
+            for(JournalOp_t &o : pending)
+            {
+                if(o.type == JR_COUNT)
+                    count[o.kind] = (int)o.value;
+
+                j.ops.push_back(std::move(o));
+            }
+
+            pending.clear();
+
+            if(j.commits == 0)
+                j.base_ops = j.ops.size();
+
+            j.commits++;
+            continue;
+        }
+
+        op.kind = r.get8();
+        op.value = r.get32();
+
+        if(!r.ok || op.kind >= JK_COUNT || (op.type != JR_COUNT && op.type != JR_SLOT))
+            break;
+
+        if(op.type == JR_COUNT)
+        {
+            if(op.value > (uint32_t)c_kindMax[op.kind])
+                break;
+        }
+        else
+        {
+            // the slot must be inside of the count known at this point
+            int n = count[op.kind];
+            for(const JournalOp_t &o : pending)
+            {
+                if(o.type == JR_COUNT && o.kind == op.kind)
+                    n = (int)o.value;
+            }
+
+            if(op.value < 1 || op.value > (uint32_t)n)
+                break;
+
+            r.getStr(op.rec);
+        }
+
+        if(r.ok)
+            pending.push_back(std::move(op));
+    }
+
+    // the base image itself is incomplete
+    if(j.commits == 0)
+    {
+        pLogWarning("EditJournal: journal [%s] is truncated, dropped", path.c_str());
+        return false;
+    }
+
+    j.skipped = pending.size();
+
+    return true;
+}
+
+// restores the sections, layers, and events from the base snapshot (written in the format of the level file)
+static bool s_loadBase(JournalData_t &j, const std::string &level_path, layerindex_t *layer_map, eventindex_t *event_map)
+{
+    PGE_FileFormats_misc::RawTextInput in;
+    in.open(&j.snapshot, level_path);
+
+    if(!OpenLevelData(in, level_path))
+    {
+        pLogWarning("EditJournal: failed to load the base snapshot of [%s]", level_path.c_str());
+        return false;
+    }
+
+    OpenLevelDataPost();
+
+    // the loader may put layers and events into a different order
+    for(int i = 0; i < 256; i++)
+    {
+        layer_map[i] = LAYER_NONE;
+        event_map[i] = EVENT_NONE;
+    }
+
+    for(size_t i = 0; i < j.layer_names.size() && i < 255; i++)
+        layer_map[i] = FindLayer(j.layer_names[i]);
+
+    for(size_t i = 0; i < j.event_names.size() && i < 255; i++)
+        event_map[i] = FindEvent(j.event_names[i]);
+
+    return true;
+}
+
+// applies a single record to the level, sync keeps the layer trees up to date after each record
+static bool s_applyOp(const JournalOp_t &op, const layerindex_t *layer_map, const eventindex_t *event_map, bool sync)
+{
+    int k = op.kind;
+
+    if(op.type == JR_COUNT)
+    {
+        int n = (int)op.value;
+        int old_count = s_count(k);
+
+        for(int i = n + 1; i <= old_count; i++)
+            s_freeStrings(k, i);
+
+        // slots past the count may keep stale string indexes
+        for(int i = old_count + 1; i <= n; i++)
+            s_clearSlot(k, i);
+
+        if(k != JK_START)
+            s_count(k) = n;
+
+        for(int i = n + 1; sync && i <= old_count; i++)
+            s_syncSlot(k, i);
+
+        return true;
+    }
+
+    int i = (int)op.value;
+
+    bool ok = s_loadSlot(k, i, op.rec, true);
+    s_remapSlot(k, i, layer_map, event_map);
+
+    if(sync)
+        s_syncSlot(k, i);
+
+    return ok;
+}
+
+static void s_syncAll(const int *max_count)
+{
+    syncLayersTrees_AllBlocks();
+    syncLayers_AllBGOs();
+    syncLayers_AllNPCs();
+
+    for(int i = numNPCs + 1; i <= max_count[JK_NPC]; i++)
+        syncLayers_NPC(i);
+
+    for(int i = 1; i <= SDL_max(numWarps, max_count[JK_WARP]); i++)
+        syncLayers_Warp(i);
+
+    for(int i = 1; i <= SDL_max(numWater, max_count[JK_WATER]); i++)
+        syncLayers_Water(i);
+}
+
+// replays the leftover journal of the level at s_levelPath
+static bool s_recover()
+{
+    ElapsedTimer timer;
+    timer.start();
+
+    JournalData_t j;
+    layerindex_t layer_map[256];
+    eventindex_t event_map[256];
+
+    if(!s_readJournal(s_journalPath(s_levelPath), j, true) || !s_loadBase(j, s_levelPath, layer_map, event_map))
+        return false;
+
+    if(j.skipped)
+        pLogWarning("EditJournal: %u records of an incomplete append are skipped", (unsigned)j.skipped);
+
+    int max_count[JK_COUNT];
+    int bad_slots = 0;
+
+    for(int k = 0; k < JK_COUNT; k++)
+        max_count[k] = s_count(k);
+
+    for(const JournalOp_t &op : j.ops)
+    {
+        if(!s_applyOp(op, layer_map, event_map, false))
+            bad_slots++;
+
+        max_count[op.kind] = SDL_max(max_count[op.kind], s_count(op.kind));
+    }
+
+    if(bad_slots)
+        pLogWarning("EditJournal: %d object records of the leftover journal are malformed", bad_slots);
+
+    s_syncAll(max_count);
+
+    pLogInfo("EditJournal: recovered unsaved changes of [%s] (%u edit records in %u appends) in %d ms",
+             s_levelPath.c_str(), (unsigned)(j.ops.size() - j.base_ops), (unsigned)(j.commits - 1), timer.elapsed());
+
+    return true;
+}
+
+static void s_clearShadow()
+{
+    for(int k = 0; k < JK_COUNT; k++)
+    {
+        KindState_t empty;
+        std::swap(s_shadow[k], empty);
+    }
+}
+
+static void s_begin(const std::string &path)
+{
+    // the previous level has been left, its changes are discarded
+    if(s_active)
+        Files::deleteFile(s_journalPath(s_levelPath));
+
+    s_levelPath = path;
+    s_active = false;
+    s_recoveryPending = false;
+    s_clearShadow();
+
+    if(s_levelPath.empty())
+        return;
+
+    // keep the leftover journal untouched until the user decides what to do with it
+    JournalData_t j;
+    if(s_readJournal(s_journalPath(s_levelPath), j, true))
+    {
+        pLogInfo("EditJournal: found unsaved changes of [%s] (%u edit records)",
+                 s_levelPath.c_str(), (unsigned)(j.ops.size() - j.base_ops));
+        s_recoveryPending = true;
+        return;
+    }
+
+    s_active = true;
+    s_compact();
+}
+
+void EditJournal::update()
+{
+    if(FullFileName != s_levelPath)
+        s_begin(FullFileName);
+
+    if(!s_active)
+        return;
+
+    if(s_needCompact)
+        s_settleFrames++;
+
+    s_flush(false);
+}
+
+void EditJournal::flush()
+{
+    // another level has been opened, it gets its journal at the next editor frame
+    if(FullFileName != s_levelPath)
+        return;
+
+    s_flush(true);
+}
+
+void EditJournal::objectChanged(ObjectKind kind, int index)
+{
+    // the edits of the Magic Hand are discarded with the tested level
+    if(!s_active || !LevelEditor || MagicHand)
+        return;
+
+    s_shadow[kind].mark(index, c_kindMax[kind]);
+}
+
+void EditJournal::objectsReordered(ObjectKind kind)
+{
+    if(!s_active || !LevelEditor || MagicHand)
+        return;
+
+    // only the slots that have actually moved get appended
+    for(int i = 1; i <= s_count(kind); i++)
+        s_shadow[kind].mark(i, c_kindMax[kind]);
+}
+
+void EditJournal::levelChanged()
+{
+    if(!s_active || FullFileName != s_levelPath)
+        return;
+
+    // compacted once the edits settle down (dragging the section border changes the level each frame)
+    s_needCompact = true;
+    s_settleFrames = 0;
+}
+
+void EditJournal::levelSaved(const std::string &path)
+{
+    if(!s_active || path != s_levelPath)
+        return;
+
+    // the level file has got a new stamp, rebase at the next editor frame
+    s_needCompact = true;
+    s_settleFrames = c_settleFrames;
+}
+
+bool EditJournal::recoveryPending()
+{
+    return s_recoveryPending;
+}
+
+void EditJournal::resolveRecovery(bool restore)
+{
+    if(!s_recoveryPending)
+        return;
+
+    s_recoveryPending = false;
+
+    if(restore && !s_recover())
+        pLogWarning("EditJournal: failed to restore the unsaved changes of [%s]", s_levelPath.c_str());
+    else if(!restore)
+        pLogInfo("EditJournal: unsaved changes of [%s] have been discarded", s_levelPath.c_str());
+
+    s_active = true;
+    s_compact();
+}
+
+void EditJournal::benchmark(const std::string &path)
+{
+    ElapsedTimer timer;
+    timer.start();
+
+    JournalData_t j;
+    if(!s_readJournal(path, j, false))
+    {
+        pLogWarning("EditJournal: [%s] is not a valid edit journal of this build", path.c_str());
+        return;
+    }
+
+    int64_t read_ns = timer.nanoelapsed();
+
+    layerindex_t layer_map[256];
+    eventindex_t event_map[256];
+    int max_count[JK_COUNT];
+
+    // the base image, loaded at once
+    timer.restart();
+
+    if(!s_loadBase(j, FullFileName, layer_map, event_map))
+        return;
+
+    for(int k = 0; k < JK_COUNT; k++)
+        max_count[k] = s_count(k);
+
+    for(size_t o = 0; o < j.base_ops; o++)
+    {
+        s_applyOp(j.ops[o], layer_map, event_map, false);
+        max_count[j.ops[o].kind] = SDL_max(max_count[j.ops[o].kind], s_count(j.ops[o].kind));
+    }
+
+    s_syncAll(max_count);
+
+    int64_t base_ns = timer.nanoelapsed();
+
+    // the edits, one record at a time with the layer trees kept in sync, the same way the editor makes them
+    size_t edits = j.ops.size() - j.base_ops;
+
+    timer.restart();
+
+    for(size_t o = j.base_ops; o < j.ops.size(); o++)
+        s_applyOp(j.ops[o], layer_map, event_map, true);
+
+    int64_t replay_ns = timer.nanoelapsed();
+
+    // the cost of journaling the same edits
+    std::vector<uint8_t> rec;
+    SlotWriter io{rec};
+
+    timer.restart();
+
+    for(size_t o = j.base_ops; o < j.ops.size(); o++)
+    {
+        const JournalOp_t &op = j.ops[o];
+
+        if(op.type == JR_SLOT && (int)op.value <= s_count(op.kind))
+        {
+            rec.clear();
+            s_slotFields(io, op.kind, (int)op.value);
+        }
+    }
+
+    int64_t record_ns = timer.nanoelapsed();
+
+    // the cost of the full level serialization which the journal replaces
+    std::string snapshot;
+
+    timer.restart();
+    SaveLevelSnapshot(snapshot, FileFormat, false);
+    int64_t snapshot_ns = timer.nanoelapsed();
+
+    // hash of the replayed objects, the same for every run of the same journal
+    uint32_t h = 2166136261u;
+
+    for(int k = 0; k < JK_COUNT; k++)
+    {
+        for(int i = 1; i <= s_count(k); i++)
+        {
+            rec.clear();
+            s_slotFields(io, k, i);
+            h = s_hashBytes(h, rec.data(), rec.size());
+        }
+    }
+
+    pLogInfo("EditJournal: benchmark of [%s] on [%s]: %u edit records in %u appends, state hash %08x",
+             path.c_str(), FullFileName.c_str(), (unsigned)edits, (unsigned)(j.commits - 1), h);
+    pLogInfo("EditJournal:   read %lld us, base image %lld us, full snapshot %lld us (%u bytes)",
+             (long long)(read_ns / 1000), (long long)(base_ns / 1000), (long long)(snapshot_ns / 1000), (unsigned)snapshot.size());
+    pLogInfo("EditJournal:   replay %lld us (%lld ns per edit), recording %lld us (%lld ns per edit)",
+             (long long)(replay_ns / 1000), (long long)(edits ? replay_ns / (int64_t)edits : 0),
+             (long long)(record_ns / 1000), (long long)(edits ? record_ns / (int64_t)edits : 0));
+}
+
+void EditJournal::close()
+{
+    if(s_active)
+        Files::deleteFile(s_journalPath(s_levelPath));
+
+    s_active = false;
+    s_recoveryPending = false;
+    s_levelPath.clear();
+
+    s_clearShadow();
+}
+
+#else // #ifndef LOW_MEM
+
+void EditJournal::update() {}
+void EditJournal::flush() {}
+void EditJournal::objectChanged(ObjectKind, int) {}
+void EditJournal::objectsReordered(ObjectKind) {}
+void EditJournal::levelChanged() {}
+void EditJournal::levelSaved(const std::string &) {}
+bool EditJournal::recoveryPending() { return false; }
+void EditJournal::resolveRecovery(bool) {}
+void EditJournal::benchmark(const std::string &) {}
+void EditJournal::close() {}
+
+#endif // #ifndef LOW_MEM
@@ -0,0 +1,115 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef EDIT_JOURNAL_H
+#define EDIT_JOURNAL_H
+
+#include <string>
+
+/**
+ * \brief Append-only journal of the unsaved changes made at the level editor
+ *
+ * The journal starts with a base image of the level (a snapshot in the format of the level file plus
+ * the fields of the objects). The editor reports every object slot it places, removes, or modifies,
+ * and each frame with edits appends only the records of those slots. The journal gets compacted into
+ * a new base image when the sections, layers, or events get edited, when the level gets saved, or when
+ * the appended part grows bigger than the base.
+ *
+ * If the editor crashes, the user is asked whether to restore the journal when the same (unchanged)
+ * level file is opened at the editor next time. The journal is removed once the editor gets left normally.
+ */
+namespace EditJournal
+{
+
+enum ObjectKind
+{
+    OBJ_BLOCK = 0,
+    OBJ_BGO,
+    OBJ_NPC,
+    OBJ_WARP,
+    OBJ_WATER,
+    OBJ_START,
+};
+
+/**
+ * \brief Track the level currently opened at the level editor, called once per editor frame
+ *
+ * Starts a new journal (or finds the leftover one) when the opened level changes,
+ * and appends the edits made during the frame.
+ */
+void update();
+
+/**
+ * \brief Append all pending changes immediately (before a level test, for example)
+ */
+void flush();
+
+/**
+ * \brief Notify that an object slot has been placed, modified, or has received the last object on a removal
+ * \param kind Kind of the object
+ * \param index Index of the slot
+ */
+void objectChanged(ObjectKind kind, int index);
+
+/**
+ * \brief Notify that the objects of the kind have been reordered (by a sort)
+ * \param kind Kind of the objects
+ */
+void objectsReordered(ObjectKind kind);
+
+/**
+ * \brief Notify that the sections, layers, or events have been edited, or the level has been reloaded
+ */
+void levelChanged();
+
+/**
+ * \brief Notify that the level has been written to the disk
+ * \param path Path the level has been saved to
+ */
+void levelSaved(const std::string &path);
+
+/**
+ * \brief Whether the opened level has a leftover journal waiting for the user's decision
+ */
+bool recoveryPending();
+
+/**
+ * \brief Resolve the leftover journal of the opened level
+ * \param restore Replay the journal if true, discard it otherwise
+ */
+void resolveRecovery(bool restore);
+
+/**
+ * \brief Deterministic edit-replay benchmark: replays the journal file record by record and logs the timings
+ * \param path Path to the journal file
+ *
+ * Called when the level editor is started from the command line with --edit-journal-bench.
+ */
+void benchmark(const std::string &path);
+
+/**
+ * \brief Remove the journal on a normal exit from the editor
+ */
+void close();
+
+} // namespace EditJournal
+
+#endif // EDIT_JOURNAL_H
@@ -70,6 +70,7 @@
 
 #include "editor/magic_block.h"
 #include "editor/editor_custom.h"
+#include "editor/edit_journal.h"
 
 #include <PGE_File_Formats/file_formats.h>
 
@@ -77,6 +78,7 @@
 //Public Declare Function GetCursorPos Lib "user32" (lpPoint As POINTAPI) As long long;
 
 std::string Backup_FullFileName;
+std::string Backup_LevelData;
 
 bool MouseCancel = false;
 bool HasCursor = false;
@@ -242,6 +244,40 @@ void EditorRestore()
     vScreen[1].Y = last_vScreenY_b[curSection];
 }
 
+void EditorSaveTestLevel()
+{
+    // keep the unsaved changes at the disk in case the test crashes
+    EditJournal::flush();
+
+    Backup_FullFileName = FullFileName;
+    // the temporary file is only written if the snapshot has failed
+    FullFileName = FullFileName + "tst";
+
+    if(!SaveLevelSnapshot(Backup_LevelData, FileFormat))
+        SaveLevel(FullFileName, FileFormat);
+}
+
+bool EditorOpenTestLevel()
+{
+    // the tested level may have warped into another level
+    if(Backup_LevelData.empty() || FullFileName != Backup_FullFileName + "tst")
+        return OpenLevel(FullFileName);
+
+    // the snapshot has the format of the level file, so it gets loaded with the same semantics
+    PGE_FileFormats_misc::RawTextInput in;
+    in.open(&Backup_LevelData, FullFileName);
+
+    bool ret = OpenLevelData(in, FullFileName);
+    if(ret)
+    {
+        OpenLevelDataPost();
+        // the objects have been sorted by the snapshot, rebase the journal
+        EditJournal::levelChanged();
+    }
+
+    return ret;
+}
+
 void EditorCursor_t::ClearStrings()
 {
     FreeS(this->NPC.Text);
@@ -410,6 +446,7 @@ void UpdateEditor()
 
                     EditorCursor.Location = PlayerStart[A];
                     PlayerStart[A] = PlayerStart_t();
+                    EditJournal::objectChanged(EditJournal::OBJ_START, A);
                     MouseMove(EditorCursor.X, EditorCursor.Y);
                     MouseRelease = false;
                     MouseCancel = true; /* Simulate "Focus out" inside of SMBX Editor */
@@ -420,6 +457,7 @@ void UpdateEditor()
                     InteractResizeSection(LevelREAL[curSection]);
                     level[curSection] = static_cast<SpeedlessLocation_t>(LevelREAL[curSection]);
                     UpdateSectionOverlaps(curSection);
+                    EditJournal::levelChanged();
                 }
 
                 // event section resize
@@ -427,6 +465,7 @@ void UpdateEditor()
                 {
                     int A = EditorCursor.InteractIndex;
                     InteractResizeSection(Events[A].section[curSection].position);
+                    EditJournal::levelChanged();
                     MouseRelease = false;
                 }
 
@@ -446,6 +485,7 @@ void UpdateEditor()
                     ResetNPC(EditorCursor.NPC.Type);
 
                     NPC[A].DefaultType = NPCID_NULL;
+                    EditJournal::objectChanged(EditJournal::OBJ_NPC, A);
                     KillNPC(A, 9);
 
                     editorScreen.FocusNPC();
@@ -506,6 +546,7 @@ void UpdateEditor()
                     InteractResize(iLoc, 64, 32);
 
                     syncLayersTrees_Block(EditorCursor.InteractIndex);
+                    EditJournal::objectChanged(EditJournal::OBJ_BLOCK, EditorCursor.InteractIndex);
                 }
                 else if(EditorCursor.InteractMode == OptCursor_t::LVL_BLOCKS) // Blocks
                 {
@@ -523,6 +564,7 @@ void UpdateEditor()
 
                     Location_t loc = Block[A].Location;
                     int type = Block[A].Type;
+                    EditJournal::objectChanged(EditJournal::OBJ_BLOCK, A);
                     KillBlock(A, false);
 
                     MagicBlock::MagicBlock(type, loc);
@@ -584,6 +626,7 @@ void UpdateEditor()
 
                     EditorCursor.Warp = Warp[A];
                     EditorCursor.Layer = EditorCursor.Warp.Layer;
+                    EditJournal::objectChanged(EditJournal::OBJ_WARP, A);
 
                     if(!Warp[A].PlacedEnt && !Warp[A].PlacedExit)
                         KillWarp(A);
@@ -607,6 +650,7 @@ void UpdateEditor()
 
                     Background[A] = Background[numBackground];
                     numBackground--;
+                    EditJournal::objectChanged(EditJournal::OBJ_BGO, A);
 
                     editorScreen.FocusBGO();
                     if(MagicHand)
@@ -647,6 +691,7 @@ void UpdateEditor()
                     InteractResize(iLoc, 32, 32);
 
                     syncLayers_Water(EditorCursor.InteractIndex);
+                    EditJournal::objectChanged(EditJournal::OBJ_WATER, EditorCursor.InteractIndex);
                 }
                 else if(EditorCursor.InteractMode == OptCursor_t::LVL_WATER) // water
                 {
@@ -659,6 +704,7 @@ void UpdateEditor()
                     EditorCursor.Water = Water[A];
                     Water[A] = Water[numWater];
                     numWater--;
+                    EditJournal::objectChanged(EditJournal::OBJ_WATER, A);
                     syncLayers_Water(A);
                     syncLayers_Water(numWater+1);
                     MouseRelease = false;
@@ -806,6 +852,7 @@ void UpdateEditor()
                         NPC[A].Location.SpeedX = -Physics.NPCShellSpeed / 2;
 
                     NPC[A].DefaultType = NPCID_NULL;
+                    EditJournal::objectChanged(EditJournal::OBJ_NPC, A);
                     if(NPC[A]->IsABonus || NPC[A]->IsACoin)
                         KillNPC(A, 4); // Kill the bonus/coin
                     else
@@ -823,6 +870,7 @@ void UpdateEditor()
 
                     Location_t loc = Block[A].Location;
                     int type = Block[A].Type;
+                    EditJournal::objectChanged(EditJournal::OBJ_BLOCK, A);
                     KillBlock(A);
 
                     MagicBlock::MagicBlock(type, loc);
@@ -853,6 +901,7 @@ void UpdateEditor()
 
                     Background[A] = Background[numBackground];
                     numBackground--;
+                    EditJournal::objectChanged(EditJournal::OBJ_BGO, A);
 
                     MouseRelease = false;
                     if(EditorCursor.SubMode == 0)
@@ -880,6 +929,7 @@ void UpdateEditor()
                     PlaySound(SFX_Smash);
                     Water[A] = Water[numWater];
                     numWater--;
+                    EditJournal::objectChanged(EditJournal::OBJ_WATER, A);
                     syncLayers_Water(A);
                     syncLayers_Water(numWater + 1);
                     MouseRelease = false;
@@ -1030,6 +1080,7 @@ void UpdateEditor()
                         numWater++;
                         Water[numWater] = EditorCursor.Water;
                         syncLayers_Water(numWater);
+                        EditJournal::objectChanged(EditJournal::OBJ_WATER, numWater);
                     }
                 }
             }
@@ -1054,6 +1105,7 @@ void UpdateEditor()
                             {
                                 Location_t loc = Block[A].Location;
                                 int type = Block[A].Type;
+                                EditJournal::objectChanged(EditJournal::OBJ_BLOCK, A);
                                 KillBlock(A, false);
                                 MagicBlock::MagicBlock(type, loc);
                             }
@@ -1134,6 +1186,7 @@ void UpdateEditor()
                             Block[numBlock].DefaultType = Block[numBlock].Type;
                             Block[numBlock].DefaultSpecial = Block[numBlock].Special;
                             syncLayersTrees_Block(numBlock);
+                            EditJournal::objectChanged(EditJournal::OBJ_BLOCK, numBlock);
 
                             MagicBlock::MagicBlock(numBlock);
 #if 0
@@ -1181,6 +1234,8 @@ void UpdateEditor()
                             PlayerStart[1] = EditorCursor.Location;
                         else
                             PlayerStart[2] = EditorCursor.Location;
+
+                        EditJournal::objectChanged(EditJournal::OBJ_START, B);
                     }
                 }
             }
@@ -1216,6 +1271,7 @@ void UpdateEditor()
                         numBackground++;
                         Background[numBackground] = EditorCursor.Background;
                         syncLayers_BGO(numBackground);
+                        EditJournal::objectChanged(EditJournal::OBJ_BGO, numBackground);
 
                         MagicBlock::MagicBackground(numBackground);
 
@@ -1297,6 +1353,7 @@ void UpdateEditor()
                             // ugh
                             NPCSort();
                             syncLayers_AllNPCs();
+                            EditJournal::objectsReordered(EditJournal::OBJ_NPC);
                         }
 
                         if(MagicHand)
@@ -1370,6 +1427,7 @@ void UpdateEditor()
                     EditorCursor.SubMode = 1;
 
                 syncLayers_Warp(A);
+                EditJournal::objectChanged(EditJournal::OBJ_WARP, A);
 //                if(nPlay.Online == true)
 //                    Netplay::sendData Netplay::AddWarp[A];
             }
@@ -1592,6 +1650,10 @@ void UpdateEditor()
         }
     }
 
+    // NEW: journal the unsaved changes of the level
+    if(LevelEditor && !WorldEditor && !MagicHand)
+        EditJournal::update();
+
 #ifdef THEXTECH_INTERPROC_SUPPORTED
     if(!MagicHand || !IntProc::isEnabled())
 #endif
@@ -2048,9 +2110,7 @@ void GetEditorControls()
     if(!WorldEditor && EditorControls.TestPlay && MouseRelease)
     {
         EditorBackup();
-        Backup_FullFileName = FullFileName;
-        FullFileName = FullFileName + "tst";
-        SaveLevel(FullFileName, FileFormat);
+        EditorSaveTestLevel();
 
         if(g_config.EnableInterLevelFade)
             g_levelScreenFader.setupFader(4, 0, 65, ScreenFader::S_FADE);
@@ -2415,6 +2475,7 @@ void HideCursor()
 void KillWarp(int A)
 {
     Warp_t blankWarp;
+    EditJournal::objectChanged(EditJournal::OBJ_WARP, A);
     Warp[A] = Warp[numWarps];
     Warp[numWarps] = blankWarp;
     numWarps--;
@@ -2630,7 +2691,7 @@ void zTestLevel(bool magicHand, bool interProcess)
     else
 #endif // THEXTECH_INTERPROC_SUPPORTED
     {
-        if(!OpenLevel(FullFileName))
+        if(!EditorOpenTestLevel())
         {
             ReportLoadFailure(FullFileName);
             ErrorQuit = true;
@@ -307,6 +307,10 @@ void initEditorStrings()
     g_editorStrings.fileConvertFeatureWorldMapSections = "The world includes world map sections.";
 #endif
 
+    g_editorStrings.journalRecoveryPrompt = "Unsaved changes of this level\nhave been found. Restore them?";
+    g_editorStrings.journalRecoveryRestore = "Restore the changes";
+    g_editorStrings.journalRecoveryDiscard = "Discard the changes";
+
     g_editorStrings.browserNewFile = "New file";
     g_editorStrings.browserSaveFile = "Save file";
     g_editorStrings.browserOpenFile = "Open file";
@@ -313,6 +313,10 @@ struct EditorContent
     std::string fileConvertFeatureWorldMapSections;
 #endif
 
+    std::string journalRecoveryPrompt;
+    std::string journalRecoveryRestore;
+    std::string journalRecoveryDiscard;
+
     std::string browserNewFile;
     std::string browserSaveFile;
     std::string browserOpenFile;
@@ -30,6 +30,7 @@
 
 #include "editor/magic_block.h"
 #include "editor/editor_custom.h"
+#include "editor/edit_journal.h"
 #include "editor.h"
 
 #include "rand.h"
@@ -630,6 +631,14 @@ void s_apply_type(BlockRef_t B, int type)
     }
 
     B->Type = type;
+    EditJournal::objectChanged(EditJournal::OBJ_BLOCK, (int)B);
+}
+
+template<>
+void s_apply_type(BackgroundRef_t B, int type)
+{
+    B->Type = type;
+    EditJournal::objectChanged(EditJournal::OBJ_BGO, (int)B);
 }
 
 template<class ItemRef_t>
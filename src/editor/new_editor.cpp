@@ -53,6 +53,7 @@
 #include "editor/new_editor.h"
 #include "editor/write_level.h"
 #include "editor/write_world.h"
+#include "editor/edit_journal.h"
 
 #include "editor/magic_block.h"
 #include "editor/editor_custom.h"
@@ -2156,10 +2157,8 @@ void EditorScreen::UpdateEditorSettingsScreen(CallMode mode)
     {
         // turn this into a routine...?! (cross-reference editor.cpp handler for EditorControls.TestPlay)
         EditorBackup();
-        Backup_FullFileName = FullFileName;
         // how does this interact with cross-level warps?
-        FullFileName = FullFileName + "tst";
-        SaveLevel(FullFileName, FileFormat);
+        EditorSaveTestLevel();
 
         if(g_config.EnableInterLevelFade)
             g_levelScreenFader.setupFader(4, 0, 65, ScreenFader::S_FADE);
@@ -4539,6 +4538,9 @@ void EditorScreen::UpdateFileScreen(CallMode mode)
             else if(m_special_subpage == 3) // revert level
             {
                 OpenLevel(FullFileName);
+                // the unsaved changes are gone, rebase the journal right away
+                EditJournal::levelChanged();
+                EditJournal::flush();
                 m_special_page = SPECIAL_PAGE_FILE;
                 m_special_subpage = 0;
             }
@@ -4794,6 +4796,9 @@ void EditorScreen::FileBrowserSuccess()
     {
         EnsureLevel();
         OpenLevel(FullFileName);
+        // the same level may have been reopened
+        EditJournal::levelChanged();
+        EditJournal::flush();
         ResetCursor();
         Integrator::setEditorFile(FileName);
     }
@@ -4920,6 +4925,27 @@ bool EditorScreen::FileExists(const std::string& cur_file)
     return (std::find(m_cur_path_files.begin(), m_cur_path_files.end(), cur_file) != m_cur_path_files.end());
 }
 
+void EditorScreen::UpdateJournalRecoveryScreen(CallMode mode)
+{
+    SuperPrintR(mode, g_editorStrings.journalRecoveryPrompt, 3, 10, 50);
+
+    SuperPrintR(mode, g_editorStrings.journalRecoveryRestore, 3, 60, 110);
+    if(UpdateButton(mode, 20 + 4, 100 + 4, GFX.EIcons, false, 0, 32*Icon::action, 32, 32))
+    {
+        EditJournal::resolveRecovery(true);
+        m_special_page = SPECIAL_PAGE_NONE;
+        return;
+    }
+
+    SuperPrintR(mode, g_editorStrings.journalRecoveryDiscard, 3, 60, 150);
+    if(UpdateButton(mode, 20 + 4, 140 + 4, GFX.EIcons, false, 0, 32*Icon::action, 32, 32))
+    {
+        EditJournal::resolveRecovery(false);
+        m_special_page = SPECIAL_PAGE_NONE;
+        return;
+    }
+}
+
 void EditorScreen::UpdateBrowserScreen(CallMode mode)
 {
     constexpr bool IGNORE_DIRS = true;
@@ -5490,6 +5516,17 @@ void EditorScreen::UpdateEditorScreen(CallMode mode, bool second_screen)
             return;
 
         MenuMouseRelease = MouseRelease && !MenuMouseRelease && !SharedCursor.Primary;
+
+        // a leftover journal of unsaved changes has been found, nothing else is done until the user decides on it
+        if(EditJournal::recoveryPending() && m_special_page != SPECIAL_PAGE_JOURNAL_RECOVERY)
+        {
+            m_special_page = SPECIAL_PAGE_JOURNAL_RECOVERY;
+
+            if(!active)
+                swap_screens();
+        }
+        else if(!EditJournal::recoveryPending() && m_special_page == SPECIAL_PAGE_JOURNAL_RECOVERY)
+            m_special_page = SPECIAL_PAGE_NONE;
     }
 
     e_tooltip = nullptr;
@@ -5538,6 +5575,27 @@ void EditorScreen::UpdateEditorScreen(CallMode mode, bool second_screen)
     if(mode == CallMode::Render)
         XRender::renderRect(0, 0, e_ScreenW, e_ScreenH, XTColorF(0.4_n, 0.4_n, 0.8_n, 0.75_n), true);
 
+    if(m_special_page == SPECIAL_PAGE_JOURNAL_RECOVERY)
+    {
+        UpdateJournalRecoveryScreen(mode);
+
+        if(mode == CallMode::Logic)
+            MenuMouseRelease = !SharedCursor.Primary;
+
+        return;
+    }
+
+    // the sections, layers, and events are journaled with the whole level, not per edit
+    if(mode == CallMode::Logic && MenuMouseRelease && LevelEditor && !WorldEditor
+        && (m_special_page == SPECIAL_PAGE_SECTION_SETTINGS || m_special_page == SPECIAL_PAGE_SECTION_MUSIC
+            || m_special_page == SPECIAL_PAGE_SECTION_BACKGROUND || m_special_page == SPECIAL_PAGE_LEVEL_EXIT
+            || (m_special_page >= SPECIAL_PAGE_EVENTS && m_special_page <= SPECIAL_PAGE_EVENT_SOUND)
+            || m_special_page == SPECIAL_PAGE_LAYERS || m_special_page == SPECIAL_PAGE_LAYER_DELETION
+            || (m_special_page == SPECIAL_PAGE_NONE && EditorCursor.Mode == OptCursor_t::LVL_PLAYERSTART)))
+    {
+        EditJournal::levelChanged();
+    }
+
     UpdateSelectorBar(mode, false);
 
     if(m_special_page == SPECIAL_PAGE_BROWSER || m_special_page == SPECIAL_PAGE_BROWSER_CONFIRM)
@@ -112,6 +112,7 @@ private:
         SPECIAL_PAGE_FILE,
         SPECIAL_PAGE_FILE_CONFIRM,
         SPECIAL_PAGE_FILE_CONVERT,
+        SPECIAL_PAGE_JOURNAL_RECOVERY,
     } SpecialPage_t;
     typedef enum
     {
@@ -244,6 +245,7 @@ private:
     void UpdateSelectListScreen(CallMode mode);
 
     void UpdateFileScreen(CallMode mode);
+    void UpdateJournalRecoveryScreen(CallMode mode);
     void UpdateBrowserScreen(CallMode mode);
 
     // void UpdateMagicBlockScreen(CallMode mode);
@@ -28,48 +28,28 @@
 #include "npc_id.h"
 #include "npc_traits.h"
 #include "npc_special_data.h"
+#include "editor/edit_journal.h"
 #include <PGE_File_Formats/file_formats.h>
 #include <AppPath/app_path.h>
 #include "Logger/logger.h"
 
-void SaveLevel(const std::string& FilePath, int format, int version)   // saves the level
+// puts the objects into the order expected by the legacy engine
+static void s_sortObjects()
 {
-    LevelData out;
-    LevelBlock block;
-    LevelBGO bgo;
-    LevelSection section;
-    LevelNPC npc;
-    LevelDoor warp;
-    LevelPhysEnv pez;
-    LevelLayer layer;
-    LevelSMBX64Event evt;
-    PlayerPoint player;
-
-    FileFormats::CreateLevelData(out);
-
-    int A = 0;
-    int B = 0;
     int C = 0;
 
     // put NPC types 60, 62, 64, 66, and 78-83 first. (why?)
-    for(A = 1; A <= numNPCs; A++)
+    for(int A = 1; A <= numNPCs; A++)
     {
         if(NPC[A].Type == NPCID_YEL_PLATFORM || NPC[A].Type == NPCID_BLU_PLATFORM || NPC[A].Type == NPCID_GRN_PLATFORM || NPC[A].Type == NPCID_RED_PLATFORM || (NPC[A].Type >= NPCID_TANK_TREADS && NPC[A].Type <= NPCID_SLANT_WOOD_M))
         {
-            // swap it with the first NPC that isn't one of the special ones
-            // this started as B = 1 but C + 1 will work now.
-            for(B = C + 1; B < A; B++)
-            {
-                if (!(NPC[B].Type == NPCID_YEL_PLATFORM || NPC[B].Type == NPCID_BLU_PLATFORM || NPC[B].Type == NPCID_GRN_PLATFORM || NPC[B].Type == NPCID_RED_PLATFORM || (NPC[B].Type >= NPCID_TANK_TREADS && NPC[B].Type <= NPCID_SLANT_WOOD_M)))
-                {
-                    std::swap(NPC[A], NPC[B]);
-                    break;
-                }
-            }
+            // we know that the first C slots are all these types, and the slots from C + 1 to A - 1 are all other types,
+            // so the first NPC that isn't one of the special ones is always at C + 1 (the old code searched for it)
+            if(C + 1 < A)
+                std::swap(NPC[A], NPC[C + 1]);
+
             C++;
-            // we know that the first C slots are all these types
         }
-        // C++ was here but that is a logical flaw.
     }
 
     qSortNPCsY(1, C);
@@ -81,6 +61,25 @@ void SaveLevel(const std::string& FilePath, int format, int version)   // saves
     syncLayersTrees_AllBlocks();
     syncLayers_AllBGOs();
     syncLayers_AllNPCs();
+}
+
+// fills the PGE-FL structure from the current level state
+static void s_exportLevel(LevelData& out, bool sort_objects)
+{
+    LevelBlock block;
+    LevelBGO bgo;
+    LevelSection section;
+    LevelNPC npc;
+    LevelDoor warp;
+    LevelPhysEnv pez;
+    LevelLayer layer;
+    LevelSMBX64Event evt;
+    PlayerPoint player;
+
+    FileFormats::CreateLevelData(out);
+
+    if(sort_objects)
+        s_sortObjects();
 
     // NPCyFix
     // Split filepath
@@ -99,6 +98,15 @@ void SaveLevel(const std::string& FilePath, int format, int version)   // saves
     out.meta.configPackId = "TheXTech";
     out.meta.engineFeatureLevel = g_gameInfo.contentFeatureLevel;
 
+    out.sections.reserve(numSections);
+    out.blocks.reserve(numBlock);
+    out.bgo.reserve(numBackground);
+    out.npc.reserve(numNPCs);
+    out.doors.reserve(numWarps);
+    out.physez.reserve(numWater);
+    out.layers.reserve(numLayers);
+    out.events.reserve(numEvents);
+
     // sections
     for(int i = 0; i < numSections; ++i)
     {
@@ -470,6 +478,12 @@ void SaveLevel(const std::string& FilePath, int format, int version)   // saves
         evt.meta.array_id = out.events_array_id++;
         out.events.push_back(evt);
     }
+}
+
+void SaveLevel(const std::string& FilePath, int format, int version)   // saves the level
+{
+    LevelData out;
+    s_exportLevel(out, true);
 
     if(!FileFormats::SaveLevelFile(out, FilePath, (FileFormats::LevelFileFormat)format, version))
     {
@@ -479,6 +493,7 @@ void SaveLevel(const std::string& FilePath, int format, int version)   // saves
     }
 
     AppPathManager::syncFs();
+    EditJournal::levelSaved(FilePath);
 
     // the rest of this stuff is all meant to be appropriately loading data
     // from the chosen folder
@@ -495,3 +510,33 @@ void SaveLevel(const std::string& FilePath, int format, int version)   // saves
     // LoadCustomGFX2 FileNamePath & Left(FileName, Len(FileName) - 4)
     PlaySound(SFX_GotItem);
 }
+
+bool SaveLevelSnapshot(std::string& out_data, int format, bool sort_objects)
+{
+    LevelData out;
+    s_exportLevel(out, sort_objects);
+
+    out_data.clear();
+
+    bool ret;
+
+    // same writers as SaveLevelFile() uses, so the snapshot loses exactly what saving the level would lose
+    if(format == FileFormats::LVL_SMBX64)
+    {
+        FileFormats::smbx64LevelPrepare(out);
+        ret = FileFormats::WriteSMBX64LvlFileRaw(out, out_data, 64);
+    }
+    else if(format == FileFormats::LVL_SMBX38A)
+        ret = FileFormats::WriteSMBX38ALvlFileRaw(out, out_data);
+    else
+        ret = FileFormats::WriteExtendedLvlFileRaw(out, out_data);
+
+    if(!ret)
+    {
+        pLogWarning("Error while making the level snapshot: %s", out.meta.ERROR_info.c_str());
+        out_data.clear();
+        return false;
+    }
+
+    return true;
+}
@@ -26,4 +26,8 @@
 
 void SaveLevel(const std::string &FilePath, int format, int version = 64);
 
+//! NEW: writes the level into the memory buffer in the given format (used to test the level from the editor without the disk round trip)
+//! sort_objects=false keeps the current order of objects (used by the edit journal while the editor is running)
+bool SaveLevelSnapshot(std::string &out_data, int format, bool sort_objects = true);
+
 #endif // WRITE_LEVEL_HHHH
@@ -129,6 +129,98 @@ static bool s_fontMapsWorld = true;
 static std::string s_lastWorldFontsPath;
 static std::string s_lastCustomFontsPath;
 
+//! Cached result of the text measure or of the word wrap
+struct TextLayout_t
+{
+    //! Source text
+    std::string text;
+    //! Word-wrapped text, optimizeTextPx only
+    std::string wrapped;
+    int         font = 0;
+    uint32_t    fontSize = 0;
+    size_t      maxWidth = 0;
+    PGE_Size    size;
+};
+
+#ifdef LOW_MEM
+typedef std::map<uint64_t, TextLayout_t> TextLayoutCache;
+static const size_t    c_layoutCacheMax = 64;
+#else
+typedef std::unordered_map<uint64_t, TextLayout_t> TextLayoutCache;
+static const size_t    c_layoutCacheMax = 512;
+#endif
+
+//! Max width value of the textSize() entries that are never wrapped
+static const size_t    c_layoutNoWrap = static_cast<size_t>(-1);
+
+/**
+ * Recent and previous generations of the text layouts. Once the recent one gets full,
+ * it becomes previous, and previous gets dropped. Layouts used every frame are moved
+ * back into the recent generation, while one-shot strings (like changing counters) expire.
+ */
+static TextLayoutCache s_layoutCache[2];
+
+static uint64_t s_layoutKey(const char *text, size_t text_size, int font, uint32_t fontSize, size_t maxWidth)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+
+    for(size_t i = 0; i < text_size; ++i)
+    {
+        h ^= static_cast<uint8_t>(text[i]);
+        h *= 0x100000001b3ULL;
+    }
+
+    h ^= (static_cast<uint64_t>(static_cast<uint32_t>(font)) << 32) | fontSize;
+    h *= 0x100000001b3ULL;
+    h ^= static_cast<uint64_t>(maxWidth);
+    h *= 0x100000001b3ULL;
+
+    return h;
+}
+
+static inline bool s_layoutMatches(const TextLayout_t &l, const char *text, size_t text_size, int font, uint32_t fontSize, size_t maxWidth)
+{
+    return l.font == font && l.fontSize == fontSize && l.maxWidth == maxWidth
+        && l.text.size() == text_size && SDL_memcmp(l.text.data(), text, text_size) == 0;
+}
+
+static const TextLayout_t &s_layoutStore(uint64_t key, TextLayout_t &&layout)
+{
+    if(s_layoutCache[0].size() >= c_layoutCacheMax)
+    {
+        s_layoutCache[1] = std::move(s_layoutCache[0]);
+        s_layoutCache[0].clear();
+    }
+
+    TextLayout_t &ret = s_layoutCache[0][key];
+    ret = std::move(layout);
+    return ret;
+}
+
+static const TextLayout_t *s_layoutFind(uint64_t key, const char *text, size_t text_size, int font, uint32_t fontSize, size_t maxWidth)
+{
+    auto it = s_layoutCache[0].find(key);
+    if(it != s_layoutCache[0].end())
+        return s_layoutMatches(it->second, text, text_size, font, fontSize, maxWidth) ? &it->second : nullptr;
+
+    it = s_layoutCache[1].find(key);
+    if(it == s_layoutCache[1].end() || !s_layoutMatches(it->second, text, text_size, font, fontSize, maxWidth))
+        return nullptr;
+
+    // still in use, move into the recent generation
+    TextLayout_t layout = std::move(it->second);
+    s_layoutCache[1].erase(it);
+
+    return &s_layoutStore(key, std::move(layout));
+}
+
+//! Drop all cached layouts once the set of fonts or their IDs were changed
+static void s_layoutCacheClear()
+{
+    s_layoutCache[0].clear();
+    s_layoutCache[1].clear();
+}
+
 
 static void registerFont(BaseFontEngine* font)
 {
@@ -429,6 +521,8 @@ void FontManager::initFallback()
     if(g_fontManagerIsInit)
         return;
 
+    s_layoutCacheClear();
+
 #ifdef THEXTECH_ENABLE_TTF_SUPPORT
     g_defaultTtfFont = nullptr;
 #endif
@@ -459,6 +553,8 @@ void FontManager::initFull()
     g_defaultTtfFont = nullptr;
 #endif
 
+    s_layoutCacheClear();
+
     g_double_pixled = false; //ConfigManager::setup_fonts.double_pixled;
 
     SDL_memset(s_smbxFontsMap, 0, sizeof(s_smbxFontsMap));
@@ -522,6 +618,8 @@ void FontManager::quit()
 
 void FontManager::updateDefaultFontByLang(const std::string &lang, const std::string &country)
 {
+    s_layoutCacheClear();
+
 #ifdef THEXTECH_ENABLE_TTF_SUPPORT
     g_defaultTtfFont = nullptr;
 
@@ -580,6 +678,8 @@ int FontManager::getMetricsValue(UIMetricsCategory category, const std::string &
 
 void FontManager::loadCustomFonts()
 {
+    s_layoutCacheClear();
+
     backupDefaultFontMaps();
     bool doLoadWorld = false;
     bool doLoadCustom = false;
@@ -644,6 +744,7 @@ void FontManager::clearAllCustomFonts()
     s_lastCustomFontsPath.clear();
     s_lastWorldFontsPath.clear();
     restoreDefaultFontMaps();
+    s_layoutCacheClear();
 }
 
 void FontManager::clearLevelFonts()
@@ -655,6 +756,7 @@ void FontManager::clearLevelFonts()
 
     s_lastCustomFontsPath.clear();
     restoreWorldFontMaps();
+    s_layoutCacheClear();
 }
 
 bool FontManager::isInitied()
@@ -682,19 +784,36 @@ PGE_Size FontManager::textSize(const char* text, size_t text_size, int fontID,
     if(!text || text_size == 0)
         return PGE_Size(0, 0);
 
+    BaseFontEngine *font = nullptr;
+
     //Use one of loaded fonts
     if((fontID >= 0) && (static_cast<size_t>(fontID) < g_anyFonts.size()) && g_anyFonts[fontID])
     {
         if(g_anyFonts[fontID]->isLoaded())
-            return g_anyFonts[fontID]->textSize(text, text_size, ttfFontSize);
+            font = g_anyFonts[fontID];
     }
 
 #ifdef THEXTECH_ENABLE_TTF_SUPPORT
-    if(g_defaultTtfFont && g_defaultTtfFont->isLoaded())
-        return g_defaultTtfFont->textSize(text, text_size, ttfFontSize);
+    if(!font && g_defaultTtfFont && g_defaultTtfFont->isLoaded())
+        font = g_defaultTtfFont;
 #endif
 
-    return PGE_Size(27 * 20, static_cast<int>(std::count(text, text + text_size, '\n') + 1) * 20);
+    if(!font)
+        return PGE_Size(27 * 20, static_cast<int>(std::count(text, text + text_size, '\n') + 1) * 20);
+
+    uint64_t key = s_layoutKey(text, text_size, fontID, ttfFontSize, c_layoutNoWrap);
+    const TextLayout_t *cached = s_layoutFind(key, text, text_size, fontID, ttfFontSize, c_layoutNoWrap);
+    if(cached)
+        return cached->size;
+
+    TextLayout_t layout;
+    layout.text.assign(text, text_size);
+    layout.font = fontID;
+    layout.fontSize = ttfFontSize;
+    layout.maxWidth = c_layoutNoWrap;
+    layout.size = font->textSize(text, text_size, ttfFontSize);
+
+    return s_layoutStore(key, std::move(layout)).size;
 }
 
 PGE_Size FontManager::glyphSize(const char* utf8char, uint32_t charNum, int fontId, uint32_t ttf_fontSize)
@@ -912,6 +1031,20 @@ PGE_Size FontManager::optimizeTextPx(std::string& text,
 
     font = g_anyFonts[fontId];
 
+    uint64_t key = s_layoutKey(text.c_str(), text.size(), fontId, ttf_FontSize, max_pixels_lenght);
+    const TextLayout_t *cached = s_layoutFind(key, text.c_str(), text.size(), fontId, ttf_FontSize, max_pixels_lenght);
+    if(cached)
+    {
+        text = cached->wrapped;
+        return cached->size;
+    }
+
+    TextLayout_t layout;
+    layout.text = text;
+    layout.font = fontId;
+    layout.fontSize = ttf_FontSize;
+    layout.maxWidth = max_pixels_lenght;
+
     for(size_t x = 0, i = 0; i < text.size(); i++, x++)
     {
         switch(text[i])
@@ -1002,7 +1135,10 @@ PGE_Size FontManager::optimizeTextPx(std::string& text,
 
     /****************Word wrap*end*****************/
 
-    return PGE_Size(maxWidth, height);
+    layout.wrapped = text;
+    layout.size = PGE_Size(maxWidth, height);
+
+    return s_layoutStore(key, std::move(layout)).size;
 }
 
 std::string FontManager::cropText(std::string text, size_t max_symbols)
@@ -33,6 +33,7 @@
 #   endif
 #endif
 #include "core/render.h"
+#include "globals.h"
 #include <Logger/logger.h>
 #include <unordered_set>
 
@@ -148,6 +149,33 @@ void closeFreeType()
 // Default dummy glyph
 const TtfFont::TheGlyph TtfFont::dummyGlyph = TtfFont::TheGlyph();
 
+//! Width and height of one glyph atlas page
+static const uint32_t s_pageSize = 256;
+
+#ifdef LOW_MEM
+//! Count of atlas pages per font, after that the least recently used page gets reused
+static const size_t   s_pagesMax = 4;
+#else
+static const size_t   s_pagesMax = 16;
+#endif
+
+//! Empty gap between glyphs to avoid bleeding of neighbours at filtered draws
+static const uint32_t s_glyphPadding = 1;
+
+static inline uint64_t s_glyphKey(uint32_t fontSize, char32_t character)
+{
+    // The top bit marks the slot as used
+    return (uint64_t(1) << 63) | (uint64_t(fontSize) << 32) | uint64_t(character);
+}
+
+static inline size_t s_glyphHash(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return static_cast<size_t>(key);
+}
+
 TtfFont::TtfFont() : BaseFontEngine()
 {
     SDL_assert_release(g_ft);
@@ -356,13 +384,35 @@ PGE_Size TtfFont::printText(const char *text, size_t text_size,
 
     uint8_t letter_alpha = color.a;
 
+    const uint32_t glyphSize = m_doublePixel ? (fontSize / 2) : fontSize;
+
     const char *strIt  = text;
     const char *strEnd = strIt + text_size;
+
+    m_useTick++;
+
+    // Load all missing glyphs first to upload every changed atlas page only once
     for(; strIt < strEnd; strIt++)
     {
         const char &cx = *strIt;
         UTF8 ucx = static_cast<unsigned char>(cx);
 
+        if(cx != '\n' && cx != '\t')
+        {
+            // keep the pages of the cached glyphs from being evicted by the glyphs loaded next
+            const TheGlyph &glyph = getGlyph(glyphSize, get_utf8_char(&cx));
+            if(glyph.page)
+                markPage(*glyph.page);
+        }
+
+        strIt += static_cast<size_t>(trailingBytesForUTF8[ucx]);
+    }
+
+    for(strIt = text; strIt < strEnd; strIt++)
+    {
+        const char &cx = *strIt;
+        UTF8 ucx = static_cast<unsigned char>(cx);
+
         switch(cx)
         {
         case '\n':
@@ -384,7 +434,7 @@ PGE_Size TtfFont::printText(const char *text, size_t text_size,
             break;
         }
 
-        const TheGlyph &glyph = getGlyph(m_doublePixel ? (fontSize / 2) : fontSize, get_utf8_char(&cx));
+        const TheGlyph &glyph = getGlyph(glyphSize, get_utf8_char(&cx));
         if(glyph.tx)
         {
             if(crop_info)
@@ -393,16 +443,19 @@ PGE_Size TtfFont::printText(const char *text, size_t text_size,
                     break;
             }
 
-            if(letter_alpha != 0)
+            if(letter_alpha != 0 && prepareGlyph(glyph))
             {
                 int32_t glyph_x = x + static_cast<int32_t>(offsetX);
                 int32_t glyph_y = y + static_cast<int32_t>(offsetY + fontSize);
-                XRender::renderTextureScale(
+                XRender::renderTextureScaleEx(
                     glyph_x + glyph.info.left,
                     glyph_y - glyph.info.top,
                     (m_doublePixel ? (glyph.info.width * 2) : glyph.info.width),
                     (m_doublePixel ? (glyph.info.height * 2) : glyph.info.height),
                     *glyph.tx,
+                    glyph.page_x, glyph.page_y,
+                    glyph.info.width, glyph.info.height,
+                    0, nullptr, X_FLIP_NONE,
                     color.with_alpha(letter_alpha)
                 );
             }
@@ -461,9 +514,11 @@ uint32_t TtfFont::drawGlyph(const char *u8char,
 
 uint32_t TtfFont::drawGlyphB(const char *u8char, int32_t x, int32_t baseline_y, uint32_t fontSize, int scaleSize, bool drawOutlines, XTColor color, XTColor OL_color)
 {
+    m_useTick++;
+
     const TheGlyph &glyph = getGlyph(fontSize, get_utf8_char(u8char));
 
-    if(glyph.tx)
+    if(glyph.tx && prepareGlyph(glyph))
     {
         int32_t glyph_x = x + (glyph.info.left * scaleSize);
         int32_t glyph_y = baseline_y - (glyph.info.top * scaleSize);
@@ -485,15 +540,22 @@ uint32_t TtfFont::drawGlyphB(const char *u8char, int32_t x, int32_t baseline_y,
 
             for(size_t i = 0; i < 4; ++i)
             {
-                XRender::renderTextureScale(
+                XRender::renderTextureScaleEx(
                     glyph_x + offsets[i][0], glyph_y + offsets[i][1],
                     glyph_w, glyph_h, *glyph.tx,
+                    glyph.page_x, glyph.page_y,
+                    glyph.info.width, glyph.info.height,
+                    0, nullptr, X_FLIP_NONE,
                     color.with_alpha(scaled_a) * OL_color
                 );
             }
         }
 
-        XRender::renderTextureScale(glyph_x, glyph_y, glyph_w, glyph_h, *glyph.tx, color);
+        XRender::renderTextureScaleEx(glyph_x, glyph_y, glyph_w, glyph_h, *glyph.tx,
+                                      glyph.page_x, glyph.page_y,
+                                      glyph.info.width, glyph.info.height,
+                                      0, nullptr, X_FLIP_NONE,
+                                      color);
 
 #ifdef TTF_RENDER_DEBUG
         XRender::renderRect(x, baseline_y - glyph_h, glyph_w, glyph_h, XTColor(0, 0, 255, 128), false);
@@ -512,40 +574,214 @@ TtfFont::TheGlyphInfo TtfFont::getGlyphInfo(const char *u8char, uint32_t fontSiz
     return glyph.info;
 }
 
-const TtfFont::TheGlyph &TtfFont::getGlyph(uint32_t fontSize, char32_t character)
+TtfFont::TheGlyph *TtfFont::findGlyph(uint64_t key)
 {
-    auto fSize = m_charMap.find(fontSize);
-    if(fSize != m_charMap.end())
+    if(m_glyphs.empty())
+        return nullptr;
+
+    const size_t mask = m_glyphs.size() - 1;
+
+    for(size_t i = s_glyphHash(key) & mask; ; i = (i + 1) & mask)
     {
-        auto rc = fSize->second.find(character);
-        if(rc != fSize->second.end())
+        GlyphSlot &slot = m_glyphs[i];
+
+        if(slot.key == key)
+            return &slot.glyph;
+
+        if(slot.key == 0)
+            return nullptr;
+    }
+}
+
+TtfFont::TheGlyph &TtfFont::insertGlyph(uint64_t key, const TheGlyph &glyph)
+{
+    // Keep the cache at most half-full to have short probe sequences
+    if((m_glyphsCount + 1) * 2 > m_glyphs.size())
+        rehashGlyphs(m_glyphs.empty() ? 256 : m_glyphs.size() * 2);
+
+    const size_t mask = m_glyphs.size() - 1;
+    size_t i = s_glyphHash(key) & mask;
+
+    while(m_glyphs[i].key != 0 && m_glyphs[i].key != key)
+        i = (i + 1) & mask;
+
+    GlyphSlot &slot = m_glyphs[i];
+
+    if(slot.key == 0)
+        m_glyphsCount++;
+
+    slot.key = key;
+    slot.glyph = glyph;
+
+    return slot.glyph;
+}
+
+void TtfFont::rehashGlyphs(size_t capacity, const GlyphPage *drop_page)
+{
+    std::vector<GlyphSlot> old_glyphs(capacity);
+    old_glyphs.swap(m_glyphs);
+    m_glyphsCount = 0;
+
+    const size_t mask = m_glyphs.size() - 1;
+
+    for(const GlyphSlot &old : old_glyphs)
+    {
+        if(old.key == 0 || (drop_page && old.glyph.page == drop_page))
+            continue;
+
+        size_t i = s_glyphHash(old.key) & mask;
+
+        while(m_glyphs[i].key != 0)
+            i = (i + 1) & mask;
+
+        m_glyphs[i] = old;
+        m_glyphsCount++;
+    }
+}
+
+bool TtfFont::packGlyph(GlyphPage &page, uint32_t w, uint32_t h, uint16_t &out_x, uint16_t &out_y)
+{
+    GlyphShelf *best = nullptr;
+
+    // Take the lowest shelf that fits the glyph
+    for(GlyphShelf &shelf : page.shelves)
+    {
+        if(shelf.h < h || shelf.x + w > s_pageSize)
+            continue;
+
+        if(!best || shelf.h < best->h)
+            best = &shelf;
+    }
+
+    uint32_t top = page.shelves.empty() ? 0 : (page.shelves.back().y + page.shelves.back().h);
+    bool can_open = (top + h <= s_pageSize);
+
+    // Open a new shelf instead of wasting more than a half of the found one
+    if(can_open && (!best || best->h > h * 2))
+    {
+        GlyphShelf shelf;
+        shelf.y = static_cast<uint16_t>(top);
+        shelf.h = static_cast<uint16_t>(h);
+        page.shelves.push_back(shelf);
+        best = &page.shelves.back();
+    }
+
+    if(!best)
+        return false;
+
+    out_x = best->x;
+    out_y = best->y;
+    best->x += static_cast<uint16_t>(w);
+
+    return true;
+}
+
+TtfFont::GlyphPage *TtfFont::allocGlyphRect(uint32_t fontSize, uint32_t w, uint32_t h, uint16_t &out_x, uint16_t &out_y)
+{
+    w += s_glyphPadding;
+    h += s_glyphPadding;
+
+    if(w > s_pageSize || h > s_pageSize)
+        return nullptr;
+
+    GlyphPage *target = nullptr;
+    GlyphPage *lru = nullptr;
+
+    for(GlyphPage &page : m_pages)
+    {
+        if(page.fontSize == fontSize && packGlyph(page, w, h, out_x, out_y))
         {
-            // reload if the renderer has unloaded the glyph
-            if(rc->second.tx && !rc->second.tx->d.hasTexture())
-                return loadGlyph(*(rc->second.tx), fontSize, character);
+            target = &page;
+            break;
+        }
+
+        // Pages used by the current draw call or frame are never evicted: their glyphs are already queued
+        if(page.lastUse != m_useTick && page.lastFrame != CommonFrame && (!lru || page.lastUse < lru->lastUse))
+            lru = &page;
+    }
 
-            return rc->second;
+    if(!target)
+    {
+        if(m_pages.size() >= s_pagesMax && lru)
+        {
+            evictPage(*lru);
+            target = lru;
+        }
+        else
+        {
+            m_pages.emplace_back();
+            target = &m_pages.back();
+            target->pixels.resize(s_pageSize * s_pageSize * 4, 0);
         }
-        return loadGlyph(fontSize, character);
+
+        target->fontSize = fontSize;
+
+        bool packed = packGlyph(*target, w, h, out_x, out_y);
+        SDL_assert_release(packed); // Empty page must fit any glyph smaller than the page
+        (void)packed;
     }
 
-    return loadGlyph(fontSize, character);
+    markPage(*target);
+
+    return target;
 }
 
-const TtfFont::TheGlyph &TtfFont::loadGlyph(uint32_t fontSize, char32_t character)
+void TtfFont::evictPage(GlyphPage &page)
 {
-    m_texturesBank.emplace_back();
-    StdPicture &texture = m_texturesBank.back();
+    D_pLogDebug("TtfFont: Reusing the atlas page %p of the font size %" PRIu32, static_cast<void*>(&page), page.fontSize);
 
-    const TtfFont::TheGlyph &ret = loadGlyph(texture, fontSize, character);
+    rehashGlyphs(m_glyphs.size(), &page);
 
-    if(ret.tx != &texture)
-        m_texturesBank.pop_back();
+    SDL_memset(page.pixels.data(), 0, page.pixels.size());
+    page.shelves.clear();
+    page.dirty = true;
+}
 
-    return ret;
+void TtfFont::markPage(GlyphPage &page)
+{
+    page.lastUse = m_useTick;
+    page.lastFrame = CommonFrame;
 }
 
-const TtfFont::TheGlyph &TtfFont::loadGlyph(StdPicture &texture, uint32_t fontSize, char32_t character)
+void TtfFont::uploadPage(GlyphPage &page)
+{
+    if(page.tx.d.hasTexture())
+        XRender::unloadTexture(page.tx);
+
+    page.tx.w = s_pageSize;
+    page.tx.h = s_pageSize;
+
+    XRender::loadTexture(page.tx, s_pageSize, s_pageSize, page.pixels.data(), s_pageSize * 4);
+
+    page.dirty = false;
+}
+
+bool TtfFont::prepareGlyph(const TheGlyph &glyph)
+{
+    if(!glyph.page)
+        return false;
+
+    GlyphPage &page = *glyph.page;
+    markPage(page);
+
+    // reload if the page got new glyphs or the renderer has unloaded it
+    if(page.dirty || !page.tx.d.hasTexture())
+        uploadPage(page);
+
+    return page.tx.d.hasTexture();
+}
+
+const TtfFont::TheGlyph &TtfFont::getGlyph(uint32_t fontSize, char32_t character)
+{
+    const TheGlyph *rc = findGlyph(s_glyphKey(fontSize, character));
+
+    if(rc)
+        return *rc;
+
+    return loadGlyph(fontSize, character);
+}
+
+const TtfFont::TheGlyph &TtfFont::loadGlyph(uint32_t fontSize, char32_t character)
 {
     FT_Error     error = 0;
     FT_UInt      t_glyphIndex = 0;
@@ -606,8 +842,10 @@ const TtfFont::TheGlyph &TtfFont::loadGlyph(StdPicture &texture, uint32_t fontSi
     uint32_t height     = bitmap.rows;
     uint32_t pitch      = width * 4;
 
+    // Remember blank glyphs (like spaces) to don't load them again at every draw,
+    // missing ones are retried as a fallback font may get loaded later
     if((width == 0) || (height == 0))
-        return dummyGlyph;
+        return (t_glyphIndex != 0) ? insertGlyph(s_glyphKey(fontSize, character), dummyGlyph) : dummyGlyph;
 
     SDL_assert_release(bitmap.buffer); // Buffer must NOT be null
 
@@ -755,20 +993,26 @@ const TtfFont::TheGlyph &TtfFont::loadGlyph(StdPicture &texture, uint32_t fontSi
         break;
     }
 
-    if(m_doublePixel)
-    {
-        texture.w = width * 2;
-        texture.h = height * 2;
-    }
-    else
+    uint16_t page_x = 0;
+    uint16_t page_y = 0;
+    GlyphPage *page = allocGlyphRect(fontSize, width, height, page_x, page_y);
+
+    if(!page)
     {
-        texture.w = width;
-        texture.h = height;
+        pLogWarning("TtfFont::TheGlyph: The glyph %" PRIu32 "x%" PRIu32 " is larger than the atlas page", width, height);
+        delete [] image;
+        return dummyGlyph;
     }
 
-    XRender::loadTexture(texture, width, height, image, pitch);
+    for(uint32_t h = 0; h < height; ++h)
+        SDL_memcpy(page->pixels.data() + ((page_y + h) * s_pageSize + page_x) * 4, image + h * pitch, pitch);
 
-    t_glyph.tx      = &texture;
+    page->dirty = true;
+
+    t_glyph.tx      = &page->tx;
+    t_glyph.page    = page;
+    t_glyph.page_x  = page_x;
+    t_glyph.page_y  = page_y;
     t_glyph.info.width   = width;
     t_glyph.info.height  = height;
     t_glyph.info.left    = glyph->bitmap_left;
@@ -824,17 +1068,5 @@ const TtfFont::TheGlyph &TtfFont::loadGlyph(StdPicture &texture, uint32_t fontSi
 
     delete [] image;
 
-    auto fSize = m_charMap.find(fontSize);
-    if(fSize == m_charMap.end())
-    {
-        m_charMap.insert({fontSize, CharMap()});
-        fSize = m_charMap.find(fontSize);
-        SDL_assert_release(fSize != m_charMap.end());
-    }
-
-    fSize->second.insert({character, t_glyph});
-    auto rc = fSize->second.find(character);
-    SDL_assert_release(rc != fSize->second.end());
-
-    return rc->second;
+    return insertGlyph(s_glyphKey(fontSize, character), t_glyph);
 }
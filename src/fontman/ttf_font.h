@@ -22,11 +22,7 @@
 #define TTF_FONT_H
 
 
-#ifdef LOW_MEM
-#   include <map>
-#else
-#   include <unordered_map>
-#endif
+#include <vector>
 #include <Utils/vptrlist.h>
 #include "std_picture.h"
 
@@ -200,34 +196,94 @@ private:
     //! Font face preferred bitmap size, 0 to disable
     int          m_bitmapSize = 0;
 
+    struct GlyphPage;
+
     struct TheGlyph
     {
         TheGlyph() = default;
         StdPicture *tx     = nullptr;
+        //! Atlas page that holds the glyph image (null for empty glyphs)
+        GlyphPage  *page   = nullptr;
+        //! Position of the glyph image at the atlas page
+        uint16_t    page_x = 0;
+        uint16_t    page_y = 0;
         TheGlyphInfo info;
     };
 
     //! Default dummy glyph
     static const TheGlyph dummyGlyph;
 
-    const TheGlyph &getGlyph(uint32_t fontSize, char32_t character);
+    /**
+     * @brief One row of the shelf packer: glyphs of a similar height are placed left to right
+     */
+    struct GlyphShelf
+    {
+        uint16_t y = 0;
+        uint16_t h = 0;
+        uint16_t x = 0;
+    };
 
-    // version allocating a new texture
-    const TheGlyph &loadGlyph(uint32_t fontSize, char32_t character);
+    /**
+     * @brief Atlas texture that keeps glyphs of one font size
+     *
+     * Pixel data is kept to re-upload the texture when new glyphs were added
+     * or when the renderer has unloaded all textures. Glyphs are only appended
+     * into the page until it gets evicted, so the draws already queued from the
+     * same page stay valid after re-upload.
+     */
+    struct GlyphPage
+    {
+        StdPicture tx;
+        std::vector<uint8_t> pixels;
+        std::vector<GlyphShelf> shelves;
+        uint32_t fontSize = 0;
+        //! Value of m_useTick at the recent use of the page
+        uint32_t lastUse = 0;
+        //! Game frame of the recent use of the page, the draws queued during it may still refer to the page
+        uint32_t lastFrame = 0;
+        //! Pixels were changed since recent upload
+        bool dirty = false;
+    };
+
+    /**
+     * @brief Slot of the open-addressed glyph cache
+     */
+    struct GlyphSlot
+    {
+        //! Packed font size and character, 0 for the free slot
+        uint64_t key = 0;
+        TheGlyph glyph;
+    };
 
-    // version using an existing texture
-    const TheGlyph &loadGlyph(StdPicture &texture, uint32_t fontSize, char32_t character);
+    const TheGlyph &getGlyph(uint32_t fontSize, char32_t character);
 
-#ifdef LOW_MEM
-    typedef std::map<char32_t, TheGlyph> CharMap;
-    typedef std::map<uint32_t, CharMap>  SizeCharMap;
-#else
-    typedef std::unordered_map<char32_t, TheGlyph> CharMap;
-    typedef std::unordered_map<uint32_t, CharMap>  SizeCharMap;
-#endif
+    const TheGlyph &loadGlyph(uint32_t fontSize, char32_t character);
 
-    SizeCharMap m_charMap;
-    VPtrList<StdPicture > m_texturesBank;
+    //! Find a free place at the atlas for the glyph of given size, evicts the least recently used page when needed
+    GlyphPage *allocGlyphRect(uint32_t fontSize, uint32_t w, uint32_t h, uint16_t &out_x, uint16_t &out_y);
+    //! Remove all glyphs of the page and make it empty to be reused
+    void evictPage(GlyphPage &page);
+    //! Place the rectangle at the shelf of the page, returns false if the page is full
+    static bool packGlyph(GlyphPage &page, uint32_t w, uint32_t h, uint16_t &out_x, uint16_t &out_y);
+    //! Mark the page as used by the current draw call and frame
+    void markPage(GlyphPage &page);
+    //! Send the page pixels to the renderer if it was changed or unloaded
+    void uploadPage(GlyphPage &page);
+    //! Upload the page if needed and mark it as used by the current draw call
+    bool prepareGlyph(const TheGlyph &glyph);
+
+    TheGlyph *findGlyph(uint64_t key);
+    TheGlyph &insertGlyph(uint64_t key, const TheGlyph &glyph);
+    void rehashGlyphs(size_t capacity, const GlyphPage *drop_page = nullptr);
+
+    //! Flat glyph cache, the capacity is always a power of two
+    std::vector<GlyphSlot> m_glyphs;
+    //! Count of used slots at the glyph cache
+    size_t m_glyphsCount = 0;
+    //! Atlas pages of all sizes
+    VPtrList<GlyphPage> m_pages;
+    //! Counter of draw calls, used to find the least recently used page
+    uint32_t m_useTick = 0;
 };
 
 #endif // TTF_FONT_H
@@ -24,6 +24,7 @@
 
 #include <fmt_format_ne.h>
 #include <Logger/logger.h>
+#include <Utils/files.h>
 #include "pge_delay.h"
 
 #include "frame_timer.h"
@@ -33,6 +34,7 @@
 #include "message.h"
 #include "core/render.h"
 #include "core/events.h"
+#include "sound_thread.h"
 
 #include "npc/npc_queues.h"
 
@@ -71,6 +73,27 @@
 MicroStats g_microStats;
 PerformanceStats_t g_stats;
 
+// NEW: Chrome trace-event JSON of the tasks, viewable in Perfetto or chrome://tracing
+static FILE             *s_frameTrace = nullptr;
+static std::string       s_frameTraceBuf;
+static uint64_t          s_frameTraceStart = 0;
+static uint64_t          s_frameTraceBegin = 0; // start of the first task of the current frame
+static const size_t      c_frameTraceFlush = 65536;
+
+static void s_frameTraceEvent(const char *name, uint64_t begin, uint64_t end)
+{
+    s_frameTraceBuf += fmt::format_ne(",\n{{\"name\":\"{0}\",\"ph\":\"X\",\"ts\":{1},\"dur\":{2},\"pid\":1,\"tid\":1}}",
+                                      name, begin - s_frameTraceStart, end - begin);
+}
+
+static void s_frameTraceWrite()
+{
+    if(fwrite(s_frameTraceBuf.data(), 1, s_frameTraceBuf.size(), s_frameTrace) != s_frameTraceBuf.size())
+        pLogWarning("frame_timer: failed to write the frame trace");
+
+    s_frameTraceBuf.clear();
+}
+
 void MicroStats::reset()
 {
     for(uint8_t i = 0; i < TASK_END; i++)
@@ -87,6 +110,35 @@ void MicroStats::reset()
 
     m_cur_task = TASK_END;
     m_cur_frame = 0;
+
+    for(uint8_t i = 0; i < TASK_END; i++)
+        m_frame_timer[i] = 0;
+
+    for(int i = 0; i <= TASK_END; i++)
+    {
+        for(int bin = 0; bin < HIST_BINS; bin++)
+            level_hist[i][bin] = 0;
+
+        level_max[i] = 0;
+    }
+
+    m_level_frame = 0;
+
+    view_frame_p50 = 0;
+    view_frame_p99 = 0;
+    view_frame_max = 0;
+}
+
+static inline int s_hist_bin(uint64_t time)
+{
+    int bin = 0;
+    while(bin < MicroStats::HIST_BINS - 1 && time != 0)
+    {
+        time >>= 1;
+        bin++;
+    }
+
+    return bin;
 }
 
 void MicroStats::start_task(Task task)
@@ -97,7 +149,16 @@ void MicroStats::start_task(Task task)
     {
         m_cur_timer[m_cur_task] += next_time - m_cur_time;
         level_timer[m_cur_task] += next_time - m_cur_time;
+        m_frame_timer[m_cur_task] += next_time - m_cur_time;
         m_frame_time += next_time - m_cur_time;
+
+        if(s_frameTrace)
+        {
+            if(!s_frameTraceBegin)
+                s_frameTraceBegin = m_cur_time;
+
+            s_frameTraceEvent(task_names[m_cur_task], m_cur_time, next_time);
+        }
     }
 
     m_cur_time = next_time;
@@ -116,6 +177,33 @@ void MicroStats::end_frame()
     m_cur_frame++;
     m_level_frame++;
 
+    for(uint8_t i = 0; i < TASK_END; i++)
+    {
+        level_hist[i][s_hist_bin(m_frame_timer[i])]++;
+        if(m_frame_timer[i] > level_max[i])
+            level_max[i] = m_frame_timer[i];
+
+        m_frame_timer[i] = 0;
+    }
+
+    level_hist[TASK_END][s_hist_bin(m_frame_time)]++;
+    if(m_frame_time > level_max[TASK_END])
+        level_max[TASK_END] = m_frame_time;
+
+    if(s_frameTrace)
+    {
+        if(s_frameTraceBegin)
+        {
+            s_frameTraceBuf += fmt::format_ne(",\n{{\"name\":\"Frame\",\"ph\":\"X\",\"ts\":{0},\"dur\":{1},\"pid\":1,\"tid\":1,\"args\":{{\"frame\":{2}}}}}",
+                                              s_frameTraceBegin - s_frameTraceStart, m_cur_time - s_frameTraceBegin, m_level_frame);
+        }
+
+        s_frameTraceBegin = 0;
+
+        if(s_frameTraceBuf.size() >= c_frameTraceFlush)
+            s_frameTraceWrite();
+    }
+
     if(m_frame_time > m_slow_frame_time)
         m_slow_frame_time = m_frame_time;
 
@@ -135,9 +223,140 @@ void MicroStats::end_frame()
 
         view_slow_frame_time = (m_slow_frame_time * 66 + 500) / 1000;
         m_slow_frame_time = 0;
+
+        view_frame_p50 = (int)level_percentile(TASK_END, 50);
+        view_frame_p99 = (int)level_percentile(TASK_END, 99);
+        view_frame_max = (int)level_max[TASK_END];
+
+        view_jitter_avg = (m_cur_jitter_frames > 0) ? (int)(m_cur_jitter_sum / m_cur_jitter_frames) : 0;
+        view_jitter_max = m_cur_jitter_max;
+        m_cur_jitter_sum = 0;
+        m_cur_jitter_max = 0;
+        m_cur_jitter_frames = 0;
     }
 }
 
+constexpr int MicroStats::JITTER_BINS;
+
+const int MicroStats::jitter_bin_edges[JITTER_BINS - 1] =
+{
+    -1000, -250, -50, 50, 250, 500, 1000, 2000, 4000, 8000
+};
+
+void MicroStats::add_jitter(int deviation)
+{
+    int bin = 0;
+    while(bin < JITTER_BINS - 1 && deviation >= jitter_bin_edges[bin])
+        bin++;
+
+    jitter_hist[bin]++;
+    jitter_frames++;
+
+    int abs_dev = (deviation < 0) ? -deviation : deviation;
+
+    jitter_abs_sum += abs_dev;
+    if(abs_dev > jitter_max)
+        jitter_max = abs_dev;
+
+    m_cur_jitter_sum += abs_dev;
+    m_cur_jitter_frames++;
+    if(abs_dev > m_cur_jitter_max)
+        m_cur_jitter_max = abs_dev;
+}
+
+bool MicroStats::dump_jitter(const std::string &path) const
+{
+    FILE *f = Files::utf8_fopen(path.c_str(), "w");
+    if(!f)
+        return false;
+
+    std::string out;
+
+    out += fmt::format_ne("pacing: {0}\n", g_config.precise_pacing ? "precise" : "sleep");
+    out += fmt::format_ne("frames: {0}\n", jitter_frames);
+    out += fmt::format_ne("mean-abs-us: {0}\n", jitter_frames ? jitter_abs_sum / jitter_frames : 0);
+    out += fmt::format_ne("max-abs-us: {0}\n", jitter_max);
+
+    for(int i = 0; i < JITTER_BINS; i++)
+    {
+        std::string range;
+
+        if(i == 0)
+            range = fmt::format_ne("< {0}", jitter_bin_edges[0]);
+        else if(i == JITTER_BINS - 1)
+            range = fmt::format_ne(">= {0}", jitter_bin_edges[JITTER_BINS - 2]);
+        else
+            range = fmt::format_ne("{0} .. {1}", jitter_bin_edges[i - 1], jitter_bin_edges[i]);
+
+        double share = jitter_frames ? (double)jitter_hist[i] * 100.0 / (double)jitter_frames : 0.0;
+        out += fmt::sprintf_ne("%-14s %10llu %6.2f%%\n", range.c_str(), (unsigned long long)jitter_hist[i], share);
+    }
+
+    bool ok = fwrite(out.data(), 1, out.size(), f) == out.size();
+    fclose(f);
+
+    return ok;
+}
+
+constexpr int MicroStats::HIST_BINS;
+
+uint64_t MicroStats::level_percentile(int task, int percent) const
+{
+    if(m_level_frame == 0)
+        return 0;
+
+    uint64_t target = (m_level_frame * percent + 99) / 100;
+    if(target == 0)
+        target = 1;
+
+    uint64_t count = 0;
+
+    for(int bin = 0; bin < HIST_BINS; bin++)
+    {
+        count += level_hist[task][bin];
+
+        if(count < target)
+            continue;
+
+        if(bin == 0)
+            return 0;
+
+        // the last bin is unbounded
+        uint64_t upper = (bin < HIST_BINS - 1) ? (uint64_t(1) << bin) - 1 : level_max[task];
+
+        return (upper < level_max[task]) ? upper : level_max[task];
+    }
+
+    return level_max[task];
+}
+
+void MicroStats::end_level(const std::string &level_name)
+{
+    // close the running task, if any, so its time and trace event aren't lost, and resume it afterwards
+    Task cur_task = (Task)m_cur_task;
+    start_task(TASK_END);
+
+    if(m_level_frame > 0)
+    {
+        pLogInfo("MicroStats: level [%s], %llu frames, time per frame (p50/p99/max, us):",
+                 level_name.c_str(), (unsigned long long)m_level_frame);
+
+        for(int i = 0; i <= TASK_END; i++)
+        {
+            pLogInfo("MicroStats:   %s %7llu %7llu %7llu",
+                     (i < TASK_END) ? task_names[i] : "Frm",
+                     (unsigned long long)level_percentile(i, 50),
+                     (unsigned long long)level_percentile(i, 99),
+                     (unsigned long long)level_max[i]);
+        }
+    }
+
+    reset();
+
+    if(cur_task < TASK_END)
+        start_task(cur_task);
+}
+
 void PerformanceStats_t::next_page()
 {
     if((XRender::TargetW >= 720 && XRender::TargetH >= 360) || (LevelSelect && !GameMenu))
@@ -213,9 +432,12 @@ static void s_print_ram(int, int) {}
 
 void PerformanceStats_t::print_filenames(int x, int y)
 {
-    int items = (GameMenu) ? 4 : 3;
+    int items = (GameMenu) ? 5 : 4;
     int row = 0;
 
+    SfxQueueStats_t sfxq;
+    GetSfxQueueStats(sfxq);
+
     XRender::renderRect(x, y, 745, 6 + (18 * items), XTColorF(0.0_n, 0.0_n, 0.0_n, 0.3_n), true);
 
     SuperPrint(fmt::sprintf_ne("FILE: %s", FileNameFull.empty() ? "<none>" : FileNameFull.c_str()),
@@ -224,6 +446,8 @@ void PerformanceStats_t::print_filenames(int x, int y)
                3, x + 4, YLINE, XTColorF(1.0_n, 0.5_n, 1.0_n));
     SuperPrint(fmt::sprintf_ne("MUSF: %s", currentMusicFile.empty() ? "<none>" : currentMusicFile.c_str()),
                3, x + 4, YLINE, XTColorF(1.0_n, 0.5_n, 1.0_n));
+    SuperPrint(fmt::sprintf_ne("SFXQ: %03d/%03d DROP=%u MERGE=%u", sfxq.depth, sfxq.peak_depth, (unsigned)sfxq.dropped, (unsigned)sfxq.coalesced),
+               3, x + 4, YLINE, XTColorF(1.0_n, 0.5_n, 1.0_n));
 
     if(GameMenu)
     {
@@ -255,6 +479,22 @@ void PerformanceStats_t::print_obj_stats(int x, int y)
 void PerformanceStats_t::print_cpu_stats(int x, int y)
 {
     int items = 6;
+    int row = 6;
+
+    if(renderOps)
+        items++;
+
+    if(g_config.frame_delay > 0)
+        items++;
+
+    if(g_config.run_ahead > 0)
+        items++;
+
+    if(g_microStats.jitter_frames > 0)
+        items++;
+
+    if(g_microStats.view_frame_max > 0)
+        items++;
 
     XRender::renderRect(x, y, 340, 6 + (18 * items), XTColorF(0.0_n, 0.0_n, 0.0_n, 0.3_n), true);
 
@@ -277,6 +517,43 @@ void PerformanceStats_t::print_cpu_stats(int x, int y)
                                g_microStats.task_names[8], g_microStats.view_timer[8],
                                g_microStats.task_names[9], g_microStats.view_timer[9]),
                3, x + 164, y + 2 + 18, XTColorF(1.0_n, 1.0_n, 0.5_n));
+
+    if(renderOps)
+    {
+        SuperPrint(fmt::sprintf_ne("Q: %04d OPS/%04d BAT/%04d GEO",
+                                   renderOps, renderBatches, renderGeometryCalls),
+                   3, x + 4, y + 2 + 18 * row++, XTColorF(0.5_n, 1.0_n, 1.0_n));
+    }
+
+    if(g_config.frame_delay > 0)
+    {
+        SuperPrint(fmt::sprintf_ne("DLY: %02d.%dms PROC: %02d.%dms",
+                                   frameDelay / 1000, (frameDelay / 100) % 10,
+                                   frameProcessMax / 1000, (frameProcessMax / 100) % 10),
+                   3, x + 4, y + 2 + 18 * row++, XTColorF(0.5_n, 1.0_n, 1.0_n));
+    }
+
+    if(g_config.run_ahead > 0)
+    {
+        // save / restore / hidden frames
+        SuperPrint(fmt::sprintf_ne("RA: %d %04d/%04d/%05dus",
+                                   runAheadFrames, runAheadSave, runAheadLoad, runAheadRun),
+                   3, x + 4, y + 2 + 18 * row++, XTColorF(0.5_n, 1.0_n, 1.0_n));
+    }
+
+    if(g_microStats.jitter_frames > 0)
+    {
+        SuperPrint(fmt::sprintf_ne("JIT: %04dus AVG/%05dus MAX",
+                                   g_microStats.view_jitter_avg, g_microStats.view_jitter_max),
+                   3, x + 4, y + 2 + 18 * row++, XTColorF(0.5_n, 1.0_n, 1.0_n));
+    }
+
+    if(g_microStats.view_frame_max > 0)
+    {
+        SuperPrint(fmt::sprintf_ne("P50/99/MAX: %05d/%05d/%05d",
+                                   g_microStats.view_frame_p50, g_microStats.view_frame_p99, g_microStats.view_frame_max),
+                   3, x + 4, y + 2 + 18 * row++, XTColorF(0.5_n, 1.0_n, 1.0_n));
+    }
 }
 
 void PerformanceStats_t::print()
@@ -316,7 +593,7 @@ void PerformanceStats_t::print()
         int next_y = 6;
         print_filenames(6 + XRender::TargetOverscanX, next_y);
 
-        next_y += (GameMenu) ? 6 + 18 * 4 : 6 + 18 * 3;
+        next_y += (GameMenu) ? 6 + 18 * 5 : 6 + 18 * 4;
 
         if(!GameMenu)
         {
@@ -416,6 +693,33 @@ static nanotime_t        s_stopProcessing = 0;
 static nanotime_t        s_doUpdate = 0;
 #endif
 
+// NEW: frame delay, the frame is started later within its period to read the controls closer to the present
+static const  nanotime_t c_frameDelayMargin = 2000000;
+static const  int        c_frameProcessWindow = 64;
+static uint64_t          s_frameProcessStart = 0;
+static uint64_t          s_frameProcessMax[2] = {0, 0}; // maximum processing time of the current and the previous window, in microseconds
+static int               s_frameProcessCount = 0;
+
+// NEW: precise pacing, sleeps until a calibrated margin before the frame start, and spins for the rest
+static const  nanotime_t c_spinMarginMin = 250000;
+static const  nanotime_t c_spinMarginMax = 4000000;
+static nanotime_t        s_spinMargin = 2000000;
+static nanotime_t        s_frameTarget = 0; // planned start time of the next frame at the precise clock
+static nanotime_t        s_frameStart = 0; // actual start time of the current frame at the precise clock
+static std::string       s_frameJitterLog;
+
+// NEW: fast-forward mode
+static bool              s_fastForward = false;
+static int               s_fastForwardEvery = 1;
+static int               s_fastForwardCount = 0;
+static uint64_t          s_fastForwardInterval = 0; // wall-clock period of the drawn frames in microseconds, 0 to draw every Nth frame
+static uint64_t          s_fastForwardLastDraw = 0;
+
+static inline nanotime_t getPreciseTime()
+{
+    return static_cast<nanotime_t>(SDL_GetMicroTicks()) * 1000;
+}
+
 #endif
 // ----------------------------------------------------
 
@@ -554,6 +858,135 @@ static inline void computeFrameTime1Real_2()
         s_cycleCount = 0; // Fixes Overflow bug
 }
 
+// plans the start of the next frame, for the precise pacing a period after the previous plan so that the rounding doesn't drift
+static void planNextFrame()
+{
+    nanotime_t now = getPreciseTime();
+
+    if(!g_config.precise_pacing)
+    {
+        s_frameTarget = (s_frameStart != 0) ? s_frameStart + c_frameRateNano : 0;
+        return;
+    }
+
+    if(s_frameTarget == 0 || now - s_frameTarget > c_frameRateNano * 2)
+        s_frameTarget = now; // stalled or just started, don't try to catch up
+    else
+        s_frameTarget += c_frameRateNano;
+}
+
+static void preciseSleep()
+{
+    nanotime_t left = s_frameTarget - getPreciseTime();
+
+    while(left - s_spinMargin >= 1000000)
+    {
+        uint32_t ms = (uint32_t)((left - s_spinMargin) / 1000000);
+        nanotime_t start = getPreciseTime();
+
+        PGE_Delay(ms);
+
+        nanotime_t now = getPreciseTime();
+        nanotime_t overslept = (now - start) - (nanotime_t)ms * 1000000;
+
+        // calibrate the margin by the worst recent oversleep, slowly forget the old ones
+        nanotime_t margin = s_spinMargin - s_spinMargin / 64;
+        if(overslept + c_spinMarginMin > margin)
+            margin = overslept + c_spinMarginMin;
+
+        if(margin < c_spinMarginMin)
+            margin = c_spinMarginMin;
+        else if(margin > c_spinMarginMax)
+            margin = c_spinMarginMax;
+
+        s_spinMargin = margin;
+
+        left = s_frameTarget - now;
+    }
+
+    while(getPreciseTime() < s_frameTarget)
+    {
+        // spin
+    }
+}
+
+// measures how far the frame has started from the plan
+static void frameStartJitter()
+{
+    if(g_config.unlimited_framerate)
+    {
+        s_frameTarget = 0;
+        s_frameStart = 0;
+        return;
+    }
+
+    s_frameStart = getPreciseTime();
+
+    if(s_frameTarget == 0)
+        return;
+
+    nanotime_t deviation = s_frameStart - s_frameTarget;
+
+    // too late to be about pacing (loading, pause, or a debugger)
+    if(deviation > c_frameRateNano * 2)
+        return;
+
+    g_microStats.add_jitter((int)(deviation / 1000));
+}
+
+// returns true if the frame has been delayed, then the events need to be pumped again to get the fresh controls state
+static bool frameDelayStart()
+{
+    bool delayed = false;
+    uint64_t start = SDL_GetMicroTicks();
+    nanotime_t delay = (nanotime_t)g_config.frame_delay * 1000000;
+
+    // don't delay while catching up, or while the framerate isn't limited
+    if(delay > 0 && !g_config.unlimited_framerate && !frameSkipNeeded() && XMessage::GetStatus() == XMessage::Status::local)
+    {
+        // the delay must leave the time the recent frames took to process
+        uint64_t process_max = SDL_max(s_frameProcessMax[0], s_frameProcessMax[1]);
+        nanotime_t budget = c_frameRateNano - (nanotime_t)process_max * 1000 - c_frameDelayMargin;
+
+        if(delay > budget)
+            delay = budget;
+
+        if(delay >= 1000000)
+        {
+            PGE_Delay((uint32_t)(delay / 1000000));
+            delayed = true;
+
+#ifdef USE_NEW_FRAMESKIP
+            // the delay is not a part of the frame processing
+            if(s_doUpdate <= 0)
+                s_startProcessing = getNanoTime();
+#endif
+        }
+    }
+
+    s_frameProcessStart = SDL_GetMicroTicks();
+    g_stats.frameDelay = (int)(s_frameProcessStart - start);
+
+    return delayed;
+}
+
+static void frameDelayEnd()
+{
+    uint64_t process = SDL_GetMicroTicks() - s_frameProcessStart;
+
+    if(process > s_frameProcessMax[0])
+        s_frameProcessMax[0] = process;
+
+    if(++s_frameProcessCount >= c_frameProcessWindow)
+    {
+        s_frameProcessMax[1] = s_frameProcessMax[0];
+        s_frameProcessMax[0] = 0;
+        s_frameProcessCount = 0;
+    }
+
+    g_stats.frameProcessMax = (int)SDL_max(s_frameProcessMax[0], s_frameProcessMax[1]);
+}
+
 static inline void computeFrameTime2Real_2()
 {
 #ifdef USE_NEW_FRAMESKIP
@@ -583,6 +1016,11 @@ static inline void computeFrameTime2Real_2()
     }
 
     if(!g_config.unlimited_framerate)
+        planNextFrame();
+
+    if(!g_config.unlimited_framerate && g_config.precise_pacing)
+        preciseSleep();
+    else if(!g_config.unlimited_framerate)
     {
         nanotime_t start = getNanoTime();
         nanotime_t sleepTime = getSleepTime(s_oldTime, c_frameRateNano);
@@ -633,6 +1071,8 @@ void runFrameLoop(LoopCall_t doLoopCallbackPre,
 {
     do
     {
+        bool frame_done = false;
+
         if(preTimerExtraPre)
             preTimerExtraPre();
 
@@ -646,7 +1086,16 @@ void runFrameLoop(LoopCall_t doLoopCallbackPre,
 
         if(canProcessFrameCond())
         {
+#ifdef USE_NEW_TIMER
+            frameStartJitter();
+
+            if(frameDelayStart() && XMessage::GetStatus() != XMessage::Status::replay)
+                XEvents::doEvents();
+#endif
+
             CheckActive();
+            BeginSfxBatch();
+
             if(doLoopCallbackPre)
                 doLoopCallbackPre();
 
@@ -655,16 +1104,24 @@ void runFrameLoop(LoopCall_t doLoopCallbackPre,
             if(doLoopCallbackPost)
                 doLoopCallbackPost(); // Run the loop callback
 
+            FlushSfx();
+
+#ifdef USE_NEW_TIMER
+            frameDelayEnd();
+#endif
+
             if(XMessage::GetStatus() != XMessage::Status::replay)
                 XEvents::doEvents();
 
             COMPUTE_FRAME_TIME_2_REAL();
+            frame_done = true;
 
             if(subCondition && subCondition())
                 break;
         }
 
-        if(!g_config.unlimited_framerate)
+        // the precise pacing has already waited for the next frame
+        if(!g_config.unlimited_framerate && !(frame_done && g_config.precise_pacing))
             PGE_Delay(1);
 
         if(!GameIsActive)
@@ -700,3 +1157,95 @@ void frameRenderEnd()
     }
 #endif
 }
+
+void setFrameJitterLog(const std::string &path)
+{
+#ifdef USE_NEW_TIMER
+    s_frameJitterLog = path;
+#else
+    UNUSED(path);
+#endif
+}
+
+void writeFrameJitterLog()
+{
+#ifdef USE_NEW_TIMER
+    if(s_frameJitterLog.empty())
+        return;
+
+    if(g_microStats.dump_jitter(s_frameJitterLog))
+        pLogDebug("frame_timer: frame jitter histogram written into %s", s_frameJitterLog.c_str());
+    else
+        pLogWarning("frame_timer: failed to write the frame jitter histogram into %s", s_frameJitterLog.c_str());
+#endif
+}
+
+void setFrameTraceLog(const std::string &path)
+{
+    closeFrameTraceLog();
+
+    s_frameTrace = Files::utf8_fopen(path.c_str(), "wb");
+    if(!s_frameTrace)
+    {
+        pLogWarning("frame_timer: failed to open the frame trace file %s", path.c_str());
+        return;
+    }
+
+    s_frameTraceStart = SDL_GetMicroTicks();
+    s_frameTraceBegin = 0;
+    s_frameTraceBuf = "[\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Game loop\"}}";
+}
+
+void closeFrameTraceLog()
+{
+    if(!s_frameTrace)
+        return;
+
+    s_frameTraceBuf += "\n]\n";
+    s_frameTraceWrite();
+
+    fclose(s_frameTrace);
+    s_frameTrace = nullptr;
+}
+
+void setFastForward(int render_every, int render_fps)
+{
+    s_fastForward = true;
+    s_fastForwardEvery = (render_every > 1) ? render_every : 1;
+    s_fastForwardCount = 0;
+    s_fastForwardInterval = (render_fps > 0) ? 1000000 / render_fps : 0;
+    s_fastForwardLastDraw = 0;
+
+    if(s_fastForwardInterval)
+        pLogDebug("frame_timer: fast-forward enabled, drawing %d frames per second", render_fps);
+    else
+        pLogDebug("frame_timer: fast-forward enabled, drawing every %d frame(s)", s_fastForwardEvery);
+}
+
+bool fastForwardActive()
+{
+    return s_fastForward;
+}
+
+bool fastForwardSkipFrame()
+{
+    if(!s_fastForward)
+        return false;
+
+    if(s_fastForwardInterval)
+    {
+        uint64_t now = SDL_GetMicroTicks();
+
+        if(s_fastForwardLastDraw != 0 && now - s_fastForwardLastDraw < s_fastForwardInterval)
+            return true;
+
+        s_fastForwardLastDraw = now;
+        return false;
+    }
+
+    if(++s_fastForwardCount < s_fastForwardEvery)
+        return true;
+
+    s_fastForwardCount = 0;
+    return false;
+}
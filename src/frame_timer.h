@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <string>
 
 struct MicroStats
 {
@@ -68,6 +69,7 @@ private:
 
     uint64_t m_frame_time = 0;
     uint64_t m_slow_frame_time = 0;
+    uint64_t m_frame_timer[TASK_END] = {0};
 
 public:
     uint64_t level_timer[TASK_END] = {0};
@@ -75,11 +77,48 @@ public:
     int view_total = 0;
     int view_slow_frame_time = 0;
 
+    // NEW: log-scale histograms of the time per frame of each task (and of the whole frame at TASK_END) during the level, in microseconds
+    // bin 0 counts the frames without the task, bin k > 0 counts the times in [2^(k-1), 2^k)
+    static constexpr int HIST_BINS = 24;
+
+    uint64_t level_hist[TASK_END + 1][HIST_BINS] = {{0}};
+    uint64_t level_max[TASK_END + 1] = {0};
+
+    int view_frame_p50 = 0;
+    int view_frame_p99 = 0;
+    int view_frame_max = 0;
+
+    // NEW: deviation of the frame starts from the paced time in microseconds, for the whole session (not cleared at reset())
+    static constexpr int JITTER_BINS = 11;
+    static const int jitter_bin_edges[JITTER_BINS - 1];
+
+    uint64_t jitter_hist[JITTER_BINS] = {0};
+    uint64_t jitter_frames = 0;
+    uint64_t jitter_abs_sum = 0;
+    int jitter_max = 0;
+
+    int view_jitter_avg = 0;
+    int view_jitter_max = 0;
+
+private:
+    uint64_t m_cur_jitter_sum = 0;
+    int m_cur_jitter_max = 0;
+    int m_cur_jitter_frames = 0;
+
+public:
     void reset();
     void start_task(Task task);
     void start_sleep();
     void end_frame();
 
+    void add_jitter(int deviation);
+    bool dump_jitter(const std::string &path) const;
+
+    // returns the upper bound of the percentile of the task time per frame (TASK_END for the whole frame) during the level
+    uint64_t level_percentile(int task, int percent) const;
+    // reports the percentiles of the level into the log, and resets the stats
+    void end_level(const std::string &level_name);
+
 };
 
 struct PerformanceStats_t
@@ -108,6 +147,21 @@ struct PerformanceStats_t
     int checkedPaths = 0;
     int checkedLevels = 0;
 
+    // Render queue counters of the previous frame, filled by the renderer (not cleared at reset())
+    int renderOps = 0;
+    int renderBatches = 0;
+    int renderGeometryCalls = 0;
+
+    // Frame delay of the previous frame and the processing time it's limited by, in microseconds (not cleared at reset())
+    int frameDelay = 0;
+    int frameProcessMax = 0;
+
+    // Run-ahead frames simulated in the previous frame, and the time to save, restore, and simulate them, in microseconds (not cleared at reset())
+    int runAheadFrames = 0;
+    int runAheadSave = 0;
+    int runAheadLoad = 0;
+    int runAheadRun = 0;
+
     int page = 0;
 
     // Displays title of the music OR filename
@@ -142,6 +196,25 @@ void cycleNextInc();
 void frameRenderStart();
 void frameRenderEnd();
 
+// NEW: write the frame start deviation histogram into the file at quit (set by --frame-jitter-log)
+void setFrameJitterLog(const std::string &path);
+void writeFrameJitterLog();
+
+// NEW: write the Chrome trace-event JSON of the tasks of each frame into the file (set by --frame-trace-log)
+void setFrameTraceLog(const std::string &path);
+void closeFrameTraceLog();
+
+// NEW: fast-forward mode, the game runs at the unlimited framerate and only some of its frames get drawn (set by --fast-forward)
+/**
+ * \brief Enable the fast-forward mode
+ * \param render_every Draw every Nth simulated frame
+ * \param render_fps Draw the frames at the given wall-clock rate instead (if positive)
+ */
+void setFastForward(int render_every, int render_fps);
+bool fastForwardActive();
+// returns true if the drawing of the current frame should be skipped, call once per simulated frame
+bool fastForwardSkipFrame();
+
 void runFrameLoop(LoopCall_t doLoopCallbackPre,
                   LoopCall_t doLoopCallbackPost,
                   std::function<bool ()> condition,
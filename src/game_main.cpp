@@ -75,6 +75,7 @@
 #include "sound.h"
 #include "editor.h"
 #include "editor/new_editor.h"
+#include "editor/edit_journal.h"
 #include "custom.h"
 #include "main/world_globals.h"
 #include "main/cheat_code.h"
@@ -89,6 +90,7 @@
 #include "main/game_strings.h"
 #include "main/translate.h"
 #include "main/record.h"
+#include "main/run_ahead.h"
 #include "main/asset_pack.h"
 #include "core/render.h"
 #include "core/window.h"
@@ -602,6 +604,10 @@ int GameMain(const CmdLineSetup_t &setup)
     if(!g_config.background_work && !XWindow::hasWindowInputFocus())
         SoundPauseEngine(1);
 
+    // NEW: the sound can't follow the fast-forward, mute it
+    if(fastForwardActive())
+        SoundPauseEngine(1);
+
     if(init_failure)
     {
         GameMenu = false;
@@ -680,6 +686,14 @@ int GameMain(const CmdLineSetup_t &setup)
             LevelEditor = true;
             WorldEditor = is_world;
             OpenLevel(FullFileName);
+
+            if(!setup.editJournalBench.empty() && !is_world)
+            {
+                EditJournal::benchmark(setup.editJournalBench);
+                // edit the level as it is on the disk
+                OpenLevel(FullFileName);
+            }
+
             editorScreen.ResetCursor();
             EditorBackup();
         }
@@ -817,6 +831,10 @@ int GameMain(const CmdLineSetup_t &setup)
                         nullptr,
                         nullptr);
 
+            // the editor has been left normally (not for a level test)
+            if(!TestLevel)
+                EditJournal::close();
+
             MenuMode = MENU_INTRO;
             LevelEditor = false;
             WorldEditor = false;
@@ -1565,8 +1583,11 @@ int GameMain(const CmdLineSetup_t &setup)
                 // intro events previously processed directly here
                 g_gameLoopInterrupt.process_intro_events = true;
 
+                // don't mix the frames of the world map or menus into the level's stats
+                g_microStats.reset();
+
                 // MAIN GAME LOOP
-                runFrameLoop(nullptr, &GameLoop,
+                runFrameLoop(nullptr, &RunAhead::GameLoop,
                 []()->bool{return !LevelSelect && !GameMenu;},
                 []()->bool
                 {
@@ -1578,6 +1599,9 @@ int GameMain(const CmdLineSetup_t &setup)
                     return false;
                 });
 
+                // report the frame time percentiles of the level being left
+                g_microStats.end_level(FileNameFull);
+
                 // Ensure everything is clear
                 GraphicsClearScreen();
                 XEvents::doEvents();
@@ -1636,10 +1660,13 @@ int GameMain(const CmdLineSetup_t &setup)
                     SetupPlayers();
 
                     // reopen the temporary level (FullFileName)
-                    OpenLevel(FullFileName);
+                    EditorOpenTestLevel();
 
                     // reset FullFileName to point to the real level (Backup_FullFileName)
-                    Files::deleteFile(FullFileName);
+                    if(Backup_LevelData.empty())
+                        Files::deleteFile(FullFileName);
+
+                    Backup_LevelData.clear();
                     FullFileName = Backup_FullFileName;
                     // this is needed because the temporary levels are currently saved as ".lvl(x)tst"
                     if(FileNameFull.size() > 3 && FileNameFull.substr(FileNameFull.size() - 3) == "tst")
@@ -59,34 +59,26 @@ void DrawTopAnchoredBackground(int S, int Z, int A, int offset = 32, int expecte
     if(GameMenu && offsetY > 0)
         offsetY = 0;
 
-    for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-    {
-        if(offsetX + GFXBackground2[A].w <= 0)
-            continue;
-
-        int drawH = GFXBackground2[A].h;
-        int offsetY_i = offsetY;
-
-        while(offsetY_i < vScreen[Z].Height)
-        {
-            XRender::renderTextureBasic(offsetX, offsetY_i,
-                GFXBackground2[A].w, drawH, GFXBackground2[A], 0, GFXBackground2[A].h - drawH);
+    StdPicture& tx = GFXBackground2[A];
+    int tiles_w = vScreen[Z].Width - offsetX;
 
-            if(g_config.disable_background2_tiling)
-                break;
+    bool tile_v = !g_config.disable_background2_tiling;
+    if((expected_height != 0 || tile_bottom != 0) && tx.h != expected_height)
+        tile_v = false;
 
-            if(expected_height != 0 && GFXBackground2[A].h != expected_height)
-                break;
+    if(tile_v && tile_bottom == 0)
+    {
+        XRender::renderTextureTiled(offsetX, offsetY, tiles_w, vScreen[Z].Height - offsetY, tx, 0, 0, tx.w, tx.h);
+        return;
+    }
 
-            offsetY_i += drawH;
+    XRender::renderTextureTiled(offsetX, offsetY, tiles_w, tx.h, tx, 0, 0, tx.w, tx.h);
 
-            if(tile_bottom != 0)
-            {
-                if(GFXBackground2[A].h != expected_height)
-                    break;
-                drawH = tile_bottom;
-            }
-        }
+    // repeat the bottom part of the picture below
+    if(tile_v)
+    {
+        int offsetY_i = offsetY + tx.h;
+        XRender::renderTextureTiled(offsetX, offsetY_i, tiles_w, vScreen[Z].Height - offsetY_i, tx, 0, tx.h - tile_bottom, tx.w, tile_bottom);
     }
 }
 
@@ -149,85 +141,80 @@ void DrawCenterAnchoredBackground(int S, int Z, int A, int expected_height = 0,
 
     int offsetX = (camX_levelX * (4 - h_num) - Left * h_num) / 4;
 
-    for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-    {
-        if(offsetX + GFXBackground2[A].w <= 0)
-            continue;
-
-        tempLocation.Width = GFXBackground2[A].w;
-        tempLocation.Height = frameH;
+    StdPicture& tx = GFXBackground2[A];
 
-        tempLocation.X = offsetX;
-        if(sect.Height - sect.Y > CanvasH)
+    // draws a horizontally repeated row of the background (the rows are the same for every column)
+    auto drawRow = [&](int dstY, int h, int srcY, unsigned int flip)
+    {
+        if(flip == X_FLIP_NONE)
         {
-            // .Y = (-vScreenY(Z) - level(S).Y) / (level(S).Height - level(S).Y - (600 - vScreen(Z).Top)) * (GFXBackground2Height(A) / 4 - (600 - vScreen(Z).Top))
-            // .Y = -vScreenY(Z) - .Y
-            tempLocation.Y = (-camY - Eff_Top - sect.Y) * (CanvasH - Eff_ScreenH) / (sect.Height - sect.Y - Eff_ScreenH) + Eff_Top;
-            tempLocation.Y = -camY - tempLocation.Y;
-            tempLocation.Y += CanvasOffset;
+            XRender::renderTextureTiled(offsetX, dstY, vScreen[Z].Width - offsetX, h, tx, 0, srcY, tx.w, h);
+            return;
         }
-        else if(CanvasH > frameH)
+
+        for(int offsetX_i = offsetX; offsetX_i < vScreen[Z].Width; offsetX_i += tx.w)
         {
-            tempLocation.Y = sect.Y + (sect.Height - sect.Y - frameH) / 2;
+            if(offsetX_i + tx.w <= 0)
+                continue;
+
+            XRender::renderTextureScaleEx(offsetX_i, dstY,
+                tx.w, h,
+                tx,
+                0, srcY,
+                tx.w, h,
+                0, nullptr, flip);
         }
-        else
-            tempLocation.Y = sect.Height - frameH;
+    };
 
-        int bottom_Y = tempLocation.Y + frameH;
-        unsigned int flip = X_FLIP_NONE;
-        while(tempLocation.Y + tempLocation.Height > -camY)
-        {
-            // HACK: place the fourth frame in the correct location if we are missing a single line
-            if(A == 42 && GFXBackground2[A].h == expected_height - 1 && anim && SpecialFrame[3] == 3)
-            {
-                // duplicate the line
-                XRender::renderTextureScaleEx(tempLocation.X, camY + tempLocation.Y,
-                    GFXBackground2[A].w, 1,
-                    GFXBackground2[A],
-                    0, frameH * SpecialFrame[3],
-                    GFXBackground2[A].w, 1,
-                    0, nullptr, flip);
-                // draw the frame
-                XRender::renderTextureScaleEx(tempLocation.X, camY + tempLocation.Y + 1,
-                    GFXBackground2[A].w, tempLocation.Height - 1,
-                    GFXBackground2[A],
-                    0, frameH * SpecialFrame[3],
-                    GFXBackground2[A].w, tempLocation.Height - 1,
-                    0, nullptr, flip);
-            }
-            else if(anim)
-            {
-                XRender::renderTextureScaleEx(tempLocation.X, camY + tempLocation.Y,
-                    GFXBackground2[A].w, tempLocation.Height,
-                    GFXBackground2[A],
-                    0, frameH * SpecialFrame[3],
-                    GFXBackground2[A].w, tempLocation.Height,
-                    0, nullptr, flip);
-            }
-            else
-            {
-                XRender::renderTextureScaleEx(tempLocation.X, camY + tempLocation.Y,
-                    GFXBackground2[A].w, tempLocation.Height,
-                    GFXBackground2[A],
-                    0, 0,
-                    GFXBackground2[A].w, tempLocation.Height,
-                    0, nullptr, flip);
-            }
-
-            if(no_tiling)
-                break;
+    tempLocation.Width = GFXBackground2[A].w;
+    tempLocation.Height = frameH;
 
-            if(tile_top != 0)
-                tempLocation.Height = tile_top;
+    tempLocation.X = offsetX;
+    if(sect.Height - sect.Y > CanvasH)
+    {
+        // .Y = (-vScreenY(Z) - level(S).Y) / (level(S).Height - level(S).Y - (600 - vScreen(Z).Top)) * (GFXBackground2Height(A) / 4 - (600 - vScreen(Z).Top))
+        // .Y = -vScreenY(Z) - .Y
+        tempLocation.Y = (-camY - Eff_Top - sect.Y) * (CanvasH - Eff_ScreenH) / (sect.Height - sect.Y - Eff_ScreenH) + Eff_Top;
+        tempLocation.Y = -camY - tempLocation.Y;
+        tempLocation.Y += CanvasOffset;
+    }
+    else if(CanvasH > frameH)
+    {
+        tempLocation.Y = sect.Y + (sect.Height - sect.Y - frameH) / 2;
+    }
+    else
+        tempLocation.Y = sect.Height - frameH;
 
-            tempLocation.Y -= tempLocation.Height;
-            if(flip_tile)
-                flip ^= X_FLIP_VERTICAL;
+    int bottom_Y = tempLocation.Y + frameH;
+    unsigned int flip = X_FLIP_NONE;
+    while(tempLocation.Y + tempLocation.Height > -camY)
+    {
+        // HACK: place the fourth frame in the correct location if we are missing a single line
+        if(A == 42 && GFXBackground2[A].h == expected_height - 1 && anim && SpecialFrame[3] == 3)
+        {
+            // duplicate the line
+            drawRow(camY + tempLocation.Y, 1, frameH * SpecialFrame[3], flip);
+            // draw the frame
+            drawRow(camY + tempLocation.Y + 1, tempLocation.Height - 1, frameH * SpecialFrame[3], flip);
         }
+        else if(anim)
+            drawRow(camY + tempLocation.Y, tempLocation.Height, frameH * SpecialFrame[3], flip);
+        else
+            drawRow(camY + tempLocation.Y, tempLocation.Height, 0, flip);
 
         if(no_tiling)
-            continue;
+            break;
+
+        if(tile_top != 0)
+            tempLocation.Height = tile_top;
 
+        tempLocation.Y -= tempLocation.Height;
+        if(flip_tile)
+            flip ^= X_FLIP_VERTICAL;
+    }
+
+    if(!no_tiling)
+    {
         tempLocation.Y = bottom_Y;
         if(tile_bottom != 0)
             tempLocation.Height = tile_bottom;
@@ -241,32 +228,11 @@ void DrawCenterAnchoredBackground(int S, int Z, int A, int expected_height = 0,
         {
             // HACK: use the smaller frame size if we are missing a single line
             if(A == 42 && GFXBackground2[A].h == expected_height - 1 && anim && SpecialFrame[3] == 3)
-            {
-                XRender::renderTextureScaleEx(tempLocation.X, camY + tempLocation.Y,
-                    GFXBackground2[A].w, tempLocation.Height,
-                    GFXBackground2[A],
-                    0, frameH * SpecialFrame[3] + (frameH - 1) - tempLocation.Height,
-                    GFXBackground2[A].w, tempLocation.Height,
-                    0, nullptr, flip);
-            }
+                drawRow(camY + tempLocation.Y, tempLocation.Height, frameH * SpecialFrame[3] + (frameH - 1) - tempLocation.Height, flip);
             else if(anim)
-            {
-                XRender::renderTextureScaleEx(tempLocation.X, camY + tempLocation.Y,
-                    GFXBackground2[A].w, tempLocation.Height,
-                    GFXBackground2[A],
-                    0, frameH * SpecialFrame[3] + frameH - tempLocation.Height,
-                    GFXBackground2[A].w, tempLocation.Height,
-                    0, nullptr, flip);
-            }
+                drawRow(camY + tempLocation.Y, tempLocation.Height, frameH * SpecialFrame[3] + frameH - tempLocation.Height, flip);
             else
-            {
-                XRender::renderTextureScaleEx(tempLocation.X, camY + tempLocation.Y,
-                    GFXBackground2[A].w, tempLocation.Height,
-                    GFXBackground2[A],
-                    0, frameH - tempLocation.Height,
-                    GFXBackground2[A].w, tempLocation.Height,
-                    0, nullptr, flip);
-            }
+                drawRow(camY + tempLocation.Y, tempLocation.Height, frameH - tempLocation.Height, flip);
 
             tempLocation.Y += tempLocation.Height;
             if(flip_tile)
@@ -296,69 +262,41 @@ void DrawBottomAnchoredBackground(int S, int Z, int A, int offset = 0, int expec
     if(!no_bg)
         DrawBackgroundColor(A, Z, false);
 
-    int frameH = GFXBackground2[A].h;
+    StdPicture& tx = GFXBackground2[A];
+
+    int frameH = tx.h;
     if(anim)
-        frameH = GFXBackground2[A].h / 4;
+        frameH = tx.h / 4;
 
-    TinyLocation_t tempLocation;
+    int srcY = (anim) ? frameH * SpecialFrame[3] : 0;
 
-    int horiz_reps = ((sect.Width - sect.X) * h_parallax_num / 4 + screen.W) / GFXBackground2[A].w + 1;
-    for(int B = 0; B <= horiz_reps; B++)
-    {
-        tempLocation.X = sect.X + ((B * GFXBackground2[A].w) - (camX + vScreen[Z].Left + sect.X) * h_parallax_num / 4);
-        tempLocation.Y = sect.Height - frameH - offset;
+    // the whole row of the horizontal repeats, starting at the first one
+    int horiz_reps = ((sect.Width - sect.X) * h_parallax_num / 4 + screen.W) / tx.w + 1;
+    int rowX = sect.X - (camX + vScreen[Z].Left + sect.X) * h_parallax_num / 4;
+    int rowW = (horiz_reps + 1) * tx.w;
+    int bottomY = sect.Height - frameH - offset;
 
-        tempLocation.Height = frameH;
-        tempLocation.Width = GFXBackground2[A].w;
+    XRender::renderTextureTiled(camX + rowX, camY + bottomY, rowW, frameH, tx, 0, srcY, tx.w, frameH);
 
-        if(vScreenCollision(Z, tempLocation))
-        {
-            if(anim)
-            {
-                XRender::renderTextureBasic(camX + tempLocation.X, camY + tempLocation.Y,
-                    GFXBackground2[A].w, tempLocation.Height,
-                    GFXBackground2[A], 0, frameH * SpecialFrame[3]);
-            }
-            else
-            {
-                XRender::renderTextureBasic(camX + tempLocation.X, camY + tempLocation.Y,
-                    GFXBackground2[A].w, tempLocation.Height,
-                    GFXBackground2[A], 0, 0);
-            }
-        }
+    if(g_config.disable_background2_tiling)
+        return;
 
-        if(g_config.disable_background2_tiling)
-            continue;
+    if(expected_height != 0 && tx.h != expected_height)
+        return;
 
-        if(expected_height != 0 && GFXBackground2[A].h != expected_height)
-            continue;
+    if(tile_top != 0 && tx.h != expected_height)
+        return;
 
-        if(tile_top != 0 && GFXBackground2[A].h != expected_height)
-            continue;
+    int tileH = (tile_top != 0) ? tile_top : frameH;
 
-        if(tile_top != 0)
-            tempLocation.Height = tile_top;
+    // repeat upwards until both the section top and the screen top are covered
+    int coverY = SDL_min(sect.Y, -camY);
+    if(tileH <= 0 || bottomY <= coverY)
+        return;
 
-        while(tempLocation.Y > sect.Y || tempLocation.Y > -camY)
-        {
-            tempLocation.Y -= tempLocation.Height;
-            if(vScreenCollision(Z, tempLocation))
-            {
-                if(anim)
-                {
-                    XRender::renderTextureBasic(camX + tempLocation.X, camY + tempLocation.Y,
-                        GFXBackground2[A].w, tempLocation.Height,
-                        GFXBackground2[A], 0, frameH * SpecialFrame[3]);
-                }
-                else
-                {
-                    XRender::renderTextureBasic(camX + tempLocation.X, camY + tempLocation.Y,
-                        GFXBackground2[A].w, tempLocation.Height,
-                        GFXBackground2[A], 0, 0);
-                }
-            }
-        }
-    }
+    int tilesH = (bottomY - coverY + tileH - 1) / tileH * tileH;
+
+    XRender::renderTextureTiled(camX + rowX, camY + bottomY - tilesH, rowW, tilesH, tx, 0, srcY, tx.w, tileH);
 }
 
 static void DrawYTiledBackground(int off_x, int off_y, int vscreen_w, int vscreen_h, StdPicture& tx)
@@ -374,11 +312,8 @@ static void DrawYTiledBackground(int off_x, int off_y, int vscreen_w, int vscree
     // Fixed an SMBX 1.3 peculiarity -- this was previously -1 rather than force-to-even
     int stride_y = tx.h & ~1;
 
-    for(; off_y < vscreen_h; off_y += stride_y)
-    {
-        for(int off_x_i = off_x; off_x_i < vscreen_w; off_x_i += tx.w)
-            XRender::renderTextureBasic(off_x_i, off_y, tx);
-    }
+    // each row covers the last line of the previous one, so the rows can be cut to the stride
+    XRender::renderTextureTiled(off_x, off_y, vscreen_w - off_x, vscreen_h - off_y, tx, 0, 0, tx.w, stride_y);
 }
 
 void DrawBackground(int S, int Z)
@@ -720,148 +655,52 @@ void DrawBackground(int S, int Z)
         do
         {
             int offsetX = (camX_levelX * 1 - Left * 1) / 2;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 953, GFXBackground2[A].w, 47, GFXBackground2[A], 0, 953);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 953, vScreen[Z].Width - offsetX, 47, GFXBackground2[A], 0, 953, GFXBackground2[A].w, 47);
 
             offsetX = (camX_levelX * 4 - Left * 6) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 916, GFXBackground2[A].w, 37, GFXBackground2[A], 0, 916);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 916, vScreen[Z].Width - offsetX, 37, GFXBackground2[A], 0, 916, GFXBackground2[A].w, 37);
 
             offsetX = (camX_levelX * 3 - Left * 7) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 849, GFXBackground2[A].w, 67, GFXBackground2[A], 0, 849);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 849, vScreen[Z].Width - offsetX, 67, GFXBackground2[A], 0, 849, GFXBackground2[A].w, 67);
 
             offsetX = (camX_levelX * 2 - Left * 8) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 815, GFXBackground2[A].w, 34, GFXBackground2[A], 0, 815);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 815, vScreen[Z].Width - offsetX, 34, GFXBackground2[A], 0, 815, GFXBackground2[A].w, 34);
 
             offsetX = (camX_levelX * 1 - Left * 9) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 709, GFXBackground2[A].w, 106, GFXBackground2[A], 0, 709);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 709, vScreen[Z].Width - offsetX, 106, GFXBackground2[A], 0, 709, GFXBackground2[A].w, 106);
 
             offsetX = (camX_levelX * 15 - Left * 85) / 100;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 664, GFXBackground2[A].w, 45, GFXBackground2[A], 0, 664);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 664, vScreen[Z].Width - offsetX, 45, GFXBackground2[A], 0, 664, GFXBackground2[A].w, 45);
 
             offsetX = (camX_levelX * 2 - Left * 8) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 614, GFXBackground2[A].w, 50, GFXBackground2[A], 0, 614);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 614, vScreen[Z].Width - offsetX, 50, GFXBackground2[A], 0, 614, GFXBackground2[A].w, 50);
 
             offsetX = (camX_levelX * 25 - Left * 75) / 100;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 540, GFXBackground2[A].w, 74, GFXBackground2[A], 0, 540);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 540, vScreen[Z].Width - offsetX, 74, GFXBackground2[A], 0, 540, GFXBackground2[A].w, 74);
 
             offsetX = (camX_levelX * 3 - Left * 7) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 408, GFXBackground2[A].w, 132, GFXBackground2[A], 0, 408);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 408, vScreen[Z].Width - offsetX, 132, GFXBackground2[A], 0, 408, GFXBackground2[A].w, 132);
 
             offsetX = (camX_levelX * 25 - Left * 75) / 100;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 333, GFXBackground2[A].w, 75, GFXBackground2[A], 0, 333);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 333, vScreen[Z].Width - offsetX, 75, GFXBackground2[A], 0, 333, GFXBackground2[A].w, 75);
 
             offsetX = (camX_levelX * 2 - Left * 8) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 278, GFXBackground2[A].w, 55, GFXBackground2[A], 0, 278);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 278, vScreen[Z].Width - offsetX, 55, GFXBackground2[A], 0, 278, GFXBackground2[A].w, 55);
 
             offsetX = (camX_levelX * 15 - Left * 85) / 100;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 235, GFXBackground2[A].w, 43, GFXBackground2[A], 0, 235);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 235, vScreen[Z].Width - offsetX, 43, GFXBackground2[A], 0, 235, GFXBackground2[A].w, 43);
 
             offsetX = (camX_levelX * 1 - Left * 9) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 123, GFXBackground2[A].w, 112, GFXBackground2[A], 0, 123);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 123, vScreen[Z].Width - offsetX, 112, GFXBackground2[A], 0, 123, GFXBackground2[A].w, 112);
 
             offsetX = (camX_levelX * 2 - Left * 8) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 85, GFXBackground2[A].w, 38, GFXBackground2[A], 0, 85);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 85, vScreen[Z].Width - offsetX, 38, GFXBackground2[A], 0, 85, GFXBackground2[A].w, 38);
 
             offsetX = (camX_levelX * 3 - Left * 7) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 48, GFXBackground2[A].w, 37, GFXBackground2[A], 0, 48);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 48, vScreen[Z].Width - offsetX, 37, GFXBackground2[A], 0, 48, GFXBackground2[A].w, 37);
 
             offsetX = (camX_levelX * 4 - Left * 6) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 0, GFXBackground2[A].w, 48, GFXBackground2[A], 0, 0);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 0, vScreen[Z].Width - offsetX, 48, GFXBackground2[A], 0, 0, GFXBackground2[A].w, 48);
 
             offsetY -= GFXBackground2[A].h;
 
@@ -959,85 +798,31 @@ void DrawBackground(int S, int Z)
             GFXBackground2[A].ColorLower);
 
         int offsetX = (camX_levelX * 1 - Left * 1) / 2;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 280, GFXBackground2[A].w, 450, GFXBackground2[A], 0, 280);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 280, vScreen[Z].Width - offsetX, 450, GFXBackground2[A], 0, 280, GFXBackground2[A].w, 450);
 
         offsetX = (camX_levelX * 1 - Left * 9) / 10;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 268, GFXBackground2[A].w, 12, GFXBackground2[A], 0, 268);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 268, vScreen[Z].Width - offsetX, 12, GFXBackground2[A], 0, 268, GFXBackground2[A].w, 12);
 
         offsetX = (camX_levelX * 11 - Left * 89) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 244, GFXBackground2[A].w, 24, GFXBackground2[A], 0, 244);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 244, vScreen[Z].Width - offsetX, 24, GFXBackground2[A], 0, 244, GFXBackground2[A].w, 24);
 
         offsetX = (camX_levelX * 12 - Left * 88) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 228, GFXBackground2[A].w, 16, GFXBackground2[A], 0, 228);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 228, vScreen[Z].Width - offsetX, 16, GFXBackground2[A], 0, 228, GFXBackground2[A].w, 16);
 
         offsetX = (camX_levelX * 13 - Left * 87) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 196, GFXBackground2[A].w, 32, GFXBackground2[A], 0, 196);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 196, vScreen[Z].Width - offsetX, 32, GFXBackground2[A], 0, 196, GFXBackground2[A].w, 32);
 
         offsetX = (camX_levelX * 14 - Left * 86) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 164, GFXBackground2[A].w, 32, GFXBackground2[A], 0, 164);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 164, vScreen[Z].Width - offsetX, 32, GFXBackground2[A], 0, 164, GFXBackground2[A].w, 32);
 
         offsetX = (camX_levelX * 15 - Left * 85) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 116, GFXBackground2[A].w, 48, GFXBackground2[A], 0, 116);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 116, vScreen[Z].Width - offsetX, 48, GFXBackground2[A], 0, 116, GFXBackground2[A].w, 48);
 
         offsetX = (camX_levelX * 16 - Left * 84) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 58, GFXBackground2[A].w, 58, GFXBackground2[A], 0, 58);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 58, vScreen[Z].Width - offsetX, 58, GFXBackground2[A], 0, 58, GFXBackground2[A].w, 58);
 
         offsetX = (camX_levelX * 17 - Left * 83) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 0, GFXBackground2[A].w, 58, GFXBackground2[A], 0, 0);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 0, vScreen[Z].Width - offsetX, 58, GFXBackground2[A], 0, 0, GFXBackground2[A].w, 58);
     }
 
     A = 50; // Shrooms
@@ -1070,33 +855,15 @@ void DrawBackground(int S, int Z)
             offsetY = camY + sect.Height - GFXBackground2[A].h;
 
         int offsetX = (camX_levelX - Left) / 2;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 378, GFXBackground2[A].w, 378, GFXBackground2[A], 0, 378);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 378, vScreen[Z].Width - offsetX, 378, GFXBackground2[A], 0, 378, GFXBackground2[A].w, 378);
 
         while(offsetY > -378)
         {
             offsetX = (camX_levelX * 35 - Left * 65) / 100;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY, GFXBackground2[A].w, 220, GFXBackground2[A], 0, 0);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY, vScreen[Z].Width - offsetX, 220, GFXBackground2[A], 0, 0, GFXBackground2[A].w, 220);
 
             offsetX = (camX_levelX * 4 - Left * 6) / 10;
-            for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-            {
-                if(offsetX + GFXBackground2[A].w <= 0)
-                    continue;
-
-                XRender::renderTextureBasic(offsetX, offsetY + 220, GFXBackground2[A].w, 158, GFXBackground2[A], 0, 220);
-            }
+            XRender::renderTextureTiled(offsetX, offsetY + 220, vScreen[Z].Width - offsetX, 158, GFXBackground2[A], 0, 220, GFXBackground2[A].w, 158);
 
             offsetY -= 378;
 
@@ -1144,22 +911,10 @@ void DrawBackground(int S, int Z)
             GFXBackground2[A].ColorLower);
 
         int offsetX = (camX_levelX - Left * 3) / 4;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY, GFXBackground2[A].w, 350, GFXBackground2[A], 0, 0);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY, vScreen[Z].Width - offsetX, 350, GFXBackground2[A], 0, 0, GFXBackground2[A].w, 350);
 
         offsetX = (camX_levelX - Left) / 2;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 350, GFXBackground2[A].w, GFXBackground2[A].h - 350, GFXBackground2[A], 0, 350);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 350, vScreen[Z].Width - offsetX, GFXBackground2[A].h - 350, GFXBackground2[A], 0, 350, GFXBackground2[A].w, GFXBackground2[A].h - 350);
     }
 
     A = 52; // SMB2 Desert Night
@@ -1202,85 +957,31 @@ void DrawBackground(int S, int Z)
             GFXBackground2[A].ColorLower);
 
         int offsetX = (camX_levelX * 1 - Left * 1) / 2;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 280, GFXBackground2[A].w, GFXBackground2[A].h - 280, GFXBackground2[A], 0, 280);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 280, vScreen[Z].Width - offsetX, GFXBackground2[A].h - 280, GFXBackground2[A], 0, 280, GFXBackground2[A].w, GFXBackground2[A].h - 280);
 
         offsetX = (camX_levelX * 1 - Left * 9) / 10;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 268, GFXBackground2[A].w, 12, GFXBackground2[A], 0, 268);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 268, vScreen[Z].Width - offsetX, 12, GFXBackground2[A], 0, 268, GFXBackground2[A].w, 12);
 
         offsetX = (camX_levelX * 11 - Left * 89) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 244, GFXBackground2[A].w, 24, GFXBackground2[A], 0, 244);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 244, vScreen[Z].Width - offsetX, 24, GFXBackground2[A], 0, 244, GFXBackground2[A].w, 24);
 
         offsetX = (camX_levelX * 12 - Left * 88) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 228, GFXBackground2[A].w, 16, GFXBackground2[A], 0, 228);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 228, vScreen[Z].Width - offsetX, 16, GFXBackground2[A], 0, 228, GFXBackground2[A].w, 16);
 
         offsetX = (camX_levelX * 13 - Left * 87) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 196, GFXBackground2[A].w, 32, GFXBackground2[A], 0, 196);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 196, vScreen[Z].Width - offsetX, 32, GFXBackground2[A], 0, 196, GFXBackground2[A].w, 32);
 
         offsetX = (camX_levelX * 14 - Left * 86) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 164, GFXBackground2[A].w, 32, GFXBackground2[A], 0, 164);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 164, vScreen[Z].Width - offsetX, 32, GFXBackground2[A], 0, 164, GFXBackground2[A].w, 32);
 
         offsetX = (camX_levelX * 15 - Left * 85) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 116, GFXBackground2[A].w, 48, GFXBackground2[A], 0, 116);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 116, vScreen[Z].Width - offsetX, 48, GFXBackground2[A], 0, 116, GFXBackground2[A].w, 48);
 
         offsetX = (camX_levelX * 16 - Left * 84) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 58, GFXBackground2[A].w, 58, GFXBackground2[A], 0, 58);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 58, vScreen[Z].Width - offsetX, 58, GFXBackground2[A], 0, 58, GFXBackground2[A].w, 58);
 
         offsetX = (camX_levelX * 17 - Left * 83) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 0, GFXBackground2[A].w, 58, GFXBackground2[A], 0, 0);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 0, vScreen[Z].Width - offsetX, 58, GFXBackground2[A], 0, 0, GFXBackground2[A].w, 58);
     }
 
     A = 53; // Cliffs
@@ -1340,40 +1041,16 @@ void DrawBackground(int S, int Z)
             GFXBackground2[A].ColorLower);
 
         int offsetX = (camX_levelX * 35 - Left * 65) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY, GFXBackground2[A].w, 100, GFXBackground2[A], 0, 0);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY, vScreen[Z].Width - offsetX, 100, GFXBackground2[A], 0, 0, GFXBackground2[A].w, 100);
 
         offsetX = (camX_levelX * 4 - Left * 6) / 10;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 100, GFXBackground2[A].w, 245, GFXBackground2[A], 0, 100);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 100, vScreen[Z].Width - offsetX, 245, GFXBackground2[A], 0, 100, GFXBackground2[A].w, 245);
 
         offsetX = (camX_levelX * 45 - Left * 55) / 100;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 345, GFXBackground2[A].w, 110, GFXBackground2[A], 0, 345);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 345, vScreen[Z].Width - offsetX, 110, GFXBackground2[A], 0, 345, GFXBackground2[A].w, 110);
 
         offsetX = (camX_levelX * 5 - Left * 5) / 10;
-        for(; offsetX < vScreen[Z].Width; offsetX += GFXBackground2[A].w)
-        {
-            if(offsetX + GFXBackground2[A].w <= 0)
-                continue;
-
-            XRender::renderTextureBasic(offsetX, offsetY + 455, GFXBackground2[A].w, GFXBackground2[A].h - 455, GFXBackground2[A], 0, 455);
-        }
+        XRender::renderTextureTiled(offsetX, offsetY + 455, vScreen[Z].Width - offsetX, GFXBackground2[A].h - 455, GFXBackground2[A], 0, 455, GFXBackground2[A].w, GFXBackground2[A].h - 455);
     }
 
     A = 57; // Warehouse
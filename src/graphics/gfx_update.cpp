@@ -65,6 +65,8 @@
 #include "graphics/gfx_special_frames.h"
 #include "graphics/gfx_camera.h"
 #include "graphics/gfx_keyhole.h"
+#include "graphics/gfx_update.h"
+#include "main/run_ahead.h"
 
 #ifdef THEXTECH_BUILD_GL_MODERN
 #    include "core/opengl/gl_program_bank.h"
@@ -187,6 +189,59 @@ static inline int s_round2int(num_t d)
     return num_t::floor(d + 0.5_n);
 }
 
+// merges the runs of identical tiles that are adjacent both onscreen and in the draw order into single tiled draws
+struct TileRun_t
+{
+    StdPicture* tx = nullptr;
+    int x = 0, y = 0, w = 0, h = 0;
+    int tile_w = 0, tile_h = 0;
+    int src_y = 0;
+    XTColor color;
+
+    inline void flush()
+    {
+        if(!tx)
+            return;
+
+        if(w == tile_w && h == tile_h)
+            XRender::renderTextureBasic(x, y, w, h, *tx, 0, src_y, color);
+        else
+            XRender::renderTextureTiled(x, y, w, h, *tx, 0, src_y, tile_w, tile_h, color);
+
+        tx = nullptr;
+    }
+
+    inline void add(int sX, int sY, int sW, int sH, StdPicture& t, int srcY, XTColor c = XTColor())
+    {
+        if(tx == &t && src_y == srcY && tile_w == sW && tile_h == sH && color == c)
+        {
+            // right below a single column run
+            if(w == sW && sX == x && sY == y + h)
+            {
+                h += sH;
+                return;
+            }
+
+            // right after a single row run
+            if(h == sH && sY == y && sX == x + w)
+            {
+                w += sW;
+                return;
+            }
+        }
+
+        flush();
+
+        tx = &t;
+        x = sX;
+        y = sY;
+        w = tile_w = sW;
+        h = tile_h = sH;
+        src_y = srcY;
+        color = c;
+    }
+};
+
 void doShakeScreen(int force, int type)
 {
     for(auto& shake : s_shakeScreen)
@@ -1078,6 +1133,56 @@ static std::vector<NPCRef_t> s_NoReset_NPCs_LastFrame;
 // shared between the NPC screen logic functions, always reset to 0 between frames
 static std::bitset<maxNPCs> s_NPC_present;
 
+// the graphics logic state that persists between frames, saved by the run-ahead mode
+struct GraphicsLogicState_t
+{
+    NPC_Draw_Queue_t draw_queue[maxLocalPlayers];
+    uint8_t intro_count = 0;
+    int16_t intro[NPC_intro_count_MAX];
+    int8_t intro_frame[NPC_intro_count_MAX];
+    std::array<ScreenShake_t, c_vScreenCount_visible + 1> shake;
+    std::array<bool, c_vScreenCount_visible + 1> forced_shake;
+    std::vector<NPCRef_t> NoReset_NPCs_LastFrame;
+};
+
+static GraphicsLogicState_t s_savedLogicState;
+
+void SaveGraphicsLogicState()
+{
+    GraphicsLogicState_t& s = s_savedLogicState;
+
+    for(int i = 0; i < maxLocalPlayers; i++)
+        s.draw_queue[i] = NPC_Draw_Queue[i];
+
+    s.intro_count = NPC_intro_count;
+    std::copy(NPC_intro, NPC_intro + NPC_intro_count, s.intro);
+    std::copy(NPC_intro_frame, NPC_intro_frame + NPC_intro_count, s.intro_frame);
+
+    s.shake = s_shakeScreen;
+    s.forced_shake = s_forcedShakeScreen;
+    s.NoReset_NPCs_LastFrame = s_NoReset_NPCs_LastFrame;
+}
+
+void LoadGraphicsLogicState()
+{
+    const GraphicsLogicState_t& s = s_savedLogicState;
+
+    for(int i = 0; i < maxLocalPlayers; i++)
+        NPC_Draw_Queue[i] = s.draw_queue[i];
+
+    NPC_intro_count = s.intro_count;
+    std::copy(s.intro, s.intro + s.intro_count, NPC_intro);
+    std::copy(s.intro_frame, s.intro_frame + s.intro_count, NPC_intro_frame);
+
+    s_shakeScreen = s.shake;
+    s_forcedShakeScreen = s.forced_shake;
+    s_NoReset_NPCs_LastFrame = s.NoReset_NPCs_LastFrame;
+
+    // the cached draw lists may hold the objects of the discarded frames
+    invalidateDrawBlocks();
+    invalidateDrawBGOs();
+}
+
 // does the classic ("onscreen") NPC activation / reset logic for vScreen Z, directly based on the many NPC loops of the original game
 void ClassicNPCScreenLogic(int Z, int numScreens, bool fill_draw_queue, NPC_Draw_Queue_t& NPC_Draw_Queue_p)
 {
@@ -1687,11 +1792,14 @@ void UpdateGraphics(bool skipRepaint)
         Do_FrameSkip = true;
 #endif
 
-    // frame skip code
-    cycleNextInc();
+    // frame skip code (the hidden frames of the run-ahead mode follow the real frame)
+    if(!RunAhead::hiddenFrame())
+    {
+        cycleNextInc();
 
-    if(g_config.enable_frameskip && !TakeScreen && frameSkipNeeded())
-        Do_FrameSkip = true;
+        if(g_config.enable_frameskip && !TakeScreen && frameSkipNeeded())
+            Do_FrameSkip = true;
+    }
 
 #ifdef __16M__
     if(!XRender::ready_for_frame())
@@ -1705,6 +1813,10 @@ void UpdateGraphics(bool skipRepaint)
     if(XMessage::GetStatus() == XMessage::Status::replay)
         Do_FrameSkip = true;
 
+    // NEW: fast-forward mode only draws some of the frames
+    if(!TakeScreen && fastForwardSkipFrame())
+        Do_FrameSkip = true;
+
     g_microStats.start_task(MicroStats::Camera);
 
     UpdateGraphicsLogic(Do_FrameSkip);
@@ -1713,6 +1825,10 @@ void UpdateGraphics(bool skipRepaint)
     if(Do_FrameSkip)
         return;
 
+    // the run-ahead mode draws the last of its hidden frames instead
+    if(RunAhead::skipDraw())
+        return;
+
     g_microStats.start_task(MicroStats::Graphics);
 
     UpdateGraphicsDraw(skipRepaint);
@@ -2266,6 +2382,8 @@ void UpdateGraphicsScreen(Screen_t& screen)
         }
         else
         {
+            TileRun_t bgoRun;
+
             // For A = 1 To MidBackground - 1 'First backgrounds
             for(; nextBackground < (int)screenBackgrounds.size() && (int)screenBackgrounds[nextBackground] < MidBackground; nextBackground++)  // First backgrounds
             {
@@ -2292,15 +2410,11 @@ void UpdateGraphicsScreen(Screen_t& screen)
                 {
                     const vbint_t bgoFrame = BackgroundFrame[bgo.Type];
                     g_stats.renderedBGOs++;
-                    XRender::renderTextureBasic(sX,
-                                          sY,
-                                          bgoGfx.w,
-                                          bgoHeight,
-                                          bgoGfx,
-                                          0,
-                                          bgoHeight * bgoFrame);
+                    bgoRun.add(sX, sY, bgoGfx.w, bgoHeight, bgoGfx, bgoHeight * bgoFrame);
                 }
             }
+
+            bgoRun.flush();
         }
 
         XRender::setDrawPlane(PLANE_LVL_SBLOCK);
@@ -2359,6 +2473,8 @@ void UpdateGraphicsScreen(Screen_t& screen)
         }
         else if(numBackground > 0)
         {
+            TileRun_t bgoRun;
+
             for(; nextBackground < (int)screenBackgrounds.size() && (int)screenBackgrounds[nextBackground] <= LastBackground; nextBackground++)  // Second backgrounds
             {
                 int A = screenBackgrounds[nextBackground];
@@ -2386,14 +2502,11 @@ void UpdateGraphicsScreen(Screen_t& screen)
                     const vbint_t bgoFrame = BackgroundFrame[bgo.Type];
 
                     g_stats.renderedBGOs++;
-                    XRender::renderTextureBasic(sX,
-                                          sY,
-                                          bgoWidth,
-                                          bgoHeight,
-                                          bgoGfx,
-                                          0, bgoHeight * bgoFrame);
+                    bgoRun.add(sX, sY, bgoWidth, bgoHeight, bgoGfx, bgoHeight * bgoFrame);
                 }
             }
+
+            bgoRun.flush();
         }
 
         for(int oBackground = (int)screenBackgrounds.size() - 1; oBackground > 0 && (int)screenBackgrounds[oBackground] > numBackground; oBackground--)  // Locked doors
@@ -2461,6 +2574,8 @@ void UpdateGraphicsScreen(Screen_t& screen)
         XRender::setDrawPlane(PLANE_LVL_BLK_NORM);
 
         // 'Non-Sizable Blocks
+        TileRun_t blockRun;
+
         for(Block_t& block : screenMainBlocks)
         {
             g_stats.checkedBlocks++;
@@ -2493,14 +2608,13 @@ void UpdateGraphicsScreen(Screen_t& screen)
                     }
 #endif
 
-                    XRender::renderTextureBasic(sX,
-                                          sY + block.ShakeOffset,
-                                          bw,
-                                          bh,
-                                          GFXBlock[block.Type],
-                                          0,
-                                          BlockFrame[block.Type] * bh,
-                                          cb);
+                    blockRun.add(sX,
+                                 sY + block.ShakeOffset,
+                                 bw,
+                                 bh,
+                                 GFXBlock[block.Type],
+                                 BlockFrame[block.Type] * bh,
+                                 cb);
                     // BlockFrame * bh was previously BlockFrame * 32
                     // This change is needed for converted conveyor blocks
                     // It may be reverted in the future
@@ -2508,6 +2622,8 @@ void UpdateGraphicsScreen(Screen_t& screen)
             }
         }
 
+        blockRun.flush();
+
         XRender::setDrawPlane(PLANE_LVL_EFF_LOW);
 
         //'effects in back
@@ -2722,6 +2838,8 @@ void UpdateGraphicsScreen(Screen_t& screen)
         }
         else
         {
+            TileRun_t bgoRun;
+
             for(; nextBackground < (int)screenBackgrounds.size() && (int)screenBackgrounds[nextBackground] <= numBackground; nextBackground++)  // Foreground objects
             {
                 int A = screenBackgrounds[nextBackground];
@@ -2747,13 +2865,11 @@ void UpdateGraphicsScreen(Screen_t& screen)
                 {
                     g_stats.renderedBGOs++;
                     const vbint_t bgoFrame = BackgroundFrame[bgo.Type];
-                    XRender::renderTextureBasic(sX, sY,
-                                                bgoGfx.w,
-                                                bgoHeight,
-                                                bgoGfx, 0,
-                                                bgoHeight * bgoFrame);
+                    bgoRun.add(sX, sY, bgoGfx.w, bgoHeight, bgoGfx, bgoHeight * bgoFrame);
                 }
             }
+
+            bgoRun.flush();
         }
 
         XRender::setDrawPlane(PLANE_LVL_NPC_FG);
@@ -2768,6 +2884,8 @@ void UpdateGraphicsScreen(Screen_t& screen)
         XRender::setDrawPlane(PLANE_LVL_BLK_HURTS);
 
         // Blocks in Front
+        TileRun_t lavaRun;
+
         for(Block_t& block : screenLavaBlocks)
         {
             g_stats.checkedBlocks++;
@@ -2792,16 +2910,17 @@ void UpdateGraphicsScreen(Screen_t& screen)
             if(sX + bw >= 0 && sY + bh >= 0 /*&& !block.Hidden*/)
             {
                 g_stats.renderedBlocks++;
-                XRender::renderTextureBasic(sX,
-                                      sY + block.ShakeOffset,
-                                      bw,
-                                      bh,
-                                      GFXBlock[block.Type],
-                                      0,
-                                      BlockFrame[block.Type] * 32);
+                lavaRun.add(sX,
+                            sY + block.ShakeOffset,
+                            bw,
+                            bh,
+                            GFXBlock[block.Type],
+                            BlockFrame[block.Type] * 32);
             }
         }
 
+        lavaRun.flush();
+
         XRender::setDrawPlane(PLANE_LVL_EFF_NORM);
 
         // effects on top
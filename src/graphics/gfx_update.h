@@ -49,4 +49,10 @@ inline void invalidateDrawBGOs()
 //! UpdateGraphics function that ONLY draws to the screen (no logic!)
 void UpdateGraphicsDraw(bool skipRepaint = false);
 
+//! saves the graphics logic state that persists between frames (NPC intro, shake, NoReset queue, draw queue)
+void SaveGraphicsLogicState();
+
+//! restores the state saved by SaveGraphicsLogicState() and drops the cached draw lists
+void LoadGraphicsLogicState();
+
 #endif // #ifdef GFX_UPDATE_H
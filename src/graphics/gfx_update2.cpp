@@ -122,6 +122,10 @@ void UpdateGraphics2(bool skipRepaint)
     if(XMessage::GetStatus() == XMessage::Status::replay)
         return;
 
+    // NEW: fast-forward mode only draws some of the frames
+    if(!TakeScreen && fastForwardSkipFrame())
+        return;
+
     XRender::setTargetTexture();
 
     frameNextInc();
@@ -42,13 +42,16 @@
 #include "blocks.h"
 #include "main/trees.h"
 #include "main/block_table.h"
+#include "main/block_type_index.h"
 #include "script/msg_preprocessor.h"
 
 #include "npc/npc_activation.h"
 #include "npc/npc_queues.h"
+#include "npc/npc_riders.h"
 #include "npc/section_overlap.h"
 #include "graphics/gfx_update.h"
 #include "main/game_loop_interrupt.h"
+#include "player/player_index.h"
 
 int numLayers = 0;
 RangeArr<Layer_t, 0, maxLayers> Layer;
@@ -833,7 +836,10 @@ static inline void s_testPlayersInSection(const Screen_t& screen, int B, bool do
         // If .Section = B Then
         // Should set this only if the warp is successful!
         if(do_warp && !g_config.modern_section_change)
+        {
             Player[C].Section = B;
+            PlayerIndex::invalidate();
+        }
 
         bool tempBool = false;
         if(Player[C].Location.X + Player[C].Location.Width >= level[B].X)
@@ -848,7 +854,10 @@ static inline void s_testPlayersInSection(const Screen_t& screen, int B, bool do
                         onscreen_plr = C;
 
                         if(do_warp)
+                        {
                             Player[C].Section = B;
+                            PlayerIndex::invalidate();
+                        }
                     }
                 }
             }
@@ -879,6 +888,7 @@ static inline void s_testPlayersInSection(const Screen_t& screen, int B, bool do
                                     Player[C].Location.Y = Player[D].Location.Y + Player[D].Location.Height - Player[C].Location.Height;
                                     Player[C].Effect = PLREFF_NO_COLLIDE;
                                     Player[C].Effect2 = D;
+                                    PlayerIndex::invalidate();
                                     break;
                                 }
                             }
@@ -1965,6 +1975,8 @@ void UpdateLayers()
 
 void syncLayersTrees_AllBlocks()
 {
+    BlockTypeIndex::invalidate();
+
     // would be nice to use a non-deallocating version here
     treeLevelCleanBlockLayers();
     invalidateDrawBlocks();
@@ -1985,6 +1997,7 @@ void syncLayersTrees_AllBlocks()
 void syncLayersTrees_Block(int block)
 {
     invalidateDrawBlocks();
+    BlockTypeIndex::update(block);
 
     for(int layer = 0; layer < numLayers; layer++)
     {
@@ -2025,6 +2038,8 @@ void syncLayers_AllNPCs()
 
     for(int npc = 1; npc <= numNPCs; npc++)
         syncLayers_NPC(npc);
+
+    NPCRiders::rebuild();
 }
 
 void syncLayers_NPC(int npc)
@@ -36,6 +36,7 @@
 #include "core/language.h"
 #include "config.h"
 #include "controls.h"
+#include "frame_timer.h"
 #include <AppPath/app_path.h>
 
 #ifdef THEXTECH_INTERPROC_SUPPORTED
@@ -429,8 +430,28 @@ int main(int argc, char**argv)
         TCLAP::SwitchArg switchTestGrabAll("a", "grab-all", "Enable ability to grab everything while level testing", false);
         TCLAP::SwitchArg switchTestShowFPS("m", "show-fps", "Show FPS counter on the screen", false);
         TCLAP::SwitchArg switchTestMaxFPS("x", "max-fps", "Run FPS as fast as possible", false);
+        TCLAP::ValueArg<std::string> frameJitterLog(std::string(), "frame-jitter-log",
+                                                    "Write the histogram of the frame start deviation into the file at quit",
+                                                    false, "",
+                                                    "path to file");
+        TCLAP::ValueArg<std::string> frameTraceLog(std::string(), "frame-trace-log",
+                                                   "Write the Chrome trace-event JSON of the tasks of each frame into the file (for Perfetto)",
+                                                   false, "",
+                                                   "path to file");
+        TCLAP::ValueArg<int> fastForward(std::string(), "fast-forward",
+                                         "Run the game as fast as possible, drawing only every Nth frame, and mute the sound",
+                                         false, 0,
+                                         "N");
+        TCLAP::ValueArg<int> fastForwardFps(std::string(), "fast-forward-fps",
+                                            "Run the game as fast as possible, drawing the frames at the given wall-clock rate, and mute the sound",
+                                            false, 0,
+                                            "frames per second");
         TCLAP::SwitchArg switchTestMagicHand("k", "magic-hand", "Enable magic hand functionality while level test running", false);
         TCLAP::SwitchArg switchTestEditor("e", "editor", "Open level in the editor", false);
+        TCLAP::ValueArg<std::string> editJournalBench(std::string(), "edit-journal-bench",
+                                                      "Replay the edit journal on the level opened in the editor and log the timings",
+                                                      false, "",
+                                                      "path to file");
 #ifdef THEXTECH_INTERPROC_SUPPORTED
         TCLAP::SwitchArg switchTestInterprocess("i", "interprocessing", "Enable an interprocessing mode with Editor", false);
         TCLAP::SwitchArg switchPrintCapabilities(std::string(), "capabilities", "Print the JSON string of this build's capabilities", false);
@@ -515,8 +536,13 @@ int main(int argc, char**argv)
         cmd.add(&switchTestGrabAll);
         cmd.add(&switchTestShowFPS);
         cmd.add(&switchTestMaxFPS);
+        cmd.add(&frameJitterLog);
+        cmd.add(&frameTraceLog);
+        cmd.add(&fastForward);
+        cmd.add(&fastForwardFps);
         cmd.add(&switchTestMagicHand);
         cmd.add(&switchTestEditor);
+        cmd.add(&editJournalBench);
 #ifdef THEXTECH_INTERPROC_SUPPORTED
         cmd.add(&switchTestInterprocess);
         cmd.add(&switchPrintCapabilities);
@@ -660,6 +686,18 @@ int main(int argc, char**argv)
         if(switchTestMaxFPS.isSet())
             g_config.unlimited_framerate = switchTestMaxFPS.getValue();
 
+        if(frameJitterLog.isSet())
+            setFrameJitterLog(frameJitterLog.getValue());
+
+        if(frameTraceLog.isSet() && !frameTraceLog.getValue().empty())
+            setFrameTraceLog(frameTraceLog.getValue());
+
+        if((fastForward.isSet() && fastForward.getValue() > 0) || (fastForwardFps.isSet() && fastForwardFps.getValue() > 0))
+        {
+            setFastForward(fastForward.getValue(), fastForwardFps.getValue());
+            g_config.unlimited_framerate = true;
+        }
+
         if(switchDisplayControls.isSet())
             g_config.show_controllers = switchDisplayControls.getValue();
 
@@ -765,6 +803,7 @@ int main(int argc, char**argv)
         setup.testGrabAll = switchTestGrabAll.getValue();
         setup.testMagicHand = switchTestMagicHand.getValue();
         setup.testEditor = switchTestEditor.getValue();
+        setup.editJournalBench = editJournalBench.getValue();
         setup.testSave = saveSlot.getValue();
 
         if(startWarp.isSet() && startWarp.getValue() > 0 && startWarp.getValue() < maxWarps)
@@ -846,6 +885,9 @@ int main(int argc, char**argv)
 
     int ret = GameMain(setup);
 
+    writeFrameJitterLog();
+    closeFrameTraceLog();
+
 #ifdef ENABLE_XTECH_LUA
     if(!xtech_lua_quit())
         ret = 1;
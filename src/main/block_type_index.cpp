@@ -0,0 +1,176 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+
+#include "main/block_type_index.h"
+
+namespace BlockTypeIndex
+{
+
+static bool s_valid = false;
+
+// blocks listed under each type
+static std::array<std::vector<vbint_t>, maxBlockType + 1> s_lists;
+
+// type each block is listed under (or -1), and its position in the list
+static std::array<int16_t, maxBlocks + 1> s_type;
+static std::array<vbint_t, maxBlocks + 1> s_pos;
+
+// last block index covered by the index, the temporary blocks are past it
+static int s_top = 0;
+
+// blocks collected by the bulk operations
+static std::vector<vbint_t> s_scratch;
+
+static inline bool s_inRange(int type)
+{
+    return type >= 0 && type <= maxBlockType;
+}
+
+static void s_unlist(int A)
+{
+    int type = s_type[A];
+
+    if(type < 0)
+        return;
+
+    auto &list = s_lists[type];
+    vbint_t moved = list.back();
+
+    list[s_pos[A]] = moved;
+    s_pos[moved] = s_pos[A];
+    list.pop_back();
+
+    s_type[A] = -1;
+}
+
+static void s_list(int A, int type)
+{
+    auto &list = s_lists[type];
+
+    s_type[A] = (int16_t)type;
+    s_pos[A] = (vbint_t)list.size();
+    list.push_back((vbint_t)A);
+}
+
+static void s_build()
+{
+    for(auto &list : s_lists)
+        list.clear();
+
+    s_type.fill(-1);
+
+    for(int A = 1; A <= numBlock; A++)
+    {
+        if(s_inRange(Block[A].Type))
+            s_list(A, Block[A].Type);
+    }
+
+    s_top = numBlock;
+    s_valid = true;
+}
+
+void invalidate()
+{
+    s_valid = false;
+}
+
+void update(int A)
+{
+    if(!s_valid || A <= 0 || A > maxBlocks)
+        return;
+
+    if(A > numBlock)
+    {
+        s_unlist(A);
+
+        if(s_top > numBlock)
+            s_top = numBlock;
+
+        return;
+    }
+
+    int type = Block[A].Type;
+
+    if(!s_inRange(type))
+        type = -1;
+
+    if(type != s_type[A])
+    {
+        s_unlist(A);
+
+        if(type >= 0)
+            s_list(A, type);
+    }
+
+    if(s_top < A)
+        s_top = A;
+}
+
+void range(int type, const vbint_t*& first, const vbint_t*& last, int& top)
+{
+    if(!s_valid)
+        s_build();
+
+    if(!s_inRange(type))
+    {
+        first = last = nullptr;
+        top = 0;
+        return;
+    }
+
+    const auto &list = s_lists[type];
+    first = list.data();
+    last = list.data() + list.size();
+    top = (s_top < numBlock) ? s_top : numBlock;
+}
+
+void setAll(int type1, int type2)
+{
+    s_scratch.clear();
+    for_each(type1, [](int A) { s_scratch.push_back((vbint_t)A); });
+
+    for(vbint_t A : s_scratch)
+    {
+        Block[A].Type = type2;
+        update(A);
+    }
+}
+
+void swapAll(int type1, int type2)
+{
+    s_scratch.clear();
+    for_each(type1, [](int A) { s_scratch.push_back((vbint_t)A); });
+
+    size_t num_type1 = s_scratch.size();
+
+    if(type2 != type1)
+        for_each(type2, [](int A) { s_scratch.push_back((vbint_t)A); });
+
+    for(size_t i = 0; i < s_scratch.size(); i++)
+    {
+        vbint_t A = s_scratch[i];
+        Block[A].Type = (i < num_type1) ? type2 : type1;
+        update(A);
+    }
+}
+
+} // namespace BlockTypeIndex
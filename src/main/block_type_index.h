@@ -0,0 +1,91 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef BLOCK_TYPE_INDEX_H
+#define BLOCK_TYPE_INDEX_H
+
+/*
+ * Index of the blocks by type, to avoid scanning the whole block array to
+ * find the blocks of a given type (switch blocks, conveyors, Autocode bulk
+ * operations).
+ *
+ * The index follows the block array through syncLayersTrees_Block(), which
+ * is called whenever a block is created, moved or removed, and through
+ * update(), which must be called after changing the Type of a block.
+ * syncLayersTrees_AllBlocks() drops the index, and it gets rebuilt at the
+ * next query.
+ *
+ * The temporary NPC and vehicle blocks appended by UpdateNPCs() aren't
+ * synced, so the blocks past the last synced one are always scanned.
+ */
+
+#include <vector>
+
+#include "globals.h"
+
+namespace BlockTypeIndex
+{
+
+// drop the index, it will be rebuilt at the next query
+void invalidate();
+
+// sync the index entry of the block, call after changing its Type
+void update(int A);
+
+// returns the range of blocks listed under the type (rebuilds the index if needed), and the last listed block index
+void range(int type, const vbint_t*& first, const vbint_t*& last, int& top);
+
+/**
+ * \brief calls func(A) for every block of the type, in no particular order
+ *
+ * func MUST NOT change the types of the blocks or the block array
+ **/
+template<class Func>
+inline void for_each(int type, Func func)
+{
+    const vbint_t* first;
+    const vbint_t* last;
+    int top;
+    range(type, first, last, top);
+
+    for(; first != last; ++first)
+    {
+        if(*first <= numBlock && Block[*first].Type == type)
+            func((int)*first);
+    }
+
+    for(int A = top + 1; A <= numBlock; A++)
+    {
+        if(Block[A].Type == type)
+            func(A);
+    }
+}
+
+// set the type of all blocks of type1 to type2
+void setAll(int type1, int type2);
+
+// swap the types of all blocks of type1 and type2
+void swapAll(int type1, int type2);
+
+} // namespace BlockTypeIndex
+
+#endif // BLOCK_TYPE_INDEX_H
@@ -53,6 +53,7 @@
 #include "core/render.h"
 
 #include "npc/npc_queues.h"
+#include "npc/npc_riders.h"
 
 #include "main/game_info.h"
 #include "main/screen_quickreconnect.h"
@@ -713,6 +714,8 @@ static void superbDemo200()
             }
         }
 
+        NPCRiders::rebuild();
+
         Bomb(Player[B].Location, iRand(2) + 2);
     }
 }
@@ -741,6 +744,8 @@ static void superbDemo128()
             }
         }
 
+        NPCRiders::rebuild();
+
         Bomb(Player[B].Location, iRand(2) + 2);
     }
 }
@@ -769,6 +774,8 @@ static void superbDemo64()
             }
         }
 
+        NPCRiders::rebuild();
+
         Bomb(Player[B].Location, iRand(2) + 2);
     }
 }
@@ -798,6 +805,8 @@ static void superbDemo32()
             }
         }
 
+        NPCRiders::rebuild();
+
         Bomb(Player[B].Location, iRand(2) + 2);
     }
 }
@@ -827,6 +836,8 @@ static void superbDemo16()
             }
         }
 
+        NPCRiders::rebuild();
+
         Bomb(Player[B].Location, iRand(2) + 2);
     }
 }
@@ -856,6 +867,8 @@ static void superbDemo8()
             }
         }
 
+        NPCRiders::rebuild();
+
         Bomb(Player[B].Location, iRand(2) + 2);
     }
 }
@@ -885,6 +898,8 @@ static void superbDemo4()
             }
         }
 
+        NPCRiders::rebuild();
+
         Bomb(Player[B].Location, iRand(2) + 2);
     }
 }
@@ -925,6 +940,8 @@ static void superbDemo2()
             }
         }
 
+        NPCRiders::rebuild();
+
         Bomb(Player[B].Location, iRand(2) + 2);
     }
 }
@@ -968,6 +985,7 @@ static void onePlayer()
         Player[C] = Player[B];
         Player[C].Character = 1;
         s_heightFix(Player[C]);
+        NPCRiders::rebuild();
 
         Player[C].Immune = 1;
         Player[C].Immune2 = true;
@@ -1014,6 +1032,8 @@ static void twoPlayer()
             s_heightFix(Player[C]);
         }
 
+        NPCRiders::rebuild();
+
         Bomb(Player[B].Location, iRand(2) + 2);
     }
 }
@@ -1064,6 +1084,8 @@ static void fourPlayer()
             s_heightFix(Player[C]);
         }
 
+        NPCRiders::rebuild();
+
         Bomb(Player[B].Location, iRand(2) + 2);
     }
 }
@@ -0,0 +1,388 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include <unordered_map>
+#include <cstring>
+#include <stdint.h>
+
+#include <AppPath/app_path.h>
+#include <Logger/logger.h>
+#include <Utils/files.h>
+#include <SDL2/SDL_rwops.h>
+
+#include "globals.h"
+#include "main/menu_main.h"
+#include "main/game_info.h"
+#include "main/episode_cache.h"
+
+
+//! Bump this when the layout of the cache file changes
+static constexpr uint32_t c_cacheVersion = 2;
+static const char c_cacheMagic[4] = {'T', 'X', 'E', 'C'};
+
+struct EpisodeCacheEntry_t
+{
+    int64_t mtime = 0;
+    int64_t size = 0;
+    int64_t tr_stamp = 0;
+
+    std::string file_path;
+    std::string name;
+    uint8_t flags = 0;
+    uint8_t block_char = 0;
+    uint32_t content_hash = 0;
+
+    bool used = false;
+};
+
+enum EpisodeCacheFlags
+{
+    EPCACHE_BUGFIXES_ON  = 0x01,
+    EPCACHE_INCOMPATIBLE = 0x02,
+};
+
+static std::unordered_map<std::string, EpisodeCacheEntry_t> s_entries;
+static bool s_loaded = false;
+static bool s_dirty = false;
+
+
+static std::string s_cachePath()
+{
+    return AppPathManager::settingsRoot() + "episode-cache.bin";
+}
+
+static void s_trHash(uint64_t &h, const void *data, size_t len)
+{
+    const uint8_t *d = reinterpret_cast<const uint8_t*>(data);
+
+    for(size_t i = 0; i < len; ++i)
+    {
+        h ^= d[i];
+        h *= 0x100000001b3ULL;
+    }
+}
+
+// stamp of the translation the title would be taken from, looked up in the same order as TranslateEpisode:
+// the i18n directory catches added or removed translations, the file itself catches edits and language changes
+static int64_t s_trStamp(const std::string &path)
+{
+    int64_t mtime, size;
+    const std::string i18n = Files::dirname(path) + "/i18n";
+
+    if(!Files::fileStamp(i18n, mtime, size))
+        return 0;
+
+    uint64_t h = 0xcbf29ce484222325ULL;
+    s_trHash(h, &mtime, sizeof(mtime));
+
+    const std::string candidates[] =
+    {
+        CurrentLangDialect.empty() ? std::string() : "/translation_" + CurrentLanguage + "-" + CurrentLangDialect + ".json",
+        "/translation_" + CurrentLanguage + ".json",
+        "/translation_en-gb.json",
+        "/translation_en.json",
+    };
+
+    for(const std::string &c : candidates)
+    {
+        if(c.empty() || !Files::fileStamp(i18n + c, mtime, size))
+            continue;
+
+        s_trHash(h, c.c_str(), c.size());
+        s_trHash(h, &mtime, sizeof(mtime));
+        s_trHash(h, &size, sizeof(size));
+        break;
+    }
+
+    return (int64_t)h;
+}
+
+static void s_put32(std::vector<uint8_t> &out, uint32_t v)
+{
+    out.push_back((uint8_t)(v & 0xFF));
+    out.push_back((uint8_t)((v >> 8) & 0xFF));
+    out.push_back((uint8_t)((v >> 16) & 0xFF));
+    out.push_back((uint8_t)((v >> 24) & 0xFF));
+}
+
+static void s_put64(std::vector<uint8_t> &out, int64_t v)
+{
+    s_put32(out, (uint32_t)((uint64_t)v & 0xFFFFFFFF));
+    s_put32(out, (uint32_t)((uint64_t)v >> 32));
+}
+
+static void s_putStr(std::vector<uint8_t> &out, const std::string &s)
+{
+    s_put32(out, (uint32_t)s.size());
+    out.insert(out.end(), s.begin(), s.end());
+}
+
+struct CacheReader
+{
+    const uint8_t *cur;
+    const uint8_t *end;
+    bool ok = true;
+
+    uint8_t get8()
+    {
+        if(cur + 1 > end)
+        {
+            ok = false;
+            return 0;
+        }
+
+        return *(cur++);
+    }
+
+    uint32_t get32()
+    {
+        if(cur + 4 > end)
+        {
+            ok = false;
+            return 0;
+        }
+
+        uint32_t ret = (uint32_t)cur[0]
+            | ((uint32_t)cur[1] << 8)
+            | ((uint32_t)cur[2] << 16)
+            | ((uint32_t)cur[3] << 24);
+
+        cur += 4;
+
+        return ret;
+    }
+
+    int64_t get64()
+    {
+        uint64_t lo = get32();
+        uint64_t hi = get32();
+        return (int64_t)(lo | (hi << 32));
+    }
+
+    void getStr(std::string &s)
+    {
+        uint32_t len = get32();
+
+        if(!ok || len > (uint32_t)(end - cur))
+        {
+            ok = false;
+            s.clear();
+            return;
+        }
+
+        s.assign(reinterpret_cast<const char*>(cur), len);
+        cur += len;
+    }
+};
+
+void EpisodeCache::load()
+{
+    if(s_loaded)
+    {
+        // new scan: mark all entries unused again
+        for(auto &e : s_entries)
+            e.second.used = false;
+
+        return;
+    }
+
+    s_loaded = true;
+    s_dirty = false;
+    s_entries.clear();
+
+    Files::Data data = Files::load_file(s_cachePath());
+    if(!data.valid() || data.size() < sizeof(c_cacheMagic))
+        return;
+
+    CacheReader r;
+    r.cur = data.begin();
+    r.end = data.end();
+
+    if(memcmp(r.cur, c_cacheMagic, sizeof(c_cacheMagic)) != 0)
+        return;
+
+    r.cur += sizeof(c_cacheMagic);
+
+    if(r.get32() != c_cacheVersion)
+        return;
+
+    std::string lang, dialect;
+    r.getStr(lang);
+    r.getStr(dialect);
+    uint32_t featureLevel = r.get32();
+
+    if(!r.ok || lang != CurrentLanguage || dialect != CurrentLangDialect || featureLevel != g_gameInfo.contentFeatureLevel)
+    {
+        pLogDebug("EpisodeCache: language or content feature level changed, cache dropped");
+        s_dirty = true;
+        return;
+    }
+
+    uint32_t count = r.get32();
+    std::string path;
+
+    for(uint32_t i = 0; i < count && r.ok; i++)
+    {
+        EpisodeCacheEntry_t e;
+
+        r.getStr(path);
+        e.mtime = r.get64();
+        e.size = r.get64();
+        e.tr_stamp = r.get64();
+        r.getStr(e.file_path);
+        r.getStr(e.name);
+        e.flags = r.get8();
+        e.block_char = r.get8();
+        e.content_hash = r.get32();
+
+        if(r.ok)
+            s_entries[path] = std::move(e);
+    }
+
+    if(!r.ok)
+    {
+        pLogWarning("EpisodeCache: cache file [%s] is truncated", s_cachePath().c_str());
+        s_entries.clear();
+        s_dirty = true;
+    }
+    else
+        pLogDebug("EpisodeCache: loaded %u entries", count);
+}
+
+void EpisodeCache::save()
+{
+    if(!s_loaded)
+        return;
+
+    int64_t mtime, size;
+
+    // drop entries of removed episodes
+    for(auto it = s_entries.begin(); it != s_entries.end();)
+    {
+        if(!it->second.used && !Files::fileStamp(it->first, mtime, size))
+        {
+            it = s_entries.erase(it);
+            s_dirty = true;
+        }
+        else
+            ++it;
+    }
+
+    if(!s_dirty)
+        return;
+
+    std::vector<uint8_t> out;
+    out.reserve(64 + s_entries.size() * 128);
+
+    out.insert(out.end(), c_cacheMagic, c_cacheMagic + sizeof(c_cacheMagic));
+    s_put32(out, c_cacheVersion);
+    s_putStr(out, CurrentLanguage);
+    s_putStr(out, CurrentLangDialect);
+    s_put32(out, g_gameInfo.contentFeatureLevel);
+    s_put32(out, (uint32_t)s_entries.size());
+
+    for(const auto &it : s_entries)
+    {
+        const EpisodeCacheEntry_t &e = it.second;
+
+        s_putStr(out, it.first);
+        s_put64(out, e.mtime);
+        s_put64(out, e.size);
+        s_put64(out, e.tr_stamp);
+        s_putStr(out, e.file_path);
+        s_putStr(out, e.name);
+        out.push_back(e.flags);
+        out.push_back(e.block_char);
+        s_put32(out, e.content_hash);
+    }
+
+    SDL_RWops *f = Files::open_file(s_cachePath(), "wb");
+    if(!f)
+    {
+        pLogWarning("EpisodeCache: failed to write [%s]", s_cachePath().c_str());
+        return;
+    }
+
+    SDL_RWwrite(f, out.data(), 1, out.size());
+    SDL_RWclose(f);
+
+    s_dirty = false;
+
+    AppPathManager::syncFs();
+}
+
+bool EpisodeCache::find(const std::string &path, SelectWorld_t &out)
+{
+    auto it = s_entries.find(path);
+    if(it == s_entries.end())
+        return false;
+
+    EpisodeCacheEntry_t &e = it->second;
+
+    int64_t mtime, size;
+    if(!Files::fileStamp(path, mtime, size) || mtime != e.mtime || size != e.size || s_trStamp(path) != e.tr_stamp)
+        return false;
+
+    e.used = true;
+
+    out.WorldFilePath = e.file_path;
+    out.WorldName = e.name;
+    out.bugfixes_on_by_default = (e.flags & EPCACHE_BUGFIXES_ON);
+    out.probably_incompatible = (e.flags & EPCACHE_INCOMPATIBLE);
+
+    for(int i = 1; i <= numCharacters; i++)
+        out.blockChar[i] = (e.block_char & (1 << (i - 1)));
+
+#ifdef THEXTECH_ENABLE_SDL_NET
+    out.lz4_content_hash = e.content_hash;
+#endif
+
+    return true;
+}
+
+void EpisodeCache::store(const std::string &path, const SelectWorld_t &w)
+{
+    EpisodeCacheEntry_t e;
+
+    if(!Files::fileStamp(path, e.mtime, e.size))
+        return;
+
+    e.tr_stamp = s_trStamp(path);
+    e.file_path = w.WorldFilePath;
+    e.name = w.WorldName;
+    e.flags = (w.bugfixes_on_by_default ? EPCACHE_BUGFIXES_ON : 0)
+            | (w.probably_incompatible ? EPCACHE_INCOMPATIBLE : 0);
+
+    static_assert(numCharacters <= 8, "block_char stores one bit per character");
+    for(int i = 1; i <= numCharacters; i++)
+    {
+        if(w.blockChar[i])
+            e.block_char |= (uint8_t)(1 << (i - 1));
+    }
+
+#ifdef THEXTECH_ENABLE_SDL_NET
+    e.content_hash = w.lz4_content_hash;
+#endif
+
+    e.used = true;
+    s_entries[path] = std::move(e);
+    s_dirty = true;
+}
@@ -0,0 +1,71 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef EPISODE_CACHE_H
+#define EPISODE_CACHE_H
+
+#include <string>
+
+struct SelectWorld_t;
+
+/**
+ * \brief Persistent cache of parsed episode headers used by the episode list
+ *
+ * Entries are keyed by the path of the world file (or episode archive) together with
+ * its modification time and size, so that unchanged episodes never get reparsed.
+ * The cache must only be used from a single thread at a time.
+ */
+namespace EpisodeCache
+{
+
+/**
+ * \brief Load the cache from the settings directory (does nothing if it is already loaded)
+ *
+ * The whole cache gets dropped when the language or the content feature level differ
+ * from the ones the cache was written with.
+ */
+void load();
+
+/**
+ * \brief Write the cache back if it has been changed
+ *
+ * Entries of files that don't exist anymore are dropped.
+ */
+void save();
+
+/**
+ * \brief Find an up-to-date entry for a world file or an episode archive
+ * \param path Path to the world file or the episode archive at the real filesystem
+ * \param out Entry to fill (the editable flag is left untouched)
+ * \return true if an entry with a matching stamp was found
+ */
+bool find(const std::string &path, SelectWorld_t &out);
+
+/**
+ * \brief Store a freshly parsed entry
+ * \param path Path to the world file or the episode archive at the real filesystem
+ * \param w Parsed entry
+ */
+void store(const std::string &path, const SelectWorld_t &w);
+
+} // namespace EpisodeCache
+
+#endif // EPISODE_CACHE_H
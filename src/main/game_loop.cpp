@@ -55,6 +55,7 @@
 #include "world_globals.h"
 #include "speedrunner.h"
 #include "main/record.h"
+#include "main/run_ahead.h"
 #include "menu_main.h"
 #include "change_res.h"
 #include "message.h"
@@ -66,6 +67,7 @@
 #include "screen_prompt.h"
 #include "main/level_medals.h"
 #include "main/game_loop_interrupt.h"
+#include "player/player_index.h"
 #include "script/luna/luna.h"
 #include "game_strings.h"
 
@@ -226,23 +228,27 @@ resume_IntroEvents:
         g_gameLoopInterrupt.process_intro_events = false;
     }
 
-    g_microStats.start_task(MicroStats::Script);
-    lunaLoop();
+    // the hidden frames of the run-ahead mode reuse the controls of the real frame
+    if(!RunAhead::hiddenFrame())
+    {
+        g_microStats.start_task(MicroStats::Script);
+        lunaLoop();
 
-    g_microStats.start_task(MicroStats::Controls);
+        g_microStats.start_task(MicroStats::Controls);
 
-    if(!Controls::Update())
-    {
-        QuickReconnectScreen::g_active = true;
+        if(!Controls::Update())
+        {
+            QuickReconnectScreen::g_active = true;
 
-        if(g_config.allow_drop_add && !TestLevel && XMessage::GetStatus() == XMessage::Status::local)
-            PauseGame(PauseCode::DropAdd, 0);
-    }
+            if(g_config.allow_drop_add && !TestLevel && XMessage::GetStatus() == XMessage::Status::local)
+                PauseGame(PauseCode::DropAdd, 0);
+        }
 
-    if(QuickReconnectScreen::g_active)
-        QuickReconnectScreen::Logic();
+        if(QuickReconnectScreen::g_active)
+            QuickReconnectScreen::Logic();
 
-    Integrator::sync();
+        Integrator::sync();
+    }
 
     g_microStats.start_task(MicroStats::Layers);
 
@@ -349,8 +355,14 @@ resume_IntroEvents:
 
 resume_UpdateNPCs:
         g_microStats.start_task(MicroStats::NPCs);
-        if(UpdateNPCs())
-            return;
+        {
+            PlayerIndex::begin();
+            bool interrupted = UpdateNPCs();
+            PlayerIndex::end();
+
+            if(interrupted)
+                return;
+        }
 
         if(LevelMacro == LEVELMACRO_KEYHOLE_EXIT)
             return; // stop on key exit
@@ -441,7 +453,8 @@ resume_UpdateEvents:
         }
     }
 
-    g_microStats.end_frame();
+    if(!RunAhead::hiddenFrame())
+        g_microStats.end_frame();
 }
 
 void MessageScreen_Init()
@@ -590,6 +603,13 @@ static PauseLoopState s_pauseLoopState;
 // initializes a certain pause screen (but does not reset the game loop)
 void PauseInit(PauseCode code, int plr, void (*callback)())
 {
+    // a hidden frame only records the pause, and gets discarded by the run-ahead mode
+    if(RunAhead::hiddenFrame())
+    {
+        GamePaused = code;
+        return;
+    }
+
     // initialize pause from main game
     if(GamePaused == PauseCode::None)
     {
@@ -809,6 +829,9 @@ void PauseGame(PauseCode code, int plr)
     if(code != PauseCode::None)
         PauseInit(code, plr);
 
+    if(RunAhead::hiddenFrame())
+        return;
+
     int cur_pause_stack_depth = s_pauseLoopState.pause_stack_depth;
 
     do
@@ -53,6 +53,7 @@
 #include "main/screen_progress.h"
 #include "main/game_strings.h"
 #include "main/game_info.h"
+#include "main/parse_cache.h"
 #include "trees.h"
 #include "npc_traits.h"
 #include "npc_special_data.h"
@@ -60,6 +61,8 @@
 #include "graphics/gfx_update.h"
 #include "npc/npc_activation.h"
 #include "npc/npc_queues.h"
+#include "npc/npc_riders.h"
+#include "main/block_type_index.h"
 #include "translate_episode.h"
 #include "fontman/font_manager.h"
 
@@ -162,7 +165,7 @@ bool OpenLevel(std::string FilePath)
         return false;
     }
 
-    if(!OpenLevelData(in, FilePath))
+    if(!OpenLevelData(in, FilePath, true))
         return false;
 
     OpenLevelDataPost();
@@ -286,7 +289,7 @@ bool OpenLevel_Unpack(LevelLoad& load, LevelData& lvl);
 
 void OpenLevel_FixLayersEvents(const LevelLoad& load);
 
-bool OpenLevelData(PGE_FileFormats_misc::TextInput& input, const std::string FilePath)
+bool OpenLevelData(PGE_FileFormats_misc::TextInput& input, const std::string FilePath, bool use_cache)
 {
     if(FilePath == ".lvl" || FilePath == ".lvlx")
         return false;
@@ -344,7 +347,9 @@ bool OpenLevelData(PGE_FileFormats_misc::TextInput& input, const std::string Fil
 
 #ifdef PGEFL_CALLBACK_API
     LevelLoadCallbacks callbacks = OpenLevel_SetupCallbacks(load);
-    if(!FileFormats::OpenLevelFileT(input, callbacks))
+    bool loaded = (use_cache) ? ParseCache::openLevelFile(input, path, callbacks)
+                              : FileFormats::OpenLevelFileT(input, callbacks);
+    if(!loaded)
     {
         pLogDebug("Failed to load [%s]", FilePath.c_str());
         load.si.on_error();
@@ -1727,6 +1732,8 @@ void ClearLevel()
     invalidateDrawBlocks();
     invalidateDrawBGOs();
     NPCQueues::clear();
+    NPCRiders::clear();
+    BlockTypeIndex::invalidate();
 
     AutoUseModern = false;
 
@@ -31,7 +31,8 @@ extern void validateLevelName(std::string &out, const std::string &raw);
 
 //! loads the level
 bool OpenLevel(std::string FilePath);
-bool OpenLevelData(PGE_FileFormats_misc::TextInput& input, const std::string FilePath = std::string());
+//! NEW: use_cache=true allows to replay the parsed objects from the parse cache (only for inputs that read the file at FilePath)
+bool OpenLevelData(PGE_FileFormats_misc::TextInput& input, const std::string FilePath = std::string(), bool use_cache = false);
 void OpenLevelDataPost();
 //! Reset everything to zero
 void ClearLevel();
@@ -23,6 +23,7 @@
 
 #ifndef PGE_NO_THREADING
 #include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_cpuinfo.h>
 #endif
 
 #ifdef THEXTECH_ENABLE_SDL_NET
@@ -50,6 +51,7 @@
 #include "main/screen_options.h"
 #include "main/menu_controls.h"
 #include "main/translate_episode.h"
+#include "main/episode_cache.h"
 
 #include "speedrunner.h"
 #include "main/gameplay_timer.h"
@@ -401,14 +403,224 @@ struct WorldRoot_t
 };
 
 // helper functions used by FindWorlds() and LoadSingleWorld()
-static void s_LoadSingleWorld(const std::string& epDir, const std::string& fName, WorldData& head, TranslateEpisode& tr, bool editable);
-static void s_LoadWorldArchive(const std::string& archive);
+static bool s_LoadSingleWorld(SelectWorld_t& w, const std::string& epDir, const std::string& fName, WorldData& head, TranslateEpisode& tr, bool editable);
+static bool s_LoadWorldArchive(SelectWorld_t& w, const std::string& archive);
 static void s_FinishFindWorlds();
 
-void FindWorlds()
+enum EpisodeScanJobType
+{
+    // a world file in an episode directory
+    EPSCAN_WORLD = 0,
+    // an episode archive
+    EPSCAN_ARCHIVE,
+    // a battle level file
+    EPSCAN_BATTLE,
+};
+
+// single episode header to be parsed by FindWorlds() or FindLevels()
+struct EpisodeScanJob_t
+{
+    std::string dir;
+    std::string fName;
+    bool editable = false;
+    int type = EPSCAN_WORLD;
+
+    SelectWorld_t result;
+    bool loaded = false;
+    bool cached = false;
+};
+
+// per-thread scratch data to avoid repeated heap allocations
+struct EpisodeScanState_t
 {
     TranslateEpisode tr;
-    WorldData head;
+    WorldData worldHead;
+    LevelData levelHead;
+};
+
+struct EpisodeScanPool_t
+{
+    std::vector<EpisodeScanJob_t*> queue;
+#ifndef PGE_NO_THREADING
+    SDL_atomic_t next = {};
+#else
+    size_t next = 0;
+#endif
+};
+
+static bool s_LoadBattleLevel(SelectWorld_t& w, const std::string& root, const std::string& fName, LevelData& head, bool editable)
+{
+    std::string wPath = root + fName;
+
+    PGE_FileFormats_misc::RWopsTextInput in(Files::open_file(wPath, "r"), wPath);
+    if(!FileFormats::OpenLevelFileHeaderT(in, head))
+        return false;
+
+    w.WorldFilePath = root;
+    w.WorldFilePath += '/';
+    w.WorldFilePath += fName;
+    w.WorldName = head.LevelName;
+    if(w.WorldName.empty())
+        w.WorldName = fName;
+    w.editable = editable;
+
+    return true;
+}
+
+static void s_EpisodeScanRunJob(EpisodeScanJob_t& job, EpisodeScanState_t& st)
+{
+    switch(job.type)
+    {
+    case EPSCAN_ARCHIVE:
+        job.loaded = s_LoadWorldArchive(job.result, job.dir + job.fName);
+        break;
+    case EPSCAN_BATTLE:
+        job.loaded = s_LoadBattleLevel(job.result, job.dir, job.fName, st.levelHead, job.editable);
+        break;
+    default:
+        job.loaded = s_LoadSingleWorld(job.result, job.dir, job.fName, st.worldHead, st.tr, job.editable);
+        break;
+    }
+
+#ifndef PGE_NO_THREADING
+    if(SDL_AtomicGet(&loading))
+        SDL_AtomicAdd(&loadingProgrss, 1);
+#endif
+}
+
+// takes jobs from the pool until it runs dry; called by every worker and by the scanning thread itself
+static void s_EpisodeScanWork(EpisodeScanPool_t& pool)
+{
+    EpisodeScanState_t st;
+
+    while(true)
+    {
+#ifndef PGE_NO_THREADING
+        size_t i = (size_t)SDL_AtomicAdd(&pool.next, 1);
+#else
+        size_t i = pool.next++;
+#endif
+        if(i >= pool.queue.size())
+            break;
+
+        s_EpisodeScanRunJob(*pool.queue[i], st);
+    }
+}
+
+#ifndef PGE_NO_THREADING
+static int s_EpisodeScanWorker(void* pool)
+{
+    s_EpisodeScanWork(*reinterpret_cast<EpisodeScanPool_t*>(pool));
+    return 0;
+}
+
+static int s_EpisodeScanWorkerCount(size_t jobs)
+{
+    // the scanning thread works too, and a worker isn't worth starting for less than four headers
+    int count = SDL_GetCPUCount() - 1;
+
+    if(count > 3)
+        count = 3;
+
+    if((size_t)count > jobs / 4)
+        count = (int)(jobs / 4);
+
+    return (count < 0) ? 0 : count;
+}
+#endif
+
+/**
+ * \brief Parse the headers of all jobs: unchanged ones come from the episode cache,
+ * archive-backed ones are parsed serially, and the rest is spread over a worker pool
+ */
+static void s_EpisodeScanRun(std::vector<EpisodeScanJob_t>& jobs)
+{
+#ifndef PGE_NO_THREADING
+    if(SDL_AtomicGet(&loading))
+    {
+        SDL_AtomicSet(&loadingProgrss, 0);
+        SDL_AtomicSet(&loadingProgrssMax, (int)jobs.size());
+    }
+#endif
+
+    EpisodeScanPool_t pool;
+    std::vector<EpisodeScanJob_t*> serial;
+
+    EpisodeCache::load();
+
+    for(EpisodeScanJob_t &job : jobs)
+    {
+        job.result.editable = (job.type != EPSCAN_ARCHIVE) && job.editable;
+
+        if(EpisodeCache::find(job.dir + job.fName, job.result))
+        {
+            job.loaded = true;
+            job.cached = true;
+
+#ifndef PGE_NO_THREADING
+            if(SDL_AtomicGet(&loading))
+                SDL_AtomicAdd(&loadingProgrss, 1);
+#endif
+            continue;
+        }
+
+        // archive access goes through the single temporary mount and is not thread-safe
+        if(job.type == EPSCAN_ARCHIVE || Archives::has_prefix(job.dir))
+            serial.push_back(&job);
+        else
+            pool.queue.push_back(&job);
+    }
+
+    if(!serial.empty())
+    {
+        EpisodeScanState_t st;
+
+        for(EpisodeScanJob_t *job : serial)
+        {
+            s_EpisodeScanRunJob(*job, st);
+
+#ifdef THEXTECH_PRELOAD_LEVELS
+            if(LoadingInProcess)
+                UpdateLoad();
+#endif
+        }
+    }
+
+#ifndef PGE_NO_THREADING
+    std::vector<SDL_Thread*> workers;
+    int workerCount = s_EpisodeScanWorkerCount(pool.queue.size());
+
+    for(int i = 0; i < workerCount; i++)
+    {
+        SDL_Thread* t = SDL_CreateThread(s_EpisodeScanWorker, "EpisodeScan", &pool);
+        if(t)
+            workers.push_back(t);
+    }
+#endif
+
+    s_EpisodeScanWork(pool);
+
+#ifndef PGE_NO_THREADING
+    for(SDL_Thread* t : workers)
+        SDL_WaitThread(t, nullptr);
+#endif
+
+#ifdef THEXTECH_PRELOAD_LEVELS
+    if(LoadingInProcess)
+        UpdateLoad();
+#endif
+
+    for(EpisodeScanJob_t &job : jobs)
+    {
+        if(job.loaded && !job.cached)
+            EpisodeCache::store(job.dir + job.fName, job.result);
+    }
+
+    EpisodeCache::save();
+}
+
+void FindWorlds()
+{
     NumSelectWorld = 0;
 
     std::vector<WorldRoot_t> worldRoots =
@@ -432,26 +644,8 @@ void FindWorlds()
     SelectWorld.clear();
     SelectWorld.emplace_back(SelectWorld_t()); // Dummy entry
 
-#ifndef PGE_NO_THREADING
-    if(SDL_AtomicGet(&loading))
-    {
-        SDL_AtomicSet(&loadingProgrss, 0);
-        SDL_AtomicSet(&loadingProgrssMax, 0);
-
-        for(const auto &worldsRoot : worldRoots)
-        {
-            std::vector<std::string> dirs;
-            DirMan episodes(worldsRoot.path);
-            episodes.getListOfFolders(dirs);
-            SDL_AtomicAdd(&loadingProgrssMax, (int)dirs.size());
-            if(!Archives::has_prefix(worldsRoot.path))
-            {
-                episodes.getListOfFiles(dirs);
-                SDL_AtomicAdd(&loadingProgrssMax, (int)dirs.size());
-            }
-        }
-    }
-#endif
+    // list all world files and episode archives first, so that the progress counts single episodes
+    std::vector<EpisodeScanJob_t> jobs;
 
     for(const auto &worldsRoot : worldRoots)
     {
@@ -468,44 +662,41 @@ void FindWorlds()
             episode.getListOfFiles(files, {".wld", ".wldx"});
 
             for(std::string &fName : files)
-                s_LoadSingleWorld(epDir, fName, head, tr, worldsRoot.editable);
-
-#ifdef THEXTECH_PRELOAD_LEVELS
-            if(LoadingInProcess)
-                UpdateLoad();
-#endif
-
-#ifndef PGE_NO_THREADING
-            SDL_AtomicAdd(&loadingProgrss, 1);
-#endif
+            {
+                jobs.emplace_back();
+                jobs.back().dir = epDir;
+                jobs.back().fName = std::move(fName);
+                jobs.back().editable = worldsRoot.editable;
+            }
         }
 
         if(!Archives::has_prefix(worldsRoot.path))
         {
             episodes.getListOfFiles(dirs);
 
-            for(const auto &dir : dirs)
+            for(std::string &dir : dirs)
             {
-                s_LoadWorldArchive(worldsRoot.path + dir);
-
-#ifdef THEXTECH_PRELOAD_LEVELS
-                if(LoadingInProcess)
-                    UpdateLoad();
-#endif
-
-#ifndef PGE_NO_THREADING
-                SDL_AtomicAdd(&loadingProgrss, 1);
-#endif
+                jobs.emplace_back();
+                jobs.back().dir = worldsRoot.path;
+                jobs.back().fName = std::move(dir);
+                jobs.back().type = EPSCAN_ARCHIVE;
             }
         }
     }
 
+    s_EpisodeScanRun(jobs);
+
+    for(EpisodeScanJob_t &job : jobs)
+    {
+        if(job.loaded)
+            SelectWorld.push_back(std::move(job.result));
+    }
+
     s_FinishFindWorlds();
 }
 
-static void s_LoadSingleWorld(const std::string& epDir, const std::string& fName, WorldData& head, TranslateEpisode& tr, bool editable)
+static bool s_LoadSingleWorld(SelectWorld_t& w, const std::string& epDir, const std::string& fName, WorldData& head, TranslateEpisode& tr, bool editable)
 {
-    SelectWorld_t w;
     w.WorldFilePath = epDir + fName;
 
     PGE_FileFormats_misc::RWopsTextInput in(Files::open_file(w.WorldFilePath, "r"), w.WorldFilePath);
@@ -542,13 +733,14 @@ static void s_LoadSingleWorld(const std::string& epDir, const std::string& fName
             w.lz4_content_hash = md5::string_to_u32(w.WorldFilePath);
 #endif
 
-        SelectWorld.push_back(std::move(w));
+        return true;
     }
+
+    return false;
 }
 
-static void s_LoadWorldArchive(const std::string& archive)
+static bool s_LoadWorldArchive(SelectWorld_t& w, const std::string& archive)
 {
-    SelectWorld_t w;
     w.WorldFilePath = "@";
     w.WorldFilePath += archive;
     w.WorldFilePath += ":/";
@@ -562,7 +754,7 @@ static void s_LoadWorldArchive(const std::string& archive)
     if(w.WorldName.empty())
     {
         pLogInfo("Episode [%s] not loaded; could not parse _meta.ini", archive.c_str());
-        return;
+        return false;
     }
     w.WorldFilePath += w.WorldName;
 
@@ -572,7 +764,7 @@ static void s_LoadWorldArchive(const std::string& archive)
     if(engine != "TheXTech")
     {
         pLogInfo("Episode [%s] not loaded; for incompatible engine [%s]", archive.c_str(), engine.c_str());
-        return;
+        return false;
     }
 
     // confirm platform support
@@ -604,7 +796,7 @@ static void s_LoadWorldArchive(const std::string& archive)
     if(!platform_okay)
     {
         pLogInfo("Episode [%s] not loaded; for incompatible platform [%s]", archive.c_str(), platform.c_str());
-        return;
+        return false;
     }
 
 #ifdef THEXTECH_ENABLE_SDL_NET
@@ -665,8 +857,7 @@ static void s_LoadWorldArchive(const std::string& archive)
     }
 #endif
 
-    // store it!
-    SelectWorld.push_back(std::move(w));
+    return true;
 }
 
 static void s_FinishFindWorlds()
@@ -724,7 +915,9 @@ void LoadSingleWorld(const std::string wPath)
 
     epDir = DirMan(epDir).absolutePath() + "/";
 
-    s_LoadSingleWorld(epDir, fName, head, tr, true);
+    SelectWorld_t w;
+    if(s_LoadSingleWorld(w, epDir, fName, head, tr, true))
+        SelectWorld.push_back(std::move(w));
 
     s_FinishFindWorlds();
 }
@@ -757,55 +950,31 @@ void FindLevels()
     NumSelectBattle = 1;
     SelectBattle.emplace_back(SelectWorld_t()); // "random level" entry
     SelectBattle[1].WorldName = g_mainMenu.gameBattleRandom;
-    LevelData head;
 
-#ifndef PGE_NO_THREADING
-    if(SDL_AtomicGet(&loading))
-    {
-        SDL_AtomicSet(&loadingProgrss, 0);
-        SDL_AtomicSet(&loadingProgrssMax, 0);
-
-        for(const auto &battleRoot : battleRoots)
-        {
-            std::vector<std::string> files;
-            DirMan battleLvls(battleRoot.path);
-            battleLvls.getListOfFiles(files, {".lvl", ".lvlx"});
-            SDL_AtomicAdd(&loadingProgrssMax, (int)files.size());
-        }
-    }
-#endif
+    std::vector<EpisodeScanJob_t> jobs;
 
     for(const auto &battleRoot : battleRoots)
     {
         std::vector<std::string> files;
         DirMan battleLvls(battleRoot.path);
         battleLvls.getListOfFiles(files, {".lvl", ".lvlx"});
+
         for(std::string &fName : files)
         {
-            std::string wPath = battleRoot.path + fName;
+            jobs.emplace_back();
+            jobs.back().dir = battleRoot.path;
+            jobs.back().fName = std::move(fName);
+            jobs.back().editable = battleRoot.editable;
+            jobs.back().type = EPSCAN_BATTLE;
+        }
+    }
 
-            PGE_FileFormats_misc::RWopsTextInput in(Files::open_file(wPath, "r"), wPath);
-            if(FileFormats::OpenLevelFileHeaderT(in, head))
-            {
-                SelectWorld_t w;
-                w.WorldFilePath = battleRoot.path;
-                w.WorldFilePath += '/';
-                w.WorldFilePath += fName;
-                w.WorldName = head.LevelName;
-                if(w.WorldName.empty())
-                    w.WorldName = fName;
-                w.editable = battleRoot.editable;
-                SelectBattle.push_back(std::move(w));
+    s_EpisodeScanRun(jobs);
 
-#ifdef THEXTECH_PRELOAD_LEVELS
-                if(LoadingInProcess)
-                    UpdateLoad();
-#endif
-            }
-#ifndef PGE_NO_THREADING
-            SDL_AtomicAdd(&loadingProgrss, 1);
-#endif
-        }
+    for(EpisodeScanJob_t &job : jobs)
+    {
+        if(job.loaded)
+            SelectBattle.push_back(std::move(job.result));
     }
 
     NumSelectBattle = ((int)SelectBattle.size() - 1);
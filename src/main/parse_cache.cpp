@@ -0,0 +1,898 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "main/parse_cache.h"
+
+#ifdef PGEFL_CALLBACK_API
+
+#include <vector>
+#include <cstring>
+#include <stdint.h>
+#include <type_traits>
+#include <stdexcept>
+
+#include <AppPath/app_path.h>
+#include <DirManager/dirman.h>
+#include <Logger/logger.h>
+#include <Utils/files.h>
+#include <SDL2/SDL_rwops.h>
+#include <fmt_format_ne.h>
+
+
+//! Bump this when the set of the cached fields or the layout of the cache files change
+static constexpr uint32_t c_cacheVersion = 1;
+static const char c_levelMagic[4] = {'T', 'X', 'L', 'C'};
+static const char c_worldMagic[4] = {'T', 'X', 'W', 'C'};
+
+enum LevelCacheRecord
+{
+    LC_HEAD = 1,
+    LC_SECTION,
+    LC_STARTPOINT,
+    LC_BLOCK,
+    LC_BGO,
+    LC_NPC,
+    LC_WARP,
+    LC_PHYS,
+    LC_LAYER,
+    LC_EVENT,
+    LC_END
+};
+
+enum WorldCacheRecord
+{
+    WC_HEAD = 1,
+    WC_TILE,
+    WC_SCENE,
+    WC_PATH,
+    WC_LEVEL,
+    WC_MUSIC,
+    WC_AREARECT,
+    WC_END
+};
+
+
+static uint64_t s_hashData(const uint8_t *data, size_t size)
+{
+    uint64_t h = 14695981039346656037ull;
+
+    for(size_t i = 0; i < size; i++)
+    {
+        h ^= data[i];
+        h *= 1099511628211ull;
+    }
+
+    return h;
+}
+
+static std::string s_cacheDir()
+{
+    return AppPathManager::settingsRoot() + "parse-cache";
+}
+
+static std::string s_cachePath(const std::string &path, const char *suffix)
+{
+    uint64_t h = s_hashData(reinterpret_cast<const uint8_t*>(path.data()), path.size());
+    return s_cacheDir() + fmt::format_ne("/{0:016x}", h) + suffix;
+}
+
+
+struct CacheWriter
+{
+    std::vector<uint8_t> out;
+
+    void put32(uint32_t v)
+    {
+        out.push_back((uint8_t)(v & 0xFF));
+        out.push_back((uint8_t)((v >> 8) & 0xFF));
+        out.push_back((uint8_t)((v >> 16) & 0xFF));
+        out.push_back((uint8_t)((v >> 24) & 0xFF));
+    }
+
+    void put64(uint64_t v)
+    {
+        put32((uint32_t)(v & 0xFFFFFFFF));
+        put32((uint32_t)(v >> 32));
+    }
+
+    template<class T>
+    typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    operator()(T &v)
+    {
+        put64((uint64_t)(int64_t)v);
+    }
+
+    template<class T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type
+    operator()(T &v)
+    {
+        double d = (double)v;
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(bits));
+        put64(bits);
+    }
+
+    void operator()(std::string &s)
+    {
+        put32((uint32_t)s.size());
+        out.insert(out.end(), s.begin(), s.end());
+    }
+
+    template<class T>
+    void operator()(std::vector<T> &v);
+
+    void operator()(std::vector<bool> &v)
+    {
+        put32((uint32_t)v.size());
+
+        for(bool e : v)
+            out.push_back(e ? 1 : 0);
+    }
+
+    void operator()(LevelEvent_Sets &s);
+};
+
+struct CacheReader
+{
+    const uint8_t *cur;
+    const uint8_t *end;
+    bool ok = true;
+
+    uint8_t get8()
+    {
+        if(cur + 1 > end)
+        {
+            ok = false;
+            return 0;
+        }
+
+        return *(cur++);
+    }
+
+    uint32_t get32()
+    {
+        if(cur + 4 > end)
+        {
+            ok = false;
+            return 0;
+        }
+
+        uint32_t ret = (uint32_t)cur[0]
+            | ((uint32_t)cur[1] << 8)
+            | ((uint32_t)cur[2] << 16)
+            | ((uint32_t)cur[3] << 24);
+
+        cur += 4;
+
+        return ret;
+    }
+
+    uint64_t get64()
+    {
+        uint64_t lo = get32();
+        uint64_t hi = get32();
+        return lo | (hi << 32);
+    }
+
+    template<class T>
+    typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    operator()(T &v)
+    {
+        v = static_cast<T>((int64_t)get64());
+    }
+
+    template<class T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type
+    operator()(T &v)
+    {
+        uint64_t bits = get64();
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        v = (T)d;
+    }
+
+    void operator()(std::string &s)
+    {
+        uint32_t len = get32();
+
+        if(!ok || len > (uint32_t)(end - cur))
+        {
+            ok = false;
+            s.clear();
+            return;
+        }
+
+        s.assign(reinterpret_cast<const char*>(cur), len);
+        cur += len;
+    }
+
+    template<class T>
+    void operator()(std::vector<T> &v);
+
+    void operator()(std::vector<bool> &v)
+    {
+        uint32_t count = get32();
+
+        if(!ok || count > (uint32_t)(end - cur))
+        {
+            ok = false;
+            v.clear();
+            return;
+        }
+
+        v.resize(count);
+
+        for(uint32_t i = 0; i < count; i++)
+            v[i] = (get8() != 0);
+    }
+
+    void operator()(LevelEvent_Sets &s);
+};
+
+template<class T>
+void CacheWriter::operator()(std::vector<T> &v)
+{
+    put32((uint32_t)v.size());
+
+    for(T &e : v)
+        (*this)(e);
+}
+
+template<class T>
+void CacheReader::operator()(std::vector<T> &v)
+{
+    uint32_t count = get32();
+
+    // every element takes at least 4 bytes
+    if(!ok || count > (uint32_t)(end - cur) / 4)
+    {
+        ok = false;
+        v.clear();
+        return;
+    }
+
+    v.resize(count);
+
+    for(T &e : v)
+        (*this)(e);
+}
+
+
+// the fields read by the loading callbacks of level_file.cpp and level_save_info.cpp
+template<class IO>
+static void s_fields(IO &io, LevelHead &h)
+{
+    io(h.LevelName);
+    io(h.RecentFormat);
+    io(h.engineFeatureLevel);
+    io(h.custom_params);
+    io(h.stars);
+}
+
+template<class IO>
+static void s_fields(IO &io, LevelSection &s)
+{
+    io(s.id);
+    io(s.size_left);
+    io(s.size_top);
+    io(s.size_bottom);
+    io(s.size_right);
+    io(s.music_id);
+    io(s.wrap_h);
+    io(s.wrap_v);
+    io(s.OffScreenEn);
+    io(s.background);
+    io(s.lock_left_scroll);
+    io(s.underwater);
+    io(s.music_file);
+    io(s.custom_params);
+}
+
+template<class IO>
+static void s_fields(IO &io, PlayerPoint &p)
+{
+    io(p.x);
+    io(p.y);
+    io(p.w);
+    io(p.h);
+    io(p.direction);
+}
+
+template<class IO>
+static void s_fields(IO &io, LevelBlock &b)
+{
+    io(b.id);
+    io(b.x);
+    io(b.y);
+    io(b.w);
+    io(b.h);
+    io(b.npc_id);
+    io(b.special_data);
+    io(b.invisible);
+    io(b.slippery);
+    io(b.layer);
+    io(b.event_destroy);
+    io(b.event_hit);
+    io(b.event_emptylayer);
+}
+
+template<class IO>
+static void s_fields(IO &io, LevelBGO &b)
+{
+    io(b.id);
+    io(b.x);
+    io(b.y);
+    io(b.layer);
+    io(b.z_mode);
+    io(b.z_offset);
+}
+
+template<class IO>
+static void s_fields(IO &io, LevelNPC &n)
+{
+    io(n.id);
+    io(n.x);
+    io(n.y);
+    io(n.direct);
+    io(n.contents);
+    io(n.special_data);
+    io(n.generator);
+    io(n.generator_direct);
+    io(n.generator_type);
+    io(n.generator_period);
+    io(n.msg);
+    io(n.friendly);
+    io(n.nomove);
+    io(n.wings_type);
+    io(n.is_boss);
+    io(n.layer);
+    io(n.event_activate);
+    io(n.event_die);
+    io(n.event_talk);
+    io(n.event_emptylayer);
+    io(n.attach_layer);
+}
+
+template<class IO>
+static void s_fields(IO &io, LevelDoor &w)
+{
+    io(w.ix);
+    io(w.iy);
+    io(w.ox);
+    io(w.oy);
+    io(w.lvl_i);
+    io(w.lvl_o);
+    io(w.idirect);
+    io(w.odirect);
+    io(w.type);
+    io(w.lname);
+    io(w.warpto);
+    io(w.world_x);
+    io(w.world_y);
+    io(w.stars);
+    io(w.layer);
+    io(w.unknown);
+    io(w.novehicles);
+    io(w.allownpc);
+    io(w.locked);
+    io(w.two_way);
+    io(w.cannon_exit);
+    io(w.cannon_exit_speed);
+    io(w.event_enter);
+    io(w.event_exit);
+    io(w.stars_msg);
+    io(w.star_num_hide);
+    io(w.hide_entering_scene);
+    io(w.stood_state_required);
+    io(w.transition_effect);
+}
+
+template<class IO>
+static void s_fields(IO &io, LevelPhysEnv &w)
+{
+    io(w.x);
+    io(w.y);
+    io(w.w);
+    io(w.h);
+    io(w.env_type);
+    io(w.layer);
+}
+
+template<class IO>
+static void s_fields(IO &io, LevelLayer &l)
+{
+    io(l.name);
+    io(l.hidden);
+}
+
+template<class IO>
+static void s_fields(IO &io, LevelEvent_Sets &s)
+{
+    io(s.id);
+    io(s.music_id);
+    io(s.background_id);
+    io(s.music_file);
+    io(s.position_left);
+    io(s.position_top);
+    io(s.position_bottom);
+    io(s.position_right);
+    io(s.autoscrol);
+    io(s.autoscroll_style);
+    io(s.autoscrol_x);
+    io(s.autoscrol_y);
+}
+
+template<class IO>
+static void s_fields(IO &io, LevelSMBX64Event &e)
+{
+    io(e.name);
+    io(e.msg);
+    io(e.sound_id);
+    io(e.end_game);
+    io(e.layers_hide);
+    io(e.layers_show);
+    io(e.layers_toggle);
+    io(e.sets);
+    io(e.trigger);
+    io(e.trigger_timer);
+    io(e.nosmoke);
+    io(e.ctrl_altjump);
+    io(e.ctrl_altrun);
+    io(e.ctrl_down);
+    io(e.ctrl_drop);
+    io(e.ctrl_jump);
+    io(e.ctrl_left);
+    io(e.ctrl_right);
+    io(e.ctrl_run);
+    io(e.ctrl_start);
+    io(e.ctrl_up);
+    io(e.autostart);
+    io(e.movelayer);
+    io(e.layer_speed_x);
+    io(e.layer_speed_y);
+    io(e.move_camera_x);
+    io(e.move_camera_y);
+    io(e.scroll_section);
+}
+
+// the fields read by the loading callbacks of world_file.cpp
+template<class IO>
+static void s_fields(IO &io, WorldHead &h)
+{
+    io(h.RecentFormat);
+    io(h.RecentFormatVersion);
+    io(h.engineFeatureLevel);
+    io(h.EpisodeTitle);
+    io(h.nocharacter);
+    io(h.IntroLevel_file);
+    io(h.HubStyledWorld);
+    io(h.restartlevel);
+    io(h.starsShowPolicy);
+    io(h.stars);
+    io(h.custom_params);
+    io(h.authors);
+}
+
+template<class IO>
+static void s_fields(IO &io, WorldTerrainTile &t)
+{
+    io(t.id);
+    io(t.x);
+    io(t.y);
+}
+
+template<class IO>
+static void s_fields(IO &io, WorldScenery &s)
+{
+    io(s.id);
+    io(s.x);
+    io(s.y);
+}
+
+template<class IO>
+static void s_fields(IO &io, WorldPathTile &p)
+{
+    io(p.id);
+    io(p.x);
+    io(p.y);
+}
+
+template<class IO>
+static void s_fields(IO &io, WorldLevelTile &l)
+{
+    io(l.id);
+    io(l.x);
+    io(l.y);
+    io(l.lvlfile);
+    io(l.title);
+    io(l.top_exit);
+    io(l.left_exit);
+    io(l.bottom_exit);
+    io(l.right_exit);
+    io(l.entertowarp);
+    io(l.alwaysVisible);
+    io(l.pathbg);
+    io(l.gamestart);
+    io(l.gotox);
+    io(l.gotoy);
+    io(l.bigpathbg);
+    io(l.starsShowPolicy);
+}
+
+template<class IO>
+static void s_fields(IO &io, WorldMusicBox &m)
+{
+    io(m.id);
+    io(m.x);
+    io(m.y);
+    io(m.music_file);
+}
+
+template<class IO>
+static void s_fields(IO &io, WorldAreaRect &a)
+{
+    io(a.flags);
+    io(a.x);
+    io(a.y);
+    io(a.w);
+    io(a.h);
+}
+
+void CacheWriter::operator()(LevelEvent_Sets &s)
+{
+    s_fields(*this, s);
+}
+
+void CacheReader::operator()(LevelEvent_Sets &s)
+{
+    s_fields(*this, s);
+}
+
+
+static void s_putHeader(CacheWriter &w, const char *magic, const std::string &path, uint64_t size, uint64_t hash)
+{
+    w.out.insert(w.out.end(), magic, magic + 4);
+    w.put32(c_cacheVersion);
+    w(const_cast<std::string&>(path));
+    w.put64(size);
+    w.put64(hash);
+}
+
+static bool s_checkHeader(CacheReader &r, const char *magic, const std::string &path, uint64_t size, uint64_t hash)
+{
+    if(r.end - r.cur < 4 || memcmp(r.cur, magic, 4) != 0)
+        return false;
+
+    r.cur += 4;
+
+    std::string cached_path;
+    uint32_t version = r.get32();
+    r(cached_path);
+    uint64_t cached_size = r.get64();
+    uint64_t cached_hash = r.get64();
+
+    return r.ok && version == c_cacheVersion && cached_path == path && cached_size == size && cached_hash == hash;
+}
+
+static void s_writeCache(const std::string &cache_path, const std::vector<uint8_t> &out)
+{
+    std::string dir = s_cacheDir();
+
+    if(!DirMan::exists(dir))
+        DirMan::mkAbsPath(dir);
+
+    SDL_RWops *f = Files::open_file(cache_path, "wb");
+    if(!f)
+    {
+        pLogWarning("ParseCache: failed to write [%s]", cache_path.c_str());
+        return;
+    }
+
+    SDL_RWwrite(f, out.data(), 1, out.size());
+    SDL_RWclose(f);
+
+    AppPathManager::syncFs();
+}
+
+// temporary files of the editor and virtual paths don't get cached
+static bool s_cacheable(const std::string &path)
+{
+    return !path.empty() && !Files::hasSuffix(path, "tst");
+}
+
+
+template<class Callbacks>
+struct CacheRecorder
+{
+    Callbacks inner;
+    CacheWriter w;
+};
+
+template<class Callbacks, class T, uint8_t Rec, class M, M Callbacks::*Cb>
+static bool s_record(void *userdata, T &obj)
+{
+    CacheRecorder<Callbacks> &rec = *static_cast<CacheRecorder<Callbacks>*>(userdata);
+
+    // the callbacks may modify the object, store it as the parser has made it
+    rec.w.out.push_back(Rec);
+    s_fields(rec.w, obj);
+
+    if(!(rec.inner.*Cb))
+        return true;
+
+    return (rec.inner.*Cb)(rec.inner.userdata, obj);
+}
+
+template<class Callbacks>
+static void s_recordError(void *userdata, FileFormatsError &e)
+{
+    CacheRecorder<Callbacks> &rec = *static_cast<CacheRecorder<Callbacks>*>(userdata);
+
+    if(rec.inner.on_error)
+        rec.inner.on_error(rec.inner.userdata, e);
+}
+
+#define CACHE_RECORDER(Callbacks, T, rec, member) \
+    s_record<Callbacks, T, rec, decltype(Callbacks::member), &Callbacks::member>
+
+template<class Callbacks, class T, class M, M Callbacks::*Cb>
+static void s_replayObj(CacheReader &r, Callbacks &cb, bool dry_run, bool &stopped)
+{
+    T obj;
+    s_fields(r, obj);
+
+    if(!r.ok || dry_run || stopped || !(cb.*Cb))
+        return;
+
+    // same as the parser: a callback returning false stops the objects of its kind
+    if(!(cb.*Cb)(cb.userdata, obj))
+        stopped = true;
+}
+
+#define CACHE_REPLAY(Callbacks, T, member) \
+    s_replayObj<Callbacks, T, decltype(Callbacks::member), &Callbacks::member>
+
+static bool s_replayLevel(CacheReader &r, LevelLoadCallbacks &cb, bool dry_run)
+{
+    bool stopped[LC_END] = {};
+
+    while(r.ok)
+    {
+        uint8_t rec = r.get8();
+
+        switch(rec)
+        {
+        case LC_HEAD:
+            CACHE_REPLAY(LevelLoadCallbacks, LevelHead, load_head)(r, cb, dry_run, stopped[rec]);
+            break;
+        case LC_SECTION:
+            CACHE_REPLAY(LevelLoadCallbacks, LevelSection, load_section)(r, cb, dry_run, stopped[rec]);
+            break;
+        case LC_STARTPOINT:
+            CACHE_REPLAY(LevelLoadCallbacks, PlayerPoint, load_startpoint)(r, cb, dry_run, stopped[rec]);
+            break;
+        case LC_BLOCK:
+            CACHE_REPLAY(LevelLoadCallbacks, LevelBlock, load_block)(r, cb, dry_run, stopped[rec]);
+            break;
+        case LC_BGO:
+            CACHE_REPLAY(LevelLoadCallbacks, LevelBGO, load_bgo)(r, cb, dry_run, stopped[rec]);
+            break;
+        case LC_NPC:
+            CACHE_REPLAY(LevelLoadCallbacks, LevelNPC, load_npc)(r, cb, dry_run, stopped[rec]);
+            break;
+        case LC_WARP:
+            CACHE_REPLAY(LevelLoadCallbacks, LevelDoor, load_warp)(r, cb, dry_run, stopped[rec]);
+            break;
+        case LC_PHYS:
+            CACHE_REPLAY(LevelLoadCallbacks, LevelPhysEnv, load_phys)(r, cb, dry_run, stopped[rec]);
+            break;
+        case LC_LAYER:
+            CACHE_REPLAY(LevelLoadCallbacks, LevelLayer, load_layer)(r, cb, dry_run, stopped[rec]);
+            break;
+        case LC_EVENT:
+            CACHE_REPLAY(LevelLoadCallbacks, LevelSMBX64Event, load_event)(r, cb, dry_run, stopped[rec]);
+            break;
+        case LC_END:
+            return r.ok;
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
+
+static bool s_replayWorld(CacheReader &r, WorldLoadCallbacks &cb, bool dry_run)
+{
+    bool stopped[WC_END] = {};
+
+    while(r.ok)
+    {
+        uint8_t rec = r.get8();
+
+        switch(rec)
+        {
+        case WC_HEAD:
+            CACHE_REPLAY(WorldLoadCallbacks, WorldHead, load_head)(r, cb, dry_run, stopped[rec]);
+            break;
+        case WC_TILE:
+            CACHE_REPLAY(WorldLoadCallbacks, WorldTerrainTile, load_tile)(r, cb, dry_run, stopped[rec]);
+            break;
+        case WC_SCENE:
+            CACHE_REPLAY(WorldLoadCallbacks, WorldScenery, load_scene)(r, cb, dry_run, stopped[rec]);
+            break;
+        case WC_PATH:
+            CACHE_REPLAY(WorldLoadCallbacks, WorldPathTile, load_path)(r, cb, dry_run, stopped[rec]);
+            break;
+        case WC_LEVEL:
+            CACHE_REPLAY(WorldLoadCallbacks, WorldLevelTile, load_level)(r, cb, dry_run, stopped[rec]);
+            break;
+        case WC_MUSIC:
+            CACHE_REPLAY(WorldLoadCallbacks, WorldMusicBox, load_music)(r, cb, dry_run, stopped[rec]);
+            break;
+        case WC_AREARECT:
+            CACHE_REPLAY(WorldLoadCallbacks, WorldAreaRect, load_arearect)(r, cb, dry_run, stopped[rec]);
+            break;
+        case WC_END:
+            return r.ok;
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
+
+// tries to replay a valid cache, returns 1 on success, 0 on a miss, and -1 if a replayed callback has failed
+template<class Callbacks>
+static int s_tryCache(const std::string &cache_path, const char *magic, const std::string &path, uint64_t src_size, uint64_t src_hash,
+                      Callbacks &callbacks, bool (*replay)(CacheReader &, Callbacks &, bool))
+{
+    Files::Data cache = Files::load_file(cache_path);
+    if(!cache.valid())
+        return 0;
+
+    CacheReader r;
+    r.cur = cache.begin();
+    r.end = cache.end();
+
+    if(!s_checkHeader(r, magic, path, src_size, src_hash))
+        return 0;
+
+    const uint8_t *body = r.cur;
+
+    // validate the whole cache first: a half-applied file can't fall back to the parser
+    if(!replay(r, callbacks, true))
+    {
+        pLogWarning("ParseCache: cache of [%s] is damaged", path.c_str());
+        return 0;
+    }
+
+    r.cur = body;
+
+    try
+    {
+        replay(r, callbacks, false);
+    }
+    catch(const std::exception &e)
+    {
+        FileFormatsError err;
+        err.ERROR_info = e.what();
+
+        if(callbacks.on_error)
+            callbacks.on_error(callbacks.userdata, err);
+
+        return -1;
+    }
+
+    pLogDebug("ParseCache: loaded [%s] from the cache", path.c_str());
+    return 1;
+}
+
+bool ParseCache::openLevelFile(PGE_FileFormats_misc::TextInput &input, const std::string &path, LevelLoadCallbacks &callbacks)
+{
+    if(!s_cacheable(path))
+        return FileFormats::OpenLevelFileT(input, callbacks);
+
+    Files::Data src = Files::load_file(path);
+    if(!src.valid())
+        return FileFormats::OpenLevelFileT(input, callbacks);
+
+    uint64_t src_size = (uint64_t)src.size();
+    uint64_t src_hash = s_hashData(src.begin(), src.size());
+    std::string cache_path = s_cachePath(path, ".lvlc");
+
+    int cached = s_tryCache(cache_path, c_levelMagic, path, src_size, src_hash, callbacks, s_replayLevel);
+    if(cached != 0)
+        return cached > 0;
+
+    typedef LevelLoadCallbacks CB;
+
+    CacheRecorder<CB> rec;
+    rec.inner = callbacks;
+    s_putHeader(rec.w, c_levelMagic, path, src_size, src_hash);
+
+    CB cb = callbacks;
+    cb.on_error = s_recordError<CB>;
+    cb.load_head = CACHE_RECORDER(CB, LevelHead, LC_HEAD, load_head);
+    cb.load_section = CACHE_RECORDER(CB, LevelSection, LC_SECTION, load_section);
+    cb.load_startpoint = CACHE_RECORDER(CB, PlayerPoint, LC_STARTPOINT, load_startpoint);
+    cb.load_block = CACHE_RECORDER(CB, LevelBlock, LC_BLOCK, load_block);
+    cb.load_bgo = CACHE_RECORDER(CB, LevelBGO, LC_BGO, load_bgo);
+    cb.load_npc = CACHE_RECORDER(CB, LevelNPC, LC_NPC, load_npc);
+    cb.load_warp = CACHE_RECORDER(CB, LevelDoor, LC_WARP, load_warp);
+    cb.load_phys = CACHE_RECORDER(CB, LevelPhysEnv, LC_PHYS, load_phys);
+    cb.load_layer = CACHE_RECORDER(CB, LevelLayer, LC_LAYER, load_layer);
+    cb.load_event = CACHE_RECORDER(CB, LevelSMBX64Event, LC_EVENT, load_event);
+    cb.userdata = &rec;
+
+    if(!FileFormats::OpenLevelFileT(input, cb))
+        return false;
+
+    rec.w.out.push_back(LC_END);
+    s_writeCache(cache_path, rec.w.out);
+
+    return true;
+}
+
+bool ParseCache::openWorldFile(PGE_FileFormats_misc::TextInput &input, const std::string &path, WorldLoadCallbacks &callbacks)
+{
+    if(!s_cacheable(path))
+        return FileFormats::OpenWorldFileT(input, callbacks);
+
+    Files::Data src = Files::load_file(path);
+    if(!src.valid())
+        return FileFormats::OpenWorldFileT(input, callbacks);
+
+    uint64_t src_size = (uint64_t)src.size();
+    uint64_t src_hash = s_hashData(src.begin(), src.size());
+    std::string cache_path = s_cachePath(path, ".wldc");
+
+    int cached = s_tryCache(cache_path, c_worldMagic, path, src_size, src_hash, callbacks, s_replayWorld);
+    if(cached != 0)
+        return cached > 0;
+
+    typedef WorldLoadCallbacks CB;
+
+    CacheRecorder<CB> rec;
+    rec.inner = callbacks;
+    s_putHeader(rec.w, c_worldMagic, path, src_size, src_hash);
+
+    CB cb = callbacks;
+    cb.on_error = s_recordError<CB>;
+    cb.load_head = CACHE_RECORDER(CB, WorldHead, WC_HEAD, load_head);
+    cb.load_tile = CACHE_RECORDER(CB, WorldTerrainTile, WC_TILE, load_tile);
+    cb.load_scene = CACHE_RECORDER(CB, WorldScenery, WC_SCENE, load_scene);
+    cb.load_path = CACHE_RECORDER(CB, WorldPathTile, WC_PATH, load_path);
+    cb.load_level = CACHE_RECORDER(CB, WorldLevelTile, WC_LEVEL, load_level);
+    cb.load_music = CACHE_RECORDER(CB, WorldMusicBox, WC_MUSIC, load_music);
+    cb.load_arearect = CACHE_RECORDER(CB, WorldAreaRect, WC_AREARECT, load_arearect);
+    cb.userdata = &rec;
+
+    if(!FileFormats::OpenWorldFileT(input, cb))
+        return false;
+
+    rec.w.out.push_back(WC_END);
+    s_writeCache(cache_path, rec.w.out);
+
+    return true;
+}
+
+#endif // #ifdef PGEFL_CALLBACK_API
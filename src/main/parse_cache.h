@@ -0,0 +1,63 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef PARSE_CACHE_H
+#define PARSE_CACHE_H
+
+#include <string>
+#include <PGE_File_Formats/file_formats.h>
+
+/**
+ * \brief Persistent binary cache of parsed level and world map files
+ *
+ * The cache stores the sequence of objects the PGE-FL parser hands to the loading callbacks
+ * in a compact binary form (.lvlc and .wldc files at the settings directory), keyed by the path
+ * of the file and validated by the hash of its content. When the cache is valid, the
+ * callbacks get replayed from it and the text parser doesn't run at all. Everything the
+ * callbacks do after that (path resolution, custom configs, saved stars) is left intact,
+ * so the result of the load is identical to the one of the text parser.
+ */
+namespace ParseCache
+{
+
+#ifdef PGEFL_CALLBACK_API
+/**
+ * \brief Load the level file through the cache, or parse it and refresh the cache
+ * \param input Opened level file
+ * \param path Path to the level file
+ * \param callbacks Loading callbacks
+ * \return true if the level has been loaded successfully
+ */
+bool openLevelFile(PGE_FileFormats_misc::TextInput &input, const std::string &path, LevelLoadCallbacks &callbacks);
+
+/**
+ * \brief Load the world map file through the cache, or parse it and refresh the cache
+ * \param input Opened world map file
+ * \param path Path to the world map file
+ * \param callbacks Loading callbacks
+ * \return true if the world map has been loaded successfully
+ */
+bool openWorldFile(PGE_FileFormats_misc::TextInput &input, const std::string &path, WorldLoadCallbacks &callbacks);
+#endif
+
+} // namespace ParseCache
+
+#endif // PARSE_CACHE_H
@@ -0,0 +1,774 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "sdl_proxy/sdl_timer.h"
+
+#include "globals.h"
+#include "config.h"
+#include "frame_timer.h"
+#include "game_main.h"
+#include "layers.h"
+#include "saved_layers.h"
+#include "player.h"
+#include "screen.h"
+#include "message.h"
+#include "rand.h"
+
+#include "graphics/gfx_update.h"
+#include "main/run_ahead.h"
+#include "main/game_globals.h"
+#include "main/game_loop_interrupt.h"
+#include "main/level_medals.h"
+#include "main/record.h"
+#include "main/block_table.h"
+#include "main/block_type_index.h"
+#include "main/trees.h"
+#include "main/screen_quickreconnect.h"
+#include "npc/npc_queues.h"
+#include "npc/npc_riders.h"
+#include "npc/section_overlap.h"
+#include "player/player_index.h"
+#include "script/luna/luna.h"
+
+
+namespace RunAhead
+{
+
+// a hidden frame is simulated
+static bool s_hidden = false;
+// the draw of the current frame is handled by GameLoop()
+static bool s_deferDraw = false;
+// the current frame is the last hidden frame, which gets drawn
+static bool s_drawLast = false;
+// UpdateGraphics() reached the draw during the current frame
+static bool s_drawRequested = false;
+
+bool hiddenFrame()
+{
+    return s_hidden;
+}
+
+bool skipDraw()
+{
+    if(!s_deferDraw)
+        return false;
+
+    s_drawRequested = true;
+
+    return !s_drawLast;
+}
+
+
+struct LayerState_t
+{
+    bool EffectStop;
+    bool Hidden;
+    uint8_t join_timer;
+    numf_t SpeedX;
+    numf_t SpeedY;
+    numf_t ApplySpeedX;
+    numf_t ApplySpeedY;
+    num_t OffsetX;
+    num_t OffsetY;
+
+    // which of the spatial tables hold the layer's objects at its own offset
+    bool split_blocks;
+    bool split_BGOs;
+    bool split_waters;
+};
+
+// everything that a level frame may change, except for the graphics logic state (saved by gfx_update.cpp) and the random state (saved by rand.cpp)
+struct LevelState_t
+{
+    int numPlayers;
+    int numNPCs;
+    int numBlock;
+    int numBackground;
+    int numLocked;
+    int numEffects;
+    int numWater;
+    int numWarps;
+    int iBlocks;
+    int numStars;
+    int newEventNum;
+
+    std::vector<Player_t> players;
+    std::vector<NPC_t> NPCs;
+    std::vector<Block_t> blocks;
+    std::vector<Background_t> BGOs;
+    std::vector<Effect_t> effects;
+    std::vector<Water_t> waters;
+    std::vector<Warp_t> warps;
+    std::vector<vbint_t> iBlock;
+
+    std::vector<LayerState_t> layers;
+    std::vector<eventindex_t> NewEvent;
+    std::vector<vbint_t> newEventDelay;
+    std::vector<uint8_t> newEventPlayer;
+    std::vector<bool> SavedLayers_visible;
+
+    std::vector<NPCRef_t> NoReset;
+    std::vector<NPCRef_t> Killed;
+    std::vector<NPCRef_t> PlayerTemp;
+    std::vector<NPCRef_t> Unchecked;
+    std::set<NPCRef_t> Active;
+    std::set<NPCRef_t> RespawnDelay;
+
+    std::vector<SpeedlessLocation_t> level;
+    std::vector<bool> LevelWrap;
+    std::vector<bool> LevelVWrap;
+    std::vector<bool> OffScreenExit;
+    std::vector<vbint_t> bgMusic;
+    std::vector<vbint_t> Background2;
+    std::vector<numf_t> AutoX;
+    std::vector<numf_t> AutoY;
+    std::vector<bool> NoTurnBack;
+    std::vector<bool> UnderWater;
+    std::vector<std::string> CustomMusic;
+
+    std::vector<vScreen_t> vScreen;
+    std::vector<qScreen_t> qScreenLoc;
+    std::vector<Screen_t> Screens;
+    ScreenFader levelScreenFader;
+    std::vector<ScreenFader> levelVScreenFader;
+
+    std::vector<vbint_t> BlockFrame;
+    std::vector<vbint_t> BlockFrame2;
+    std::vector<vbint_t> BackgroundFrame;
+    std::vector<vbint_t> BackgroundFrameCount;
+    std::vector<vbint_t> SpecialFrame;
+    std::vector<vbint_t> SpecialFrameCount;
+    std::vector<vbint_t> CoinFrame;
+    std::vector<vbint_t> CoinFrame2;
+    std::vector<vbint_t> SoundPause;
+
+    std::vector<SavedChar_t> SavedChar;
+    std::vector<vbint_t> OwedMount;
+    std::vector<vbint_t> OwedMountType;
+    std::vector<int> BattleLives;
+
+    std::string Checkpoint;
+    std::vector<Checkpoint_t> CheckpointsList;
+    std::vector<Star_t> Star;
+    CurLevelMedals_t curLevelMedals;
+    GameLoopInterrupt gameLoopInterrupt;
+    PauseCode GamePaused;
+
+    uint32_t CommonFrame;
+    uint32_t CommonFrame_NotFrozen;
+    int Coins;
+    int Lives;
+    int g_100s;
+    int Score;
+    int PSwitchTime;
+    int PSwitchStop;
+    int PSwitchPlayer;
+    int InvincibilityTime;
+    int BeltDirection;
+    int StopHit;
+    bool BlocksSorted;
+    bool FreezeNPCs;
+    LevelMacro_t LevelMacro;
+    int LevelMacroCounter;
+    int LevelMacroWhich;
+    bool EndLevel;
+    bool ErrorQuit;
+    LevelBeatCode_t LevelBeatCode;
+    int BattleWinner;
+    int BattleIntro;
+    int BattleOutro;
+    bool qScreen;
+    bool qScreen_canonical;
+    int curMusic;
+    int ReturnWarp;
+    int StartWarp;
+    bool ForcedControls;
+    Controls_t ForcedControl;
+};
+
+static LevelState_t s_saved;
+
+
+template<class Arr>
+static void s_saveRange(std::vector<typename Arr::Type>& to, const Arr& from, int first, int last)
+{
+    to.clear();
+
+    for(int i = first; i <= last; i++)
+        to.push_back(from[i]);
+}
+
+template<class Arr>
+static void s_loadRange(Arr& to, const std::vector<typename Arr::Type>& from, int first)
+{
+    for(size_t i = 0; i < from.size(); i++)
+        to[first + (int)i] = from[i];
+}
+
+// the run-ahead mode can't be used with anything that needs the exact frames, or that keeps state outside of the level
+static bool s_allowed()
+{
+#ifdef __16M__
+    return false;
+#else
+    return g_config.run_ahead > 0
+        && !LevelEditor && !MagicHand && !LevelSelect && !GameMenu
+        && XMessage::GetStatus() == XMessage::Status::local
+        && !Record::record_file && !Record::replay_file
+        && !lunaLoopActive()
+        && !fastForwardActive()
+        && !QuickReconnectScreen::g_active;
+#endif
+}
+
+// only plain gameplay frames get saved and simulated
+static bool s_canContinue()
+{
+    return GamePaused == PauseCode::None
+        && g_gameLoopInterrupt.site == GameLoopInterrupt::None
+        && !g_gameLoopInterrupt.process_intro_events
+        && LevelMacro == LEVELMACRO_OFF && !EndLevel && !ErrorQuit
+        && !qScreen && !qScreen_canonical
+        && BattleIntro == 0 && BattleOutro == 0
+        && GoToLevel.empty()
+        && LivingPlayers();
+}
+
+static void s_saveState()
+{
+    LevelState_t& s = s_saved;
+
+    s.numPlayers = numPlayers;
+    s.numNPCs = numNPCs;
+    s.numBlock = numBlock;
+    s.numBackground = numBackground;
+    s.numLocked = numLocked;
+    s.numEffects = numEffects;
+    s.numWater = numWater;
+    s.numWarps = numWarps;
+    s.iBlocks = iBlocks;
+    s.numStars = numStars;
+    s.newEventNum = newEventNum;
+
+    s_saveRange(s.players, Player, 0, numPlayers);
+    s_saveRange(s.NPCs, NPC, 1, numNPCs);
+    s_saveRange(s.blocks, Block, 1, numBlock);
+    s_saveRange(s.BGOs, Background, 1, numBackground + numLocked);
+    s_saveRange(s.effects, Effect, 1, numEffects);
+    s_saveRange(s.waters, Water, 1, numWater);
+    s_saveRange(s.warps, Warp, 1, numWarps);
+    s_saveRange(s.iBlock, iBlock, 1, iBlocks);
+
+    s.layers.resize(numLayers);
+
+    for(int i = 0; i < numLayers; i++)
+    {
+        const Layer_t& l = Layer[i];
+        LayerState_t& o = s.layers[i];
+
+        o.EffectStop = l.EffectStop;
+        o.Hidden = l.Hidden;
+        o.join_timer = l.join_timer;
+        o.SpeedX = l.SpeedX;
+        o.SpeedY = l.SpeedY;
+        o.ApplySpeedX = l.ApplySpeedX;
+        o.ApplySpeedY = l.ApplySpeedY;
+        o.OffsetX = l.OffsetX;
+        o.OffsetY = l.OffsetY;
+
+        o.split_blocks = treeBlockLayerActive(i);
+        o.split_BGOs = treeBackgroundLayerActive(i);
+        o.split_waters = treeWaterLayerActive(i);
+    }
+
+    s_saveRange(s.NewEvent, NewEvent, 1, newEventNum);
+    s_saveRange(s.newEventDelay, newEventDelay, 1, newEventNum);
+    s_saveRange(s.newEventPlayer, newEventPlayer, 1, newEventNum);
+
+    s.SavedLayers_visible.resize(numSavedLayers);
+    for(int i = 0; i < numSavedLayers; i++)
+        s.SavedLayers_visible[i] = SavedLayers[i].Visible;
+
+    s.NoReset = NPCQueues::NoReset;
+    s.Killed = NPCQueues::Killed;
+    s.PlayerTemp = NPCQueues::PlayerTemp;
+    s.Unchecked = NPCQueues::Unchecked;
+    s.Active = NPCQueues::Active.no_change;
+    s.RespawnDelay = NPCQueues::RespawnDelay;
+
+    s_saveRange(s.level, level, 0, maxSections);
+    s_saveRange(s.LevelWrap, LevelWrap, 0, maxSections);
+    s_saveRange(s.LevelVWrap, LevelVWrap, 0, maxSections);
+    s_saveRange(s.OffScreenExit, OffScreenExit, 0, maxSections);
+    s_saveRange(s.bgMusic, bgMusic, 0, maxSections);
+    s_saveRange(s.Background2, Background2, 0, maxSections);
+    s_saveRange(s.AutoX, AutoX, 0, maxSections);
+    s_saveRange(s.AutoY, AutoY, 0, maxSections);
+    s_saveRange(s.NoTurnBack, NoTurnBack, 0, maxSections);
+    s_saveRange(s.UnderWater, UnderWater, 0, maxSections);
+    s_saveRange(s.CustomMusic, CustomMusic, 0, maxSections);
+
+    s_saveRange(s.vScreen, vScreen, 0, c_vScreenCount);
+    s_saveRange(s.qScreenLoc, qScreenLoc, 0, c_vScreenCount);
+    s_saveRange(s.Screens, Screens, 0, c_screenCount - 1);
+    s.levelScreenFader = g_levelScreenFader;
+    s_saveRange(s.levelVScreenFader, g_levelVScreenFader, 0, c_vScreenCount);
+
+    s_saveRange(s.BlockFrame, BlockFrame, 1, maxBlockType);
+    s_saveRange(s.BlockFrame2, BlockFrame2, 1, maxBlockType);
+    s_saveRange(s.BackgroundFrame, BackgroundFrame, 1, maxBackgroundType);
+    s_saveRange(s.BackgroundFrameCount, BackgroundFrameCount, 1, maxBackgroundType);
+    s_saveRange(s.SpecialFrame, SpecialFrame, 0, 9);
+    s_saveRange(s.SpecialFrameCount, SpecialFrameCount, 0, 9);
+    s_saveRange(s.CoinFrame, CoinFrame, 1, 10);
+    s_saveRange(s.CoinFrame2, CoinFrame2, 1, 10);
+    s_saveRange(s.SoundPause, SoundPause, 1, numSounds);
+
+    s_saveRange(s.SavedChar, SavedChar, 0, 10);
+    s_saveRange(s.OwedMount, OwedMount, 0, maxPlayers);
+    s_saveRange(s.OwedMountType, OwedMountType, 0, maxPlayers);
+    s_saveRange(s.BattleLives, BattleLives, 1, maxPlayers);
+
+    s.Checkpoint = Checkpoint;
+    s.CheckpointsList = CheckpointsList;
+    s.Star = Star;
+    s.curLevelMedals = g_curLevelMedals;
+    s.gameLoopInterrupt = g_gameLoopInterrupt;
+    s.GamePaused = GamePaused;
+
+    s.CommonFrame = CommonFrame;
+    s.CommonFrame_NotFrozen = CommonFrame_NotFrozen;
+    s.Coins = Coins;
+    s.Lives = Lives;
+    s.g_100s = g_100s;
+    s.Score = Score;
+    s.PSwitchTime = PSwitchTime;
+    s.PSwitchStop = PSwitchStop;
+    s.PSwitchPlayer = PSwitchPlayer;
+    s.InvincibilityTime = InvincibilityTime;
+    s.BeltDirection = BeltDirection;
+    s.StopHit = StopHit;
+    s.BlocksSorted = BlocksSorted;
+    s.FreezeNPCs = FreezeNPCs;
+    s.LevelMacro = LevelMacro;
+    s.LevelMacroCounter = LevelMacroCounter;
+    s.LevelMacroWhich = LevelMacroWhich;
+    s.EndLevel = EndLevel;
+    s.ErrorQuit = ErrorQuit;
+    s.LevelBeatCode = LevelBeatCode;
+    s.BattleWinner = BattleWinner;
+    s.BattleIntro = BattleIntro;
+    s.BattleOutro = BattleOutro;
+    s.qScreen = qScreen;
+    s.qScreen_canonical = qScreen_canonical;
+    s.curMusic = curMusic;
+    s.ReturnWarp = ReturnWarp;
+    s.StartWarp = StartWarp;
+    s.ForcedControls = ForcedControls;
+    s.ForcedControl = ForcedControl;
+
+    random_save_state();
+    SaveGraphicsLogicState();
+}
+
+// checks whether an object's entry in the spatial tables differs between the hidden and the saved state
+template<class Loc>
+static bool s_movedInTable(const Loc& cur, const Loc& saved, layerindex_t layer, bool split)
+{
+    if(cur.Width != saved.Width || cur.Height != saved.Height)
+        return true;
+
+    // the tables of the split layers are relative to the layer offset
+    if(split && layer != LAYER_NONE)
+    {
+        const Layer_t& l = Layer[layer];
+        const LayerState_t& o = s_saved.layers[layer];
+
+        return cur.X - l.OffsetX != saved.X - o.OffsetX || cur.Y - l.OffsetY != saved.Y - o.OffsetY;
+    }
+
+    return cur.X != saved.X || cur.Y != saved.Y;
+}
+
+static void s_loadState()
+{
+    const LevelState_t& s = s_saved;
+
+    // find the objects that must be synced to their layers and tables, before the layer offsets get restored
+    std::vector<int> sync_blocks, sync_BGOs, sync_waters, sync_warps, sync_NPCs, moved_NPCs;
+
+    int numBackground_all = numBackground + numLocked;
+    int saved_BGOs = (int)s.BGOs.size();
+
+    for(int i = 1; i <= std::max(numBlock, s.numBlock); i++)
+    {
+        if(i > numBlock || i > s.numBlock)
+            sync_blocks.push_back(i);
+        else
+        {
+            const Block_t& cur = Block[i];
+            const Block_t& saved = s.blocks[i - 1];
+
+            if(cur.Layer != saved.Layer || cur.Type != saved.Type
+                || s_movedInTable(cur.Location, saved.Location, cur.Layer, cur.Layer != LAYER_NONE && treeBlockLayerActive(cur.Layer)))
+            {
+                sync_blocks.push_back(i);
+            }
+        }
+    }
+
+    for(int i = 1; i <= std::max(numBackground_all, saved_BGOs); i++)
+    {
+        if(i > numBackground_all || i > saved_BGOs)
+            sync_BGOs.push_back(i);
+        else
+        {
+            const Background_t& cur = Background[i];
+            const Background_t& saved = s.BGOs[i - 1];
+
+            if(cur.Layer != saved.Layer || cur.Type != saved.Type
+                || s_movedInTable(cur.Location, saved.Location, cur.Layer, cur.Layer != LAYER_NONE && treeBackgroundLayerActive(cur.Layer)))
+            {
+                sync_BGOs.push_back(i);
+            }
+        }
+    }
+
+    for(int i = 1; i <= std::max(numWater, s.numWater); i++)
+    {
+        if(i > numWater || i > s.numWater)
+            sync_waters.push_back(i);
+        else
+        {
+            const Water_t& cur = Water[i];
+            const Water_t& saved = s.waters[i - 1];
+
+            if(cur.Layer != saved.Layer
+                || s_movedInTable(cur.Location, saved.Location, cur.Layer, cur.Layer != LAYER_NONE && treeWaterLayerActive(cur.Layer)))
+            {
+                sync_waters.push_back(i);
+            }
+        }
+    }
+
+    for(int i = 1; i <= std::max(numWarps, s.numWarps); i++)
+    {
+        if(i > numWarps || i > s.numWarps || Warp[i].Layer != s.warps[i - 1].Layer)
+            sync_warps.push_back(i);
+    }
+
+    for(int i = 1; i <= std::max(numNPCs, s.numNPCs); i++)
+    {
+        if(i > numNPCs || i > s.numNPCs || NPC[i].Layer != s.NPCs[i - 1].Layer)
+            sync_NPCs.push_back(i);
+        else
+        {
+            const NPC_t& cur = NPC[i];
+            const NPC_t& saved = s.NPCs[i - 1];
+
+            if(cur.Type != saved.Type
+                || cur.Location.X != saved.Location.X || cur.Location.Y != saved.Location.Y
+                || cur.Location.Width != saved.Location.Width || cur.Location.Height != saved.Location.Height)
+            {
+                moved_NPCs.push_back(i);
+            }
+        }
+    }
+
+    bool sections_changed = false;
+    for(int i = 0; i <= maxSections && !sections_changed; i++)
+    {
+        const SpeedlessLocation_t& cur = level[i];
+        const SpeedlessLocation_t& saved = s.level[i];
+
+        sections_changed = (cur.X != saved.X || cur.Y != saved.Y || cur.Width != saved.Width || cur.Height != saved.Height);
+    }
+
+    // restore the objects and their layers
+    for(int i = 0; i < numLayers; i++)
+    {
+        Layer_t& l = Layer[i];
+        const LayerState_t& o = s.layers[i];
+
+        l.EffectStop = o.EffectStop;
+        l.Hidden = o.Hidden;
+        l.join_timer = o.join_timer;
+        l.SpeedX = o.SpeedX;
+        l.SpeedY = o.SpeedY;
+        l.ApplySpeedX = o.ApplySpeedX;
+        l.ApplySpeedY = o.ApplySpeedY;
+        l.OffsetX = o.OffsetX;
+        l.OffsetY = o.OffsetY;
+    }
+
+    numPlayers = s.numPlayers;
+    numNPCs = s.numNPCs;
+    numBlock = s.numBlock;
+    numBackground = s.numBackground;
+    numLocked = s.numLocked;
+    numEffects = s.numEffects;
+    numWater = s.numWater;
+    numWarps = s.numWarps;
+    iBlocks = s.iBlocks;
+    numStars = s.numStars;
+    newEventNum = s.newEventNum;
+
+    s_loadRange(Player, s.players, 0);
+    s_loadRange(NPC, s.NPCs, 1);
+    s_loadRange(Block, s.blocks, 1);
+    s_loadRange(Background, s.BGOs, 1);
+    s_loadRange(Effect, s.effects, 1);
+    s_loadRange(Water, s.waters, 1);
+    s_loadRange(Warp, s.warps, 1);
+    s_loadRange(iBlock, s.iBlock, 1);
+
+    NPCQueues::NoReset = s.NoReset;
+    NPCQueues::Killed = s.Killed;
+    NPCQueues::PlayerTemp = s.PlayerTemp;
+    NPCQueues::Unchecked = s.Unchecked;
+    NPCQueues::Active.clear();
+    for(NPCRef_t n : s.Active)
+        NPCQueues::Active.insert(n);
+    NPCQueues::RespawnDelay = s.RespawnDelay;
+
+    // resync the changed objects (the objects past the restored counts get removed)
+    for(int i : sync_blocks)
+        syncLayersTrees_Block(i);
+
+    for(int i : sync_BGOs)
+        syncLayers_BGO(i);
+
+    for(int i : sync_waters)
+        syncLayers_Water(i);
+
+    for(int i : sync_warps)
+        syncLayers_Warp(i);
+
+    for(int i : sync_NPCs)
+        syncLayers_NPC(i);
+
+    for(int i : moved_NPCs)
+        treeNPCUpdate(i);
+
+    if(!sync_blocks.empty())
+        BlockTypeIndex::invalidate();
+
+    // split or join the layers whose state changed during the hidden frames
+    for(int i = 0; i < numLayers; i++)
+    {
+        const LayerState_t& o = s.layers[i];
+
+        if(treeBlockLayerActive(i) != o.split_blocks)
+        {
+            if(o.split_blocks)
+                treeBlockSplitLayer(i);
+            else
+                treeBlockJoinLayer(i);
+        }
+
+        if(treeBackgroundLayerActive(i) != o.split_BGOs)
+        {
+            if(o.split_BGOs)
+                treeBackgroundSplitLayer(i);
+            else
+                treeBackgroundJoinLayer(i);
+        }
+
+        if(treeWaterLayerActive(i) != o.split_waters)
+        {
+            if(o.split_waters)
+                treeWaterSplitLayer(i);
+            else
+                treeWaterJoinLayer(i);
+        }
+    }
+
+    NPCRiders::rebuild();
+    PlayerIndex::invalidate();
+
+    s_loadRange(NewEvent, s.NewEvent, 1);
+    s_loadRange(newEventDelay, s.newEventDelay, 1);
+    s_loadRange(newEventPlayer, s.newEventPlayer, 1);
+
+    for(int i = 0; i < numSavedLayers && i < (int)s.SavedLayers_visible.size(); i++)
+        SavedLayers[i].Visible = s.SavedLayers_visible[i];
+
+    s_loadRange(level, s.level, 0);
+    s_loadRange(LevelWrap, s.LevelWrap, 0);
+    s_loadRange(LevelVWrap, s.LevelVWrap, 0);
+    s_loadRange(OffScreenExit, s.OffScreenExit, 0);
+    s_loadRange(bgMusic, s.bgMusic, 0);
+    s_loadRange(Background2, s.Background2, 0);
+    s_loadRange(AutoX, s.AutoX, 0);
+    s_loadRange(AutoY, s.AutoY, 0);
+    s_loadRange(NoTurnBack, s.NoTurnBack, 0);
+    s_loadRange(UnderWater, s.UnderWater, 0);
+    s_loadRange(CustomMusic, s.CustomMusic, 0);
+
+    if(sections_changed)
+        CalculateSectionOverlaps();
+
+    s_loadRange(vScreen, s.vScreen, 0);
+    s_loadRange(qScreenLoc, s.qScreenLoc, 0);
+    s_loadRange(Screens, s.Screens, 0);
+    g_levelScreenFader = s.levelScreenFader;
+    s_loadRange(g_levelVScreenFader, s.levelVScreenFader, 0);
+
+    s_loadRange(BlockFrame, s.BlockFrame, 1);
+    s_loadRange(BlockFrame2, s.BlockFrame2, 1);
+    s_loadRange(BackgroundFrame, s.BackgroundFrame, 1);
+    s_loadRange(BackgroundFrameCount, s.BackgroundFrameCount, 1);
+    s_loadRange(SpecialFrame, s.SpecialFrame, 0);
+    s_loadRange(SpecialFrameCount, s.SpecialFrameCount, 0);
+    s_loadRange(CoinFrame, s.CoinFrame, 1);
+    s_loadRange(CoinFrame2, s.CoinFrame2, 1);
+    s_loadRange(SoundPause, s.SoundPause, 1);
+
+    s_loadRange(SavedChar, s.SavedChar, 0);
+    s_loadRange(OwedMount, s.OwedMount, 0);
+    s_loadRange(OwedMountType, s.OwedMountType, 0);
+    s_loadRange(BattleLives, s.BattleLives, 1);
+
+    Checkpoint = s.Checkpoint;
+    CheckpointsList = s.CheckpointsList;
+    Star = s.Star;
+    g_curLevelMedals = s.curLevelMedals;
+    g_gameLoopInterrupt = s.gameLoopInterrupt;
+    GamePaused = s.GamePaused;
+
+    CommonFrame = s.CommonFrame;
+    CommonFrame_NotFrozen = s.CommonFrame_NotFrozen;
+    Coins = s.Coins;
+    Lives = s.Lives;
+    g_100s = s.g_100s;
+    Score = s.Score;
+    PSwitchTime = s.PSwitchTime;
+    PSwitchStop = s.PSwitchStop;
+    PSwitchPlayer = s.PSwitchPlayer;
+    InvincibilityTime = s.InvincibilityTime;
+    BeltDirection = s.BeltDirection;
+    StopHit = s.StopHit;
+    BlocksSorted = s.BlocksSorted;
+    FreezeNPCs = s.FreezeNPCs;
+    LevelMacro = s.LevelMacro;
+    LevelMacroCounter = s.LevelMacroCounter;
+    LevelMacroWhich = s.LevelMacroWhich;
+    EndLevel = s.EndLevel;
+    ErrorQuit = s.ErrorQuit;
+    LevelBeatCode = s.LevelBeatCode;
+    BattleWinner = s.BattleWinner;
+    BattleIntro = s.BattleIntro;
+    BattleOutro = s.BattleOutro;
+    qScreen = s.qScreen;
+    qScreen_canonical = s.qScreen_canonical;
+    curMusic = s.curMusic;
+    ReturnWarp = s.ReturnWarp;
+    StartWarp = s.StartWarp;
+    ForcedControls = s.ForcedControls;
+    ForcedControl = s.ForcedControl;
+
+    random_load_state();
+    LoadGraphicsLogicState();
+}
+
+void GameLoop()
+{
+    if(!s_allowed() || !s_canContinue())
+    {
+        g_stats.runAheadFrames = 0;
+        ::GameLoop();
+        return;
+    }
+
+    // run the real frame, holding back its draw
+    s_deferDraw = true;
+    s_drawLast = false;
+    s_drawRequested = false;
+
+    ::GameLoop();
+
+    s_deferDraw = false;
+
+    // frame skip, or nothing to draw
+    if(!s_drawRequested)
+    {
+        g_stats.runAheadFrames = 0;
+        return;
+    }
+
+    if(!s_canContinue())
+    {
+        g_stats.runAheadFrames = 0;
+        g_microStats.start_task(MicroStats::Graphics);
+        UpdateGraphicsDraw();
+        return;
+    }
+
+    uint64_t save_start = SDL_GetMicroTicks();
+    s_saveState();
+    uint64_t run_start = SDL_GetMicroTicks();
+
+    int frames = 0;
+    bool drawn = false;
+
+    s_hidden = true;
+    s_deferDraw = true;
+
+    for(int i = 1; i <= g_config.run_ahead; i++)
+    {
+        s_drawLast = (i == g_config.run_ahead);
+        s_drawRequested = false;
+
+        ::GameLoop();
+        frames++;
+
+        // the last frame may have been drawn before it reached a state that can't be continued, and it's still a valid prediction
+        if(s_drawLast)
+            drawn = s_drawRequested;
+        else if(!s_canContinue())
+            break;
+    }
+
+    s_hidden = false;
+    s_deferDraw = false;
+    s_drawLast = false;
+
+    uint64_t load_start = SDL_GetMicroTicks();
+    s_loadState();
+    uint64_t load_end = SDL_GetMicroTicks();
+
+    // draw the real frame when the hidden frames were cut short
+    if(!drawn)
+    {
+        g_microStats.start_task(MicroStats::Graphics);
+        UpdateGraphicsDraw();
+    }
+
+    g_stats.runAheadFrames = frames;
+    g_stats.runAheadSave = (int)(run_start - save_start);
+    g_stats.runAheadLoad = (int)(load_end - load_start);
+    g_stats.runAheadRun = (int)(load_start - run_start);
+}
+
+} // namespace RunAhead
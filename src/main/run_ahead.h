@@ -0,0 +1,56 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef RUN_AHEAD_H
+#define RUN_AHEAD_H
+
+/*
+ * Run-ahead mode of the level loop, to hide the input lag of the game logic.
+ *
+ * After each real frame, the level state is saved, the requested number of
+ * hidden frames is simulated with the current controls, and the last of them
+ * is drawn instead of the real frame. Then the saved state is restored, so
+ * the hidden frames never affect the game.
+ *
+ * The hidden frames must not have any effect outside of the level state:
+ * the code playing sounds or music, rumbling the controllers, ticking the
+ * timers, or writing the saves checks hiddenFrame() and does nothing.
+ * A hidden frame that would pause the game, end the level, or reach any
+ * other state that can't be continued is discarded, and the real frame is
+ * drawn instead.
+ */
+
+namespace RunAhead
+{
+
+// returns true while a hidden frame is simulated
+bool hiddenFrame();
+
+// called by UpdateGraphics() after the graphics logic, returns true if the frame must not be drawn
+bool skipDraw();
+
+// runs a frame of the level loop, followed by the hidden frames if run-ahead is enabled and possible
+void GameLoop();
+
+} // namespace RunAhead
+
+#endif // #ifndef RUN_AHEAD_H
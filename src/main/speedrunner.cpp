@@ -29,6 +29,7 @@
 
 #include "main/screen_quickreconnect.h"
 #include "main/menu_main.h"
+#include "main/run_ahead.h"
 
 #include "gameplay_timer.h"
 
@@ -531,7 +532,7 @@ void speedRun_renderControls(int player, int screenZ, int align)
 
 void speedRun_tick()
 {
-    if(!g_config.enable_playtime_tracking)
+    if(!g_config.enable_playtime_tracking || RunAhead::hiddenFrame())
         return; // Do nothing
 
     s_gamePlayTimer.tick();
@@ -564,7 +565,7 @@ void speedRun_triggerLeave()
 
 void speedRun_bossDeadEvent()
 {
-    if(!g_config.enable_playtime_tracking)
+    if(!g_config.enable_playtime_tracking || RunAhead::hiddenFrame())
         return; // Do nothing
 
     if(GameMenu || GameOutro || BattleMode)
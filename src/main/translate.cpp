@@ -804,6 +804,10 @@ XTechTranslate::XTechTranslate()
     insert(m_engineMap, "editor.file.convert.featureWorldMapSections", &g_editorStrings.fileConvertFeatureWorldMapSections);
 #endif
 
+    insert(m_engineMap, "editor.journal.recoveryPrompt",   &g_editorStrings.journalRecoveryPrompt);
+    insert(m_engineMap, "editor.journal.recoveryRestore",  &g_editorStrings.journalRecoveryRestore);
+    insert(m_engineMap, "editor.journal.recoveryDiscard",  &g_editorStrings.journalRecoveryDiscard);
+
     insert(m_engineMap, "editor.browser.newFile",          &g_editorStrings.browserNewFile);
     insert(m_engineMap, "editor.browser.saveFile",         &g_editorStrings.browserSaveFile);
     insert(m_engineMap, "editor.browser.openFile",         &g_editorStrings.browserOpenFile);
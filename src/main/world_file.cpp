@@ -40,6 +40,7 @@
 #include "saved_layers.h"
 #include "main/game_info.h"
 #include "main/level_save_info.h"
+#include "main/parse_cache.h"
 #include "main/screen_progress.h"
 #include "main/game_strings.h"
 #include "translate_episode.h"
@@ -139,7 +140,7 @@ bool OpenWorld(std::string FilePath)
 
 #ifdef PGEFL_CALLBACK_API
     WorldLoadCallbacks callbacks = OpenWorld_SetupCallbacks(load);
-    if(!FileFormats::OpenWorldFileT(in, callbacks))
+    if(!ParseCache::openWorldFile(in, FilePath, callbacks))
     {
         pLogDebug("Failed to load [%s]", FilePath.c_str());
         return false;
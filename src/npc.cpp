@@ -39,10 +39,12 @@
 #include "layers.h"
 
 #include "npc/npc_queues.h"
+#include "npc/npc_riders.h"
 #include "npc/npc_activation.h"
 #include "npc/section_overlap.h"
 #include "npc/npc_cockpit_bits.h"
 #include "npc/npc_update/npc_update_priv.h"
+#include "player/player_index.h"
 
 void NPC_t::ResetLocation()
 {
@@ -74,28 +76,23 @@ num_t NPCPlayerTargetDist(const NPC_t& npc, const Player_t& player)
         return num_t::abs(dx);
 }
 
-int NPCTargetPlayer(const NPC_t& npc)
+num_t NPCPlayerTargetDistBound(num_t abs_dx)
 {
-    int target_plr = 0;
-    num_t min_dist = 0;
-
-    for(int B = 1; B <= numPlayers; B++)
-    {
-        if(!Player[B].Dead && Player[B].Section == npc.Section)
-        {
-            if(numPlayers == 1)
-                return 1;
+    if(g_config.fix_multiplayer_targeting)
+        return num_t::dist2(abs_dx, 0);
+    else
+        return abs_dx;
+}
 
-            num_t dist = NPCPlayerTargetDist(npc, Player[B]);
-            if(min_dist == 0 || dist < min_dist)
-            {
-                min_dist = dist;
-                target_plr = B;
-            }
-        }
-    }
+int NPCTargetPlayer(const NPC_t& npc)
+{
+    if(numPlayers == 1)
+        return (!Player[1].Dead && Player[1].Section == npc.Section) ? 1 : 0;
 
-    return target_plr;
+    return PlayerIndex::nearest(npc.Location.X + npc.Location.Width / 2,
+        [&npc](int B) { return !Player[B].Dead && Player[B].Section == npc.Section; },
+        [&npc](int B) { return NPCPlayerTargetDist(npc, Player[B]); },
+        NPCPlayerTargetDistBound);
 }
 
 int NPCFaceNearestPlayer(NPC_t& npc, bool old_version)
@@ -2960,7 +2957,10 @@ void NPCSpecial(int A)
                             TurnNPCsIntoCoins();
 
                             if(g_ClonedPlayerMode)
+                            {
                                 Player[1] = Player[A];
+                                NPCRiders::rebuild();
+                            }
 
                             for(int j = 1; j <= numPlayers; j++)
                             {
@@ -2976,6 +2976,8 @@ void NPCSpecial(int A)
                                 Player[j].Effect2 = -i;
                             }
 
+                            PlayerIndex::invalidate();
+
                             StopMusic();
 
                             if(npc.Type == NPCID_FLAG_EXIT)
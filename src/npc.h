@@ -97,6 +97,9 @@ bool NPCBansWings(const NPC_t& npc);
 // totally new function, used for compatibility (in compat mode, horizontal distance; in modern mode, squared Euclidean distance)
 num_t NPCPlayerTargetDist(const NPC_t& npc, const Player_t& player);
 
+// lower bound of NPCPlayerTargetDist for a player whose center is abs_dx away horizontally
+num_t NPCPlayerTargetDistBound(num_t abs_dx);
+
 // totally new function covering old logic. returns nearest player (using NPCPlayerTargetDist) that is not Dead and is in NPC's section.
 int NPCTargetPlayer(const NPC_t& npc);
 
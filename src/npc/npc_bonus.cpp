@@ -38,6 +38,8 @@
 #include "main/level_medals.h"
 
 #include "npc/npc_queues.h"
+#include "npc/npc_riders.h"
+#include "player/player_index.h"
 
 #include "../controls.h"
 
@@ -310,6 +312,8 @@ void TouchBonus(int A, int B)
             std::swap(p_touched.Direction, p_target.Direction);
             std::swap(p_touched.Slope, p_target.Slope);
             std::swap(p_touched.StandingOnNPC, p_target.StandingOnNPC);
+            NPCRiders::rebuild();
+            PlayerIndex::invalidate();
 
             // make players immune
             if(p_touched.Immune < 10)
@@ -678,7 +682,10 @@ void TouchBonus(int A, int B)
             TurnNPCsIntoCoins();
             FreezeNPCs = false;
             if(g_ClonedPlayerMode)
+            {
                 Player[1] = Player[A];
+                NPCRiders::rebuild();
+            }
         }
 
         if(NPC[B].Type == NPCID_ITEMGOAL)
@@ -28,6 +28,7 @@
 #include "npc_traits.h"
 
 #include "main/trees.h"
+#include "player/player_index.h"
 
 static void s_makeHeavySparkle(const NPC_t& n, int offY)
 {
@@ -137,23 +138,14 @@ void NPCFrames(int A)
     {
         int new_frame = 0;
 
-        num_t min_dist = 0;
-        for(int B = 1; B <= numPlayers; B++)
-        {
-            if(!Player[B].Dead && Player[B].Section == NPC[A].Section && Player[B].TimeToLive == 0)
-            {
-                auto L1_dist = num_t::abs(NPC[A].Location.minus_center_x(Player[B].Location)) + num_t::abs(NPC[A].Location.minus_center_y(Player[B].Location));
-                if(min_dist == 0 || L1_dist < min_dist)
-                {
-                    min_dist = L1_dist;
+        const NPC_t& npc = NPC[A];
+        int target_plr = PlayerIndex::nearest(npc.Location.X + npc.Location.Width / 2,
+            [&npc](int B) { return !Player[B].Dead && Player[B].Section == npc.Section && Player[B].TimeToLive == 0; },
+            [&npc](int B) { return num_t::abs(npc.Location.minus_center_x(Player[B].Location)) + num_t::abs(npc.Location.minus_center_y(Player[B].Location)); },
+            [](num_t abs_dx) { return abs_dx; });
 
-                    if(Player[B].Character == 5)
-                        new_frame = 1;
-                    else
-                        new_frame = 0;
-                }
-            }
-        }
+        if(target_plr && Player[target_plr].Character == 5)
+            new_frame = 1;
 
         if(new_frame != NPC[A].Frame)
         {
@@ -862,13 +854,13 @@ void NPCFrames(int A)
         if(NPC[A].Special == 1)
             NPC[A].Frame = 2;
 
-        for(int B = 1; B <= numPlayers; ++B)
+        // CanComeOut is false only for players within 32px horizontally
+        const Location_t& loc = NPC[A].Location;
+
+        if(PlayerIndex::anyNear(loc.X - 32, loc.X + loc.Width + 32,
+            [&loc](int B) { return !CanComeOut(loc, Player[B].Location) && Player[B].Location.Y >= loc.Y; }))
         {
-            if(!CanComeOut(NPC[A].Location, Player[B].Location) && Player[B].Location.Y >= NPC[A].Location.Y)
-            {
-                NPC[A].Frame = 2;
-                break;
-            }
+            NPC[A].Frame = 2;
         }
 
         if(NPC[A].Frame == 0)
@@ -877,13 +869,10 @@ void NPCFrames(int A)
             tempLocation.Width = NPC[A].Location.Width * 2;
             tempLocation.X = NPC[A].Location.X - NPC[A].Location.Width / 2;
 
-            for(int B = 1; B <= numPlayers; ++B)
+            if(PlayerIndex::anyNear(tempLocation.X - 32, tempLocation.X + tempLocation.Width + 32,
+                [&tempLocation, &loc](int B) { return !CanComeOut(tempLocation, Player[B].Location) && Player[B].Location.Y >= loc.Y; }))
             {
-                if(!CanComeOut(tempLocation, Player[B].Location) && Player[B].Location.Y >= NPC[A].Location.Y)
-                {
-                    NPC[A].Frame = 1;
-                    break;
-                }
+                NPC[A].Frame = 1;
             }
         }
     }
@@ -1987,27 +1976,23 @@ void NPCFrames(int A)
                 Location_t tempLocation = NPC[A].Location;
                 tempLocation.Height = 24;
                 tempLocation.Y -= 8;
-                for(int B = 1; B <= numPlayers; ++B)
+
+                auto bouncing_on = [&tempLocation](int B)
                 {
-                    if(CheckCollision(tempLocation, Player[B].Location) && Player[B].Mount != 2 && (Player[B].Location.SpeedY > 0 || Player[B].Location.SpeedY < Physics.PlayerJumpVelocity))
-                    {
-                        C = 2;
-                        break;
-                    }
-                }
+                    return CheckCollision(tempLocation, Player[B].Location) && Player[B].Mount != 2 && (Player[B].Location.SpeedY > 0 || Player[B].Location.SpeedY < Physics.PlayerJumpVelocity);
+                };
+
+                if(PlayerIndex::anyNear(tempLocation.X, tempLocation.X + tempLocation.Width, bouncing_on))
+                    C = 2;
+
                 if(C == 0)
                 {
                     tempLocation = NPC[A].Location;
                     tempLocation.Height = 32;
                     tempLocation.Y -= 16;
-                    for(int B = 1; B <= numPlayers; ++B)
-                    {
-                        if(CheckCollision(tempLocation, Player[B].Location) && Player[B].Mount != 2 && (Player[B].Location.SpeedY > 0 || Player[B].Location.SpeedY < Physics.PlayerJumpVelocity))
-                        {
-                            C = 1;
-                            break;
-                        }
-                    }
+
+                    if(PlayerIndex::anyNear(tempLocation.X, tempLocation.X + tempLocation.Width, bouncing_on))
+                        C = 1;
                 }
                 NPC[A].Frame = C;
             }
@@ -36,7 +36,9 @@
 #include "sdl_proxy/sdl_stdinc.h"
 
 #include "npc/npc_queues.h"
+#include "npc/npc_riders.h"
 
+#include "main/block_type_index.h"
 #include "main/game_loop_interrupt.h"
 
 static void s_makeSparkles(const NPC_t& npc, int speed_random, int speed_mult)
@@ -140,13 +142,7 @@ bool KillNPC(int A, int B)
             if(NPC[A].Type == NPCID_YELSWITCH_FODDER || NPC[A].DefaultType == NPCID_YELSWITCH_FODDER)
             {
                 PlaySoundSpatial(SFX_PSwitch, NPC[A].Location);
-                for(C = 1; C <= numBlock; C++)
-                {
-                    if(Block[C].Type == 171)
-                        Block[C].Type = 172;
-                    else if(Block[C].Type == 172)
-                        Block[C].Type = 171;
-                }
+                BlockTypeIndex::swapAll(171, 172);
                 for(C = 1; C <= numNPCs; C++)
                 {
                     if(NPC[C].Type == NPCID_YEL_PLATFORM)
@@ -156,13 +152,7 @@ bool KillNPC(int A, int B)
             else if(NPC[A].Type == NPCID_BLUSWITCH_FODDER || NPC[A].DefaultType == NPCID_BLUSWITCH_FODDER)
             {
                 PlaySoundSpatial(SFX_PSwitch, NPC[A].Location);
-                for(C = 1; C <= numBlock; C++)
-                {
-                    if(Block[C].Type == 174)
-                        Block[C].Type = 175;
-                    else if(Block[C].Type == 175)
-                        Block[C].Type = 174;
-                }
+                BlockTypeIndex::swapAll(174, 175);
                 for(C = 1; C <= numNPCs; C++)
                 {
                     if(NPC[C].Type == NPCID_BLU_PLATFORM)
@@ -172,13 +162,7 @@ bool KillNPC(int A, int B)
             else if(NPC[A].Type == NPCID_GRNSWITCH_FODDER || NPC[A].DefaultType == NPCID_GRNSWITCH_FODDER)
             {
                 PlaySoundSpatial(SFX_PSwitch, NPC[A].Location);
-                for(C = 1; C <= numBlock; C++)
-                {
-                    if(Block[C].Type == 177)
-                        Block[C].Type = 178;
-                    else if(Block[C].Type == 178)
-                        Block[C].Type = 177;
-                }
+                BlockTypeIndex::swapAll(177, 178);
                 for(C = 1; C <= numNPCs; C++)
                 {
                     if(NPC[C].Type == NPCID_GRN_PLATFORM)
@@ -188,13 +172,7 @@ bool KillNPC(int A, int B)
             else if(NPC[A].Type == NPCID_REDSWITCH_FODDER || NPC[A].DefaultType == NPCID_REDSWITCH_FODDER)
             {
                 PlaySoundSpatial(SFX_PSwitch, NPC[A].Location);
-                for(C = 1; C <= numBlock; C++)
-                {
-                    if(Block[C].Type == 180)
-                        Block[C].Type = 181;
-                    else if(Block[C].Type == 181)
-                        Block[C].Type = 180;
-                }
+                BlockTypeIndex::swapAll(180, 181);
                 for(C = 1; C <= numNPCs; C++)
                 {
                     if(NPC[C].Type == NPCID_RED_PLATFORM)
@@ -1575,21 +1553,28 @@ resume_TriggerLast:
 
     if((!GameMenu && !BattleMode) || NPC[A].DefaultType == 0)
     {
-        for(B = 1; B <= numPlayers; B++) // Tell the player to stop standing on me because im dead kthnx
+        // Tell the player to stop standing on me because im dead kthnx
+        NPCRiders::for_each(A, [A](int plr)
+        {
+            Player[plr].StandingOnNPC = 0;
+            NPCRiders::set(plr, 0);
+
+            if(NPC[A].Type != NPCID_VEHICLE)
+                Player[plr].Location.SpeedY = NPC[A].Location.SpeedY;
+        });
+
+        // the last NPC moves into the freed slot
+        if(A != numNPCs)
         {
-            if(Player[B].StandingOnNPC == A)
+            NPCRiders::move(numNPCs, A);
+
+            for(B = 1; B <= numPlayers; B++)
             {
-                Player[B].StandingOnNPC = 0;
-                if(NPC[A].Type != NPCID_VEHICLE)
-                    Player[B].Location.SpeedY = NPC[A].Location.SpeedY;
+                if(Player[B].YoshiNPC == numNPCs)
+                    Player[B].YoshiNPC = A;
+                if(Player[B].VineNPC == numNPCs)
+                    Player[B].VineNPC = A;
             }
-            else if(Player[B].StandingOnNPC == numNPCs)
-                Player[B].StandingOnNPC = A;
-
-            if(Player[B].YoshiNPC == numNPCs)
-                Player[B].YoshiNPC = A;
-            if(Player[B].VineNPC == numNPCs)
-                Player[B].VineNPC = A;
         }
 
         SDL_assert_release(A > 0);
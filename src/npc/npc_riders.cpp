@@ -0,0 +1,135 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+
+#include "sdl_proxy/sdl_assert.h"
+
+#include "globals.h"
+
+#include "npc/npc_riders.h"
+
+namespace NPCRiders
+{
+
+// first player of each NPC's list
+static std::array<vbint_t, maxNPCs + 1> s_head;
+
+// list links of each player, and the NPC whose list the player is in
+static std::array<vbint_t, maxPlayers + 1> s_on;
+static std::array<vbint_t, maxPlayers + 1> s_prev;
+static std::array<vbint_t, maxPlayers + 1> s_next;
+
+static void s_unlink(int plr)
+{
+    int npc = s_on[plr];
+
+    if(npc == 0)
+        return;
+
+    if(s_prev[plr])
+        s_next[s_prev[plr]] = s_next[plr];
+    else
+        s_head[npc] = s_next[plr];
+
+    if(s_next[plr])
+        s_prev[s_next[plr]] = s_prev[plr];
+
+    s_on[plr] = 0;
+    s_prev[plr] = 0;
+    s_next[plr] = 0;
+}
+
+static void s_link(int plr, int npc)
+{
+    s_on[plr] = (vbint_t)npc;
+    s_prev[plr] = 0;
+    s_next[plr] = s_head[npc];
+
+    if(s_head[npc])
+        s_prev[s_head[npc]] = (vbint_t)plr;
+
+    s_head[npc] = (vbint_t)plr;
+}
+
+void clear()
+{
+    s_head.fill(0);
+    s_on.fill(0);
+    s_prev.fill(0);
+    s_next.fill(0);
+}
+
+void rebuild()
+{
+    clear();
+
+    for(int B = 1; B <= numPlayers; B++)
+    {
+        if(Player[B].StandingOnNPC > 0 && Player[B].StandingOnNPC <= maxNPCs)
+            s_link(B, Player[B].StandingOnNPC);
+    }
+}
+
+void set(int plr, int npc)
+{
+    SDL_assert(plr > 0 && plr <= maxPlayers);
+
+    if(s_on[plr] == npc)
+        return;
+
+    s_unlink(plr);
+
+    if(npc > 0 && npc <= maxNPCs)
+        s_link(plr, npc);
+}
+
+void move(int from, int to)
+{
+    for(int B = s_head[from]; B != 0; )
+    {
+        int next_B = s_next[B];
+
+        if(Player[B].StandingOnNPC == from)
+        {
+            Player[B].StandingOnNPC = (vbint_t)to;
+            set(B, to);
+        }
+        else
+            s_unlink(B);
+
+        B = next_B;
+    }
+}
+
+int first(int npc)
+{
+    if(npc <= 0 || npc > maxNPCs)
+        return 0;
+
+    return s_head[npc];
+}
+
+int next(int plr)
+{
+    return s_next[plr];
+}
+
+} // namespace NPCRiders
@@ -0,0 +1,94 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef NPC_RIDERS_H
+#define NPC_RIDERS_H
+
+/*
+ * Reverse index of Player[B].StandingOnNPC: the players standing on each NPC,
+ * used instead of scanning the whole player array to find an NPC's riders.
+ *
+ * Each NPC has a linked list of the players that were set to stand on it.
+ * Resetting StandingOnNPC to 0 (or to a vehicle) doesn't need to be reported:
+ * the lists are validated against StandingOnNPC when iterated, and a player
+ * leaves the old list once it is set to stand on something else.
+ *
+ * Maintenance rules:
+ *   - Player[B].StandingOnNPC = A (A > 0) -> NPCRiders::set(B, A);
+ *   - NPC[to] = NPC[from] with the riders remapped -> NPCRiders::move(from, to);
+ *   - Player_t copied, swapped, or reordered -> NPCRiders::rebuild();
+ */
+
+#include "globals.h"
+
+namespace NPCRiders
+{
+
+void clear();
+void rebuild();
+
+void set(int plr, int npc);
+
+// makes the riders of NPC `from` stand on NPC `to`, updating their StandingOnNPC
+void move(int from, int to);
+
+// first player of the NPC's list (might be outdated), or 0
+int first(int npc);
+// next player of the same list, or 0
+int next(int plr);
+
+/**
+ * \brief calls func(B) for each player B with Player[B].StandingOnNPC == npc
+ *
+ * func may change the player's StandingOnNPC
+ **/
+template<class Func>
+inline void for_each(int npc, Func func)
+{
+    for(int B = first(npc); B != 0; )
+    {
+        int next_B = next(B);
+
+        if(Player[B].StandingOnNPC == npc)
+            func(B);
+
+        B = next_B;
+    }
+}
+
+/**
+ * \brief checks if any player is standing on the NPC
+ **/
+inline bool any(int npc)
+{
+    for(int B = first(npc); B != 0; B = next(B))
+    {
+        if(Player[B].StandingOnNPC == npc)
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace NPCRiders
+
+#endif // NPC_RIDERS_H
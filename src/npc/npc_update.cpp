@@ -51,6 +51,7 @@
 #include "npc/npc_queues.h"
 #include "npc/section_overlap.h"
 #include "npc/npc_update/npc_update_priv.h"
+#include "player/player_index.h"
 
 // moved into the function, as a static array
 // static RangeArr<int, 0, maxNPCs> newAct;
@@ -429,14 +430,8 @@ resume_Activation_Generator:
         if(NPC[A].Type == NPCID_CONVEYOR && !NPC[A].Hidden)
         {
             CheckSectionNPC(A);
-            bool sameSection = false;
-            for(int B = 1; B <= numPlayers; B++)
-            {
-                if(Player[B].Section == NPC[A].Section)
-                    sameSection = true;
-            }
 
-            if(sameSection)
+            if(PlayerIndex::anyInSection(NPC[A].Section))
             {
                 NPC[A].TimeLeft = 100;
                 NPC[A].Active = true;
@@ -1131,17 +1126,14 @@ interrupt_Activation:
 
             if(NPC[A].Text != STRINGINDEX_NONE)
             {
-                NPC[A].Chat = false;
                 Location_t tempLocation = NPC[A].Location;
                 tempLocation.Y -= 25;
                 tempLocation.Height += 50;
                 tempLocation.X -= 25;
                 tempLocation.Width += 50;
-                for(int B = 1; B <= numPlayers; B++)
-                {
-                    if(CheckCollision(tempLocation, Player[B].Location))
-                        NPC[A].Chat = true;
-                }
+
+                NPC[A].Chat = PlayerIndex::anyNear(tempLocation.X, tempLocation.X + tempLocation.Width,
+                    [&tempLocation](int B) { return CheckCollision(tempLocation, Player[B].Location); });
             }
 
             // oldDirection = NPC[A].Direction;
@@ -1175,14 +1167,7 @@ interrupt_Activation:
                  NPC[A].Type == NPCID_GRN_PLATFORM || NPC[A].Type == NPCID_RED_PLATFORM || NPC[A].Type == NPCID_VILLAIN_S3 || NPCIsYoshi(NPC[A])) &&
                  NPC[A].HoldingPlayer == 0)
             {
-                int C = 0;
-                for(int B = 1; B <= numPlayers; B++)
-                {
-                    if(Player[B].Section == NPC[A].Section)
-                        C = 1;
-                }
-
-                if(C == 0 && NPC[A].TimeLeft > 1)
+                if(!PlayerIndex::anyInSection(NPC[A].Section) && NPC[A].TimeLeft > 1)
                     NPC[A].TimeLeft = 0;
             }
 
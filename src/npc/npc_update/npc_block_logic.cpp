@@ -23,6 +23,7 @@
 #include "npc.h"
 #include "npc_traits.h"
 #include "npc/npc_queues.h"
+#include "npc/npc_riders.h"
 #include "config.h"
 #include "collision.h"
 #include "layers.h"
@@ -31,6 +32,7 @@
 #include "blk_id.h"
 
 #include "main/trees.h"
+#include "main/block_type_index.h"
 
 void NPCBlockLogic(int A, num_t& tempHit, int& tempHitBlock, tempf_t& tempSpeedA, const int numTempBlock, const tempf_t speedVar)
 {
@@ -270,7 +272,10 @@ void NPCBlockLogic(int A, num_t& tempHit, int& tempHitBlock, tempf_t& tempSpeedA
                                             {
                                                 NPCHit(A, 3, A);
                                                 if(Block[B].Type == 621)
+                                                {
                                                     Block[B].Type = 109;
+                                                    BlockTypeIndex::update(B);
+                                                }
                                                 else
                                                 {
                                                     Block[B].Layer = LAYER_DESTROYED_BLOCKS;
@@ -1003,14 +1008,8 @@ void NPCBlockLogic(int A, num_t& tempHit, int& tempHitBlock, tempf_t& tempSpeedA
                                                     {
                                                         if(NPC[A].Slope == 0)
                                                             NPC[A].Location.SpeedY = -NPC[A].Location.SpeedY / 2;
-                                                        for(int C = 1; C <= numPlayers; C++)
-                                                        {
-                                                            if(Player[C].StandingOnNPC == A)
-                                                            {
-                                                                NPC[A].Location.SpeedY = 0;
-                                                                break;
-                                                            }
-                                                        }
+                                                        if(NPCRiders::any(A))
+                                                            NPC[A].Location.SpeedY = 0;
 
                                                     }
                                                     else if(NPC[A].Type == NPCID_METALBARREL || NPC[A].Type == NPCID_CANNONENEMY || NPC[A].Type == NPCID_HPIPE_SHORT || NPC[A].Type == NPCID_HPIPE_LONG || NPC[A].Type == NPCID_VPIPE_SHORT || NPC[A].Type == NPCID_VPIPE_LONG || (NPC[A].Type >= NPCID_TANK_TREADS && NPC[A].Type <= NPCID_SLANT_WOOD_M))
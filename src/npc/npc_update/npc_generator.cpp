@@ -32,6 +32,7 @@
 
 #include "npc/npc_queues.h"
 #include "npc/npc_update/npc_update_priv.h"
+#include "player/player_index.h"
 
 // returns true if an NPC should be generated
 bool NPCGeneratorLogic(int A)
@@ -64,17 +65,10 @@ bool NPCGeneratorLogic(int A)
         // check if blocked by players
         if(NPC[A].Type != NPCID_ITEM_BURIED && !blocked)
         {
-            for(int B = 1; B <= numPlayers; B++)
-            {
-                if(!Player[B].Dead && Player[B].TimeToLive == 0)
-                {
-                    if(CheckCollision(NPC[A].Location, Player[B].Location))
-                    {
-                        blocked = true;
-                        break;
-                    }
-                }
-            }
+            const Location_t& loc = NPC[A].Location;
+
+            blocked = PlayerIndex::anyNear(loc.X, loc.X + loc.Width,
+                [&loc](int B) { return !Player[B].Dead && Player[B].TimeToLive == 0 && CheckCollision(loc, Player[B].Location); });
         }
 
         // check if blocked by blocks
@@ -28,6 +28,7 @@
 #include "npc/npc_update/npc_update_priv.h"
 
 #include "main/trees.h"
+#include "player/player_index.h"
 
 void NPCMovementLogic(int A, tempf_t& speedVar)
 {
@@ -674,20 +675,13 @@ void NPCMovementLogic_Wings(int A, const num_t speedVar)
 
         NPC[A].Projectile = false;
 
-        int target_plr = 0;
-        num_t min_dist = 0;
-        for(int B = 1; B <= numPlayers; B++)
-        {
-            if(!Player[B].Dead && Player[B].Section == NPC[A].Section && Player[B].TimeToLive == 0 && NPC[A].CantHurtPlayer != B)
-            {
-                num_t dist = NPCPlayerTargetDist(NPC[A], Player[B]);
-                if(min_dist == 0 || dist < min_dist)
-                {
-                    min_dist = dist;
-                    target_plr = B;
-                }
-            }
-        }
+        const NPC_t& npc = NPC[A];
+        int target_plr = PlayerIndex::nearest(npc.Location.X + npc.Location.Width / 2,
+            [&npc](int B) { return !Player[B].Dead && Player[B].Section == npc.Section && Player[B].TimeToLive == 0 && npc.CantHurtPlayer != B; },
+            [&npc](int B) { return NPCPlayerTargetDist(npc, Player[B]); },
+            NPCPlayerTargetDistBound);
+
+        num_t min_dist = target_plr ? NPCPlayerTargetDist(npc, Player[target_plr]) : num_t(0);
 
         if(NPC[A].Wings && target_plr == 0 && NPC[A].CantHurtPlayer)
             target_plr = NPC[A].CantHurtPlayer;
@@ -36,6 +36,7 @@
 #include "eff_id.h"
 #include "npc_traits.h"
 #include "sound.h"
+#include "sound_thread.h"
 #include "game_main.h"
 #include "effect.h"
 #include "blocks.h"
@@ -53,6 +54,8 @@
 #include "script/luna/lunacounter.h"
 
 #include "npc/npc_queues.h"
+#include "npc/npc_riders.h"
+#include "player/player_index.h"
 
 #include "controls.h"
 
@@ -1177,6 +1180,9 @@ void PlayerDead(int A)
 {
     Controls::Rumble(A, 400, 0.8f);
 
+    // the player may get moved away
+    PlayerIndex::invalidate();
+
     g_curLevelMedals.on_any_death();
 
     bool tempBool = false;
@@ -1264,6 +1270,9 @@ void KillPlayer(const int A)
 {
     auto &p = Player[A];
 
+    // the player may get moved away or respawned
+    PlayerIndex::invalidate();
+
     p.Location.SpeedX = 0;
     p.Location.SpeedY = 0;
     p.State = 1;
@@ -1528,6 +1537,8 @@ void EveryonesDead()
     {
 //    if(MagicHand)
 //        BitBlt frmLevelWindow::vScreen[1].hdc, 0, 0, frmLevelWindow::vScreen[1].ScaleWidth, frmLevelWindow::vScreen[1].ScaleHeight, 0, 0, 0, vbWhiteness;
+        FlushSfx();
+
         if(!g_config.unlimited_framerate)
             PGE_Delay(500);
     }
@@ -1629,6 +1640,9 @@ void CheckSection(const int A)
 
     auto &p = Player[A];
 
+    // the section may change
+    PlayerIndex::invalidate();
+
     int oldSection = p.Section;
     int foundSection_loop = 0;
 
@@ -3666,6 +3680,7 @@ void PlayerDismount(const int A)
             if(Player[B].StandingOnVehiclePlr && (g_ClonedPlayerMode || Player[B].StandingOnVehiclePlr == A))
             {
                 Player[B].StandingOnNPC = numNPCs;
+                NPCRiders::set(B, numNPCs);
                 Player[B].StandingOnVehiclePlr = 0;
             }
         }
@@ -4266,6 +4281,8 @@ void RespawnPlayer(int A, int Direction, num_t CenterX, num_t StopY, const vScre
     Player[A].RespawnY = StopY - Player[A].Location.Height;
     Player[A].Location.Y = -target_screen.Y - Player[A].Location.Height;
     Player[A].Location.X = CenterX - Player[A].Location.Width / 2;
+
+    PlayerIndex::invalidate();
 }
 
 void RespawnPlayerTo(int A, int TargetPlayer)
@@ -4481,6 +4498,7 @@ void ClownCar()
             if(Player[B].StandingOnVehiclePlr && (g_ClonedPlayerMode || Player[B].StandingOnVehiclePlr == A))
             {
                 Player[B].StandingOnNPC = numNPCs;
+                NPCRiders::set(B, numNPCs);
                 Player[B].Location.X += num_t(p.mountBump);
 
                 if(Player[B].Effect != PLREFF_NORMAL)
@@ -5329,6 +5347,7 @@ void PlayerGrabCode(const int A, bool DontResetGrabTime)
                     p.Location.Y = NPC[p.HoldingNPC].Location.Y - p.Location.Height;
                     NPC[p.HoldingNPC].Location.SpeedY = p.Location.SpeedY;
                     p.StandingOnNPC = p.HoldingNPC;
+                    NPCRiders::set(A, p.HoldingNPC);
                     p.HoldingNPC = 0;
                     p.ShellSurf = true;
                     p.Jump = 0;
@@ -6895,6 +6914,7 @@ void DropPlayer(const int A)
     }
 
     numPlayers --;
+    NPCRiders::rebuild();
 
     // remove player from screens
     Screens_DropPlayer(A);
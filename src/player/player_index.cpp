@@ -0,0 +1,137 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+
+#include "player/player_index.h"
+
+namespace PlayerIndex
+{
+
+// below this count the plain loops are faster than the index
+static constexpr int c_minPlayers = 5;
+
+static bool s_active = false;
+static bool s_valid = false;
+static int s_numPlayers = 0;
+
+static std::vector<Entry_t> s_entries;
+static num_t s_maxWidth = 0;
+static num_t s_maxHalfWidth = 0;
+static std::array<int, maxSections + 1> s_sectionCount;
+
+static void s_build()
+{
+    s_entries.clear();
+    s_sectionCount.fill(0);
+    s_maxWidth = 0;
+    s_maxHalfWidth = 0;
+
+    for(int B = 1; B <= numPlayers; B++)
+    {
+        const Player_t& p = Player[B];
+
+        s_entries.push_back({p.Location.X, (vbint_t)B});
+
+        if(p.Location.Width > s_maxWidth)
+            s_maxWidth = p.Location.Width;
+
+        if(p.Section >= 0 && p.Section <= maxSections)
+            s_sectionCount[p.Section]++;
+    }
+
+    s_maxHalfWidth = s_maxWidth / 2;
+
+    std::sort(s_entries.begin(), s_entries.end(),
+    [](const Entry_t& a, const Entry_t& b)
+    {
+        return a.x < b.x || (a.x == b.x && a.plr < b.plr);
+    });
+
+    s_numPlayers = numPlayers;
+    s_valid = true;
+}
+
+void begin()
+{
+    s_active = true;
+    s_valid = false;
+}
+
+void end()
+{
+    s_active = false;
+    s_valid = false;
+}
+
+void invalidate()
+{
+    s_valid = false;
+}
+
+bool ready()
+{
+    if(!s_active || numPlayers < c_minPlayers)
+        return false;
+
+    if(!s_valid || s_numPlayers != numPlayers)
+        s_build();
+
+    return true;
+}
+
+void candidates(num_t left, num_t right, const Entry_t*& first, const Entry_t*& last)
+{
+    num_t lower = left - s_maxWidth - c_margin;
+    num_t upper = right + c_margin;
+
+    auto it_first = std::lower_bound(s_entries.begin(), s_entries.end(), lower,
+        [](const Entry_t& e, num_t x) { return e.x < x; });
+
+    auto it_last = std::upper_bound(it_first, s_entries.end(), upper,
+        [](num_t x, const Entry_t& e) { return x < e.x; });
+
+    first = s_entries.data() + (it_first - s_entries.begin());
+    last = s_entries.data() + (it_last - s_entries.begin());
+}
+
+void all(const Entry_t*& first, const Entry_t*& last, num_t& max_half_width)
+{
+    first = s_entries.data();
+    last = s_entries.data() + s_entries.size();
+    max_half_width = s_maxHalfWidth;
+}
+
+bool anyInSection(int section)
+{
+    if(ready())
+        return section >= 0 && section <= maxSections && s_sectionCount[section] > 0;
+
+    for(int B = 1; B <= numPlayers; B++)
+    {
+        if(Player[B].Section == section)
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace PlayerIndex
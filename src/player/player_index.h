@@ -0,0 +1,205 @@
+/*
+ * TheXTech - A platform game engine ported from old source code for VB6
+ *
+ * Copyright (c) 2009-2011 Andrew Spinks, original VB6 code
+ * Copyright (c) 2020-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef PLAYER_INDEX_H
+#define PLAYER_INDEX_H
+
+/*
+ * Index of the players used by the NPC update, to avoid scanning the whole
+ * player array for every NPC in large multiplayer sessions.
+ *
+ * The index is built at begin() and dropped at end(), which wrap UpdateNPCs().
+ * Players don't move within that scope except for teleports, and the code
+ * performing them (or changing a player's section) calls invalidate() so that
+ * the index gets rebuilt at the next query. Small horizontal changes (such as
+ * the size changes on power-down) are covered by a margin.
+ *
+ * Outside of the scope, or with few players, the helpers below run the plain
+ * loops, and in all cases they return the same result as the VB6-style loops
+ * they replace.
+ */
+
+#include <vector>
+
+#include "globals.h"
+
+namespace PlayerIndex
+{
+
+struct Entry_t
+{
+    num_t x;
+    vbint_t plr;
+};
+
+void begin();
+void end();
+
+// call after teleporting a player, changing their section, or reordering the player array
+void invalidate();
+
+// returns true if the index is in use (rebuilds it if needed)
+bool ready();
+
+// returns the range of entries whose players may horizontally overlap the [left, right] range
+void candidates(num_t left, num_t right, const Entry_t*& first, const Entry_t*& last);
+
+// returns the range of entries sorted by X, and the maximum half width of the players
+void all(const Entry_t*& first, const Entry_t*& last, num_t& max_half_width);
+
+// horizontal distance by which the players may have moved since the index was built
+static constexpr int c_margin = 32;
+
+/**
+ * \brief checks whether any player is in the section
+ **/
+bool anyInSection(int section);
+
+/**
+ * \brief checks whether pred(B) holds for any player
+ *
+ * pred(B) MUST be false for players that don't horizontally overlap the [left, right] range
+ **/
+template<class Pred>
+inline bool anyNear(num_t left, num_t right, Pred pred)
+{
+    if(!ready())
+    {
+        for(int B = 1; B <= numPlayers; B++)
+        {
+            if(pred(B))
+                return true;
+        }
+
+        return false;
+    }
+
+    const Entry_t* first;
+    const Entry_t* last;
+    candidates(left, right, first, last);
+
+    for(; first != last; ++first)
+    {
+        if(pred((int)first->plr))
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * \brief finds the nearest player, with the same result as the VB6-style loop
+ *
+ *     for(B = 1; B <= numPlayers; B++)
+ *         if(filter(B) && (min_dist == 0 || dist(B) < min_dist))
+ *             { min_dist = dist(B); target = B; }
+ *
+ * \param center_x horizontal center of the searching object
+ * \param filter checks if a player may be targeted
+ * \param dist distance to the player
+ * \param bound lower bound of dist for a player whose center is abs_dx away horizontally, must not decrease with abs_dx
+ * \return index of the player, or 0 if none found
+ **/
+template<class Filter, class Dist, class Bound>
+inline int nearest(num_t center_x, Filter filter, Dist dist, Bound bound)
+{
+    if(ready())
+    {
+        const Entry_t* first;
+        const Entry_t* last;
+        num_t max_half_width;
+        all(first, last, max_half_width);
+
+        // entries to the left of the center are scanned downwards, others upwards
+        const Entry_t* right = first;
+        while(right != last && right->x < center_x)
+            ++right;
+
+        const Entry_t* left = right;
+
+        int target = 0;
+        num_t min_dist = 0;
+        bool zero_found = false;
+
+        while(left != first || right != last)
+        {
+            // horizontal distances of the closest remaining entries on both sides
+            num_t dx_left = (left != first) ? center_x - (left - 1)->x - max_half_width - c_margin : num_t(-1);
+            num_t dx_right = (right != last) ? right->x - center_x - c_margin : num_t(-1);
+
+            bool use_left = (right == last) || (left != first && dx_left < dx_right);
+            num_t dx = use_left ? dx_left : dx_right;
+
+            if(dx < 0)
+                dx = 0;
+
+            if(target && bound(dx) > min_dist)
+                break;
+
+            int B = use_left ? (int)(--left)->plr : (int)(right++)->plr;
+
+            if(!filter(B))
+                continue;
+
+            num_t d = dist(B);
+
+            // the VB6 loop doesn't treat zero distance as a match, defer to it
+            if(d == 0)
+            {
+                zero_found = true;
+                break;
+            }
+
+            if(!target || d < min_dist || (d == min_dist && B < target))
+            {
+                min_dist = d;
+                target = B;
+            }
+        }
+
+        if(!zero_found)
+            return target;
+    }
+
+    int target = 0;
+    num_t min_dist = 0;
+
+    for(int B = 1; B <= numPlayers; B++)
+    {
+        if(!filter(B))
+            continue;
+
+        num_t d = dist(B);
+
+        if(min_dist == 0 || d < min_dist)
+        {
+            min_dist = d;
+            target = B;
+        }
+    }
+
+    return target;
+}
+
+} // namespace PlayerIndex
+
+#endif // PLAYER_INDEX_H
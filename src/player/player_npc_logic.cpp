@@ -25,6 +25,7 @@
 #include "npc_id.h"
 #include "npc_traits.h"
 #include "npc/npc_queues.h"
+#include "npc/npc_riders.h"
 #include "sound.h"
 #include "editor.h"
 #include "effect.h"
@@ -1171,7 +1172,10 @@ void PlayerNPCLogic(int A, bool& tempSpring, bool& tempShell, int& MessageNPC, c
             Player[A].StandingOnVehiclePlr = 0;
 
         if(Player[A].Location.SpeedY >= 0)
+        {
             Player[A].StandingOnNPC = B;
+            NPCRiders::set(A, B);
+        }
 
         Player[A].Location.Y = NPC[B].Location.Y - Player[A].Location.Height;
 
@@ -1220,11 +1224,10 @@ void PlayerNPCLogic(int A, bool& tempSpring, bool& tempShell, int& MessageNPC, c
                 Player[A].HoldingNPC = 0;
                 Player[A].StandingOnNPC = 0;
                 PlaySoundSpatial(SFX_Stomp, Player[A].Location);
-                for(int C = 1; C <= numPlayers; ++C)
+                NPCRiders::for_each(B, [A](int C)
                 {
-                    if(Player[C].StandingOnNPC == B)
-                        Player[C].StandingOnVehiclePlr = A;
-                }
+                    Player[C].StandingOnVehiclePlr = A;
+                });
 
                 B = 0;
             }
@@ -172,6 +172,27 @@ static void s_CheckWarpLevelExit(Player_t& plr, const Warp_t& warp, int lvl_coun
     }
 }
 
+// start opening the music of the section behind a pipe or door while the warp animation is playing
+static void s_PrefetchWarpMusic(const Warp_t& warp, int A, const Location_t& exit)
+{
+    const Player_t& plr = Player[A];
+
+    if(GameMenu || warp.level != STRINGINDEX_NONE || warp.MapWarp || &ScreenByPlayer(A) != l_screen)
+        return;
+
+    if(SectionCollision(plr.Section, exit))
+        return;
+
+    for(int S = 0; S < numSections; S++)
+    {
+        if(SectionCollision(S, exit))
+        {
+            PrefetchSectionMusic(S);
+            break;
+        }
+    }
+}
+
 static void s_InitWarpScroll(Player_t& p, const Location_t& warp_enter, const Location_t& warp_exit, int min_frames = 0)
 {
     unsigned int warp_dist = (int)num_t::dist(warp_enter.X - warp_exit.X, warp_enter.Y - warp_exit.Y);
@@ -1514,6 +1535,7 @@ static inline bool checkWarp(Warp_t &warp, int B, Player_t &plr, int A, bool bac
             plr.Effect2 = 0;
         plr.Warp = B;
         plr.WarpBackward = backward;
+        s_PrefetchWarpMusic(warp, A, static_cast<Location_t>(exit));
 //                        if(nPlay.Online && A == nPlay.MySlot + 1)
 //                            Netplay::sendData Netplay::PutPlayerLoc(nPlay.MySlot) + "1j" + std::to_string(A) + "|" + plr.Warp + LB;
     }
@@ -1527,6 +1549,7 @@ static inline bool checkWarp(Warp_t &warp, int B, Player_t &plr, int A, bool bac
 
         plr.Warp = B;
         plr.WarpBackward = backward;
+        s_PrefetchWarpMusic(warp, A, static_cast<Location_t>(exit));
 //                        if(nPlay.Online && A == nPlay.MySlot + 1)
 //                            Netplay::sendData Netplay::PutPlayerLoc(nPlay.MySlot) + "1j" + std::to_string(A) + "|" + plr.Warp + LB;
         plr.Location.X = entrance.X + (entrance.Width - plr.Location.Width) / 2;
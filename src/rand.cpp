@@ -68,6 +68,30 @@ void random_set_ncalls(long ncalls)
     g_random_n_calls = ncalls;
 }
 
+static pcg32 s_saved_random_engine;
+static long s_saved_random_n_calls = 0;
+#ifdef DEBUG_RANDOM_CALLS
+static size_t s_saved_random_calls_size = 0;
+#endif
+
+void random_save_state()
+{
+    s_saved_random_engine = g_random_engine;
+    s_saved_random_n_calls = g_random_n_calls;
+#ifdef DEBUG_RANDOM_CALLS
+    s_saved_random_calls_size = g_random_calls.size();
+#endif
+}
+
+void random_load_state()
+{
+    g_random_engine = s_saved_random_engine;
+    g_random_n_calls = s_saved_random_n_calls;
+#ifdef DEBUG_RANDOM_CALLS
+    g_random_calls.resize(s_saved_random_calls_size);
+#endif
+}
+
 // Also note that many VB6 calls use dRand * x
 // and then assign the result to an Integer.
 // The result is NOT iRand(x) but rather vb6Round(dRand()*x),
@@ -56,6 +56,16 @@ extern long random_ncalls();
  */
 extern void random_set_ncalls(long ncalls);
 
+/**
+ * @brief Saves the state of the random number generator (one slot)
+ */
+extern void random_save_state();
+
+/**
+ * @brief Restores the state saved by random_save_state()
+ */
+extern void random_load_state();
+
 /**
  * @brief Random number generator in double format, between 0.0 to 1.0 (exclusive)
  * @return random double value
@@ -130,9 +130,69 @@ Autocode &Autocode::operator=(const Autocode &o)
     Activated = o.Activated;
     Expired = o.Expired;
 
+    m_memField = o.m_memField;
+    m_memAddress = o.m_memAddress;
+    m_refVar = o.m_refVar;
+    m_strVar = o.m_strVar;
+
+    m_seq = 0;
+    m_expireQueued = false;
+
     return *this;
 }
 
+void Autocode::Compile()
+{
+    switch(m_Type)
+    {
+    case AT_OnGlobalMem:
+    case AT_LoadGlobalVar:
+    case AT_MemAssign:
+        GlobalField();
+        ftype = StrToFieldtype(GetS(MyString));
+        break;
+
+    case AT_OnPlayerMem:
+    case AT_LoadPlayerVar:
+    case AT_LoadNPCVar:
+    case AT_NPCMemSet:
+    case AT_PlayerMemSet:
+        ftype = StrToFieldtype(GetS(MyString));
+        break;
+
+    default:
+        break;
+    }
+
+    switch(m_Type)
+    {
+    case AT_SetVar:
+    case AT_CopyVar:
+    case AT_IfVar:
+    case AT_CompareVar:
+        RefVar();
+        StrVar();
+        break;
+
+    case AT_LoadPlayerVar:
+    case AT_LoadNPCVar:
+    case AT_LoadGlobalVar:
+    case AT_ShowVar:
+    case AT_NPCMemSet:
+    case AT_PlayerMemSet:
+    case AT_MemAssign:
+        RefVar();
+        break;
+
+    case AT_BankVar:
+        StrVar();
+        break;
+
+    default:
+        break;
+    }
+}
+
 // DO - Perform autocodes for this section. Only does init codes if "init" is set
 void Autocode::Do(bool init)
 {
@@ -637,13 +697,6 @@ void Autocode::Do(bool init)
 
         case AT_OnPlayerMem:
         {
-            if(ftype == FT_INVALID)
-            {
-                ftype = FT_BYTE;
-                ftype = StrToFieldtype(GetS(MyString));
-            }
-//            uint8_t *ptr = (uint8_t *)demo;
-//            ptr += (int)Target; // offset
             bool triggered = CheckMem(demo, (size_t)Target, Param1, (COMPARETYPE)(int)Param2, ftype);
             if(triggered)
                 gAutoMan.ActivateCustomEvents(0, (int)Param3);
@@ -652,13 +705,7 @@ void Autocode::Do(bool init)
 
         case AT_OnGlobalMem:
         {
-            if(ftype == FT_INVALID)
-            {
-                ftype = FT_BYTE;
-                ftype = StrToFieldtype(GetS(MyString));
-            }
-
-            bool triggered = CheckMem((size_t)Target, Param1, (COMPARETYPE)(int)Param2, ftype);
+            bool triggered = CheckMem(GlobalField(), (size_t)Target, Param1, (COMPARETYPE)(int)Param2, ftype);
             if(triggered)
                 gAutoMan.ActivateCustomEvents(0, (int)Param3);
             break;
@@ -668,16 +715,16 @@ void Autocode::Do(bool init)
         case AT_SetVar:
         {
             if(ReferenceOK())
-                gAutoMan.VarOperation(GetS(MyRef), Param2, (OPTYPE)(int)Param1);
+                gAutoMan.VarOperation(RefVar(), Param2, (OPTYPE)(int)Param1);
             else
-                gAutoMan.VarOperation(GetS(MyString), Param2, (OPTYPE)(int)Param1);
+                gAutoMan.VarOperation(StrVar(), Param2, (OPTYPE)(int)Param1);
             break;
         }
 
         case AT_CopyVar:
         {
-            if(ReferenceOK() && MyString != STRINGINDEX_NONE && gAutoMan.VarExists(GetS(MyString)))
-                gAutoMan.VarOperation(GetS(MyRef), gAutoMan.GetVar(GetS(MyString)), (OPTYPE)(int)Param1);
+            if(ReferenceOK() && MyString != STRINGINDEX_NONE && gAutoMan.VarExists(StrVar()))
+                gAutoMan.VarOperation(RefVar(), gAutoMan.GetVar(StrVar()), (OPTYPE)(int)Param1);
             break;
         }
 
@@ -686,19 +733,12 @@ void Autocode::Do(bool init)
             if(!this->ReferenceOK() || Param1 > (0x184 * 99))
                 break;
 
-            if(ftype == FT_INVALID)
-            {
-                ftype = FT_BYTE;
-                ftype = StrToFieldtype(GetS(MyString));
-            }
 
             // Get the memory
-            //uint8_t *ptr = (uint8_t *)demo;
-            //ptr += (int)Param1; // offset
             num_t gotval = GetMem(demo, (size_t)Param1, ftype);
 
             // Perform the load/add/sub/etc operation on the banked variable using the ref as the name
-            gAutoMan.VarOperation(GetS(MyRef), gotval, (OPTYPE)(int)Param2);
+            gAutoMan.VarOperation(RefVar(), gotval, (OPTYPE)(int)Param2);
 
             break;
         }
@@ -707,17 +747,12 @@ void Autocode::Do(bool init)
         {
             if(!this->ReferenceOK() || Param1 > (0x158))
                 break;
-            if(ftype == FT_INVALID)
-            {
-                ftype = FT_BYTE;
-                ftype = StrToFieldtype(GetS(MyString));
-            }
 
             NPC_t *pFound_npc = NpcF::GetFirstMatch((int)Target, (int)Param3);
             if(pFound_npc != nullptr)
             {
                 num_t gotval = GetMem(pFound_npc, (size_t)Param1, ftype);
-                gAutoMan.VarOperation(GetS(MyRef), gotval, (OPTYPE)(int)Param2);
+                gAutoMan.VarOperation(RefVar(), gotval, (OPTYPE)(int)Param2);
             }
 
             break;
@@ -727,30 +762,20 @@ void Autocode::Do(bool init)
         {
             if(Target >= GM_BASE && Param1 <=  GM_END && ReferenceOK())
             {
-                if(ftype == FT_INVALID)
-                {
-                    ftype = FT_BYTE;
-                    ftype = StrToFieldtype(GetS(MyString));
-                }
-
-                // byte *ptr = (byte *)(int)Target;
-                num_t gotval = GetMem((size_t)Target, ftype);
-                gAutoMan.VarOperation(GetS(MyRef), gotval, (OPTYPE)(int)Param1);
+                num_t gotval = GetMem(GlobalField(), (size_t)Target, ftype);
+                gAutoMan.VarOperation(RefVar(), gotval, (OPTYPE)(int)Param1);
             }
             break;
         }
 
         case AT_IfVar:
         {
-            if(!ReferenceOK())
-            {
-                InitIfMissing(&gAutoMan.m_UserVars, GetS(MyString), 0);// Initalize var if not existing
-            }
+            // Initalize var if not existing
             num_t varval;
             if(ReferenceOK())
-                varval = gAutoMan.m_UserVars[GetS(MyRef)];
+                varval = gAutoMan.InitVar(RefVar());
             else
-                varval = gAutoMan.m_UserVars[GetS(MyString)];
+                varval = gAutoMan.InitVar(StrVar());
 
             // Check if the value meets the criteria and activate event if so
             if(CheckConditionD(varval, Param2, (COMPARETYPE)(int)Param1))
@@ -764,11 +789,8 @@ void Autocode::Do(bool init)
             if(ReferenceOK())
             {
                 auto compare_type = (COMPARETYPE)(int)Param1;
-                InitIfMissing(&gAutoMan.m_UserVars, GetS(MyString), 0);
-                InitIfMissing(&gAutoMan.m_UserVars, GetS(MyRef), 0);
-
-                num_t var1 = gAutoMan.m_UserVars[GetS(MyRef)];
-                num_t var2 = gAutoMan.m_UserVars[GetS(MyString)];
+                num_t var2 = gAutoMan.InitVar(StrVar());
+                num_t var1 = gAutoMan.InitVar(RefVar());
 
                 if(CheckConditionD(var1, var2, compare_type))
                     gAutoMan.ActivateCustomEvents(0, (int)Param3);
@@ -780,7 +802,7 @@ void Autocode::Do(bool init)
         {
             if(ReferenceOK())
             {
-                std::string str = fmt::format_ne("{0}", (double)gAutoMan.GetVar(GetS(MyRef)));
+                std::string str = fmt::format_ne("{0}", (double)gAutoMan.GetVar(RefVar()));
                 if(GetS(MyString).length() > 0)
                     str = GetS(MyString) + str;
                 Renderer::Get().AddOp(new RenderStringOp(str, (int)Param3, s_round2int(Param1), s_round2int(Param2)));
@@ -791,7 +813,7 @@ void Autocode::Do(bool init)
         case AT_BankVar:
         {
             if(GetS(MyString).length() > 0)
-                gSavedVarBank.SetVar(GetS(MyString), gAutoMan.GetVar(GetS(MyString)));
+                gSavedVarBank.SetVar(GetS(MyString), gAutoMan.GetVar(StrVar()));
             break;
         }
 
@@ -1131,16 +1153,10 @@ void Autocode::Do(bool init)
         // NPC MEMORY SET
         case AT_NPCMemSet:
         {
-            if(ftype == FT_INVALID)
-            {
-                ftype = FT_BYTE;
-                ftype = StrToFieldtype(GetS(MyString));
-            }
-
             // Assign the mem
             if(ReferenceOK())   // Use referenced var as value
             {
-                num_t gotval = gAutoMan.GetVar(GetS(MyRef));
+                num_t gotval = gAutoMan.GetVar(RefVar());
                 NpcF::MemSet((int)Target, (size_t)Param1, gotval, (OPTYPE)(int)Param3, ftype);
             }
             else   // Use given value as value
@@ -1154,15 +1170,9 @@ void Autocode::Do(bool init)
         // PLAYER MEMORY SET
         case AT_PlayerMemSet:
         {
-            if(ftype == FT_INVALID)
-            {
-                ftype = FT_BYTE;
-                ftype = StrToFieldtype(GetS(MyString));
-            }
-
             if(ReferenceOK())
             {
-                num_t gotval = gAutoMan.GetVar(GetS(MyRef));
+                num_t gotval = gAutoMan.GetVar(RefVar());
                 PlayerF::MemSet((size_t)Param1, gotval, (OPTYPE)(int)Param3, ftype);
             }
             else
@@ -1176,19 +1186,13 @@ void Autocode::Do(bool init)
         {
             if(Target >= GM_BASE && Param1 <=  GM_END)
             {
-                if(ftype == FT_INVALID)
-                {
-                    ftype = FT_BYTE;
-                    ftype = StrToFieldtype(GetS(MyString));
-                }
-
                 if(ReferenceOK())
                 {
-                    num_t gotval = gAutoMan.GetVar(GetS(MyRef));
-                    MemAssign((size_t)Target, gotval, (OPTYPE)(int)Param2, ftype);
+                    num_t gotval = gAutoMan.GetVar(RefVar());
+                    MemAssign(GlobalField(), (size_t)Target, gotval, (OPTYPE)(int)Param2, ftype);
                 }
                 else
-                    MemAssign((size_t)Target, Param1, (OPTYPE)(int)Param2, ftype);
+                    MemAssign(GlobalField(), (size_t)Target, Param1, (OPTYPE)(int)Param2, ftype);
             }
             break;
         }
@@ -1434,6 +1438,35 @@ bool Autocode::ReferenceOK() const
     return (!GetS(this->MyRef).empty());
 }
 
+const MemGlobalField *Autocode::GlobalField()
+{
+    size_t address = (size_t)Target;
+
+    if(address != m_memAddress || !m_memField)
+    {
+        m_memField = MemResolve(address);
+        m_memAddress = address;
+    }
+
+    return m_memField;
+}
+
+int Autocode::RefVar()
+{
+    if(m_refVar < 0)
+        m_refVar = gAutoMan.VarSlot(GetS(MyRef));
+
+    return m_refVar;
+}
+
+int Autocode::StrVar()
+{
+    if(m_strVar < 0)
+        m_strVar = gAutoMan.VarSlot(GetS(MyString));
+
+    return m_strVar;
+}
+
 
 
 void Autocode::HeartSystem() const
@@ -1518,7 +1551,7 @@ void Autocode::LunaControl(LunaControlAct act, int val)
 void Autocode::expire()
 {
     Expired = true;
-    gAutoMan.m_hasExpired = true;
+    gAutoMan.queueExpired(this);
 }
 
 void Autocode::modParam(num_t &dst, num_t src, OPTYPE operation)
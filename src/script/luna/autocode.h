@@ -23,6 +23,7 @@
 #define AutoCode_hhh
 
 #include <string>
+#include <cstdint>
 
 #include "numeric_types.h"
 #include "lunadefs.h"
@@ -217,6 +218,7 @@ enum AC_Conditional
 };
 
 struct SpriteComponent; // forward dec
+struct MemGlobalField; // forward dec
 
 // An autocode event
 class Autocode
@@ -233,6 +235,7 @@ public:
     Autocode &operator=(const Autocode &o);
 
     void Do(bool init);
+    void Compile(); // resolve the field type, the memory field, and the variables once at load
     static void DoPredicate(int target, int predicate);
 
     static bool NPCConditional(int NPCID, int condition);
@@ -265,6 +268,16 @@ public:
     bool Activated = false;             // False for custom event blueprints
     bool Expired = false;
 
+    // Compiled data, filled by Compile() and carried by copies
+    const MemGlobalField *m_memField = nullptr; // field resolved for the global address
+    size_t m_memAddress = 0;                    // global address the field has been resolved for
+    int m_refVar = -1;                          // slot of the variable named by MyRef
+    int m_strVar = -1;                          // slot of the variable named by MyString
+
+    // Bookkeeping of the manager, not carried by copies
+    uint32_t m_seq = 0;                         // position in the run order of the codes
+    bool m_expireQueued = false;                // code is at the expired queue of the manager
+
     void expire();
 
     //SpriteComponent* comp;
@@ -274,6 +287,9 @@ private:
     void SelfTick();
     void RunSelfOption(); // activate the string portion of this code on self
     bool ReferenceOK() const; // check if this object has a valid reference (not empty)
+    const MemGlobalField *GlobalField(); // field at the Target address (which ModParam can change)
+    int RefVar(); // slot of the variable named by MyRef
+    int StrVar(); // slot of the variable named by MyString
 };
 
 #endif // AutoCode_hhh
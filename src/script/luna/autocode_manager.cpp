@@ -18,6 +18,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <Utils/files.h>
 #include <Utils/dir_list_ci.h>
 #include <AppPath/app_path.h>
@@ -32,6 +33,7 @@
 #include "globals.h"
 #include "global_dirs.h"
 #include "lunamisc.h"
+#include "lunaplayer.h"
 #include "lunaspriteman.h"
 
 #define PARSEDEBUG true
@@ -68,6 +70,13 @@ void AutocodeManager::Clear()
     m_autocodeIdxRef.clear();
     m_autocodeIdxSection.clear();
 
+    m_autocodeRun.clear();
+    m_globcodeRun.clear();
+    m_codeNodes.clear();
+    m_expiredQueue.clear();
+    m_nextSeq = 0;
+    m_hasExpired = false;
+
     m_Hearts = 2;
 
     m_Enabled = false;
@@ -387,12 +396,14 @@ void AutocodeManager::Parse(SDL_RWops *code_file, bool add_to_globals, const std
             std::string ref_str = std::string(wrefbuf); // Get var reference string if any
 
             Autocode newcode(ac_type, target, param1, param2, param3, AllocS(ac_str), length, cur_section, AllocS(ref_str));
+            newcode.Compile();
+
             if(!add_to_globals)
             {
                 if(newcode.m_Type < 10000 || newcode.MyRef != STRINGINDEX_NONE)
                 {
                     m_Autocodes.emplace_back(std::move(newcode));
-                    addToIndex(&m_Autocodes.back());
+                    addToIndex(std::prev(m_Autocodes.end()));
                 }
                 else   // Sprite components (type 10000+) with no reference go into callable component list
                     gSpriteMan.m_ComponentList.push_back(Autocode::GenerateComponent(newcode));
@@ -402,7 +413,7 @@ void AutocodeManager::Parse(SDL_RWops *code_file, bool add_to_globals, const std
                 if(newcode.m_Type < 10000)
                 {
                     m_GlobalCodes.emplace_back(std::move(newcode));
-                    addToIndexGlob(&m_GlobalCodes.back());
+                    addToIndexGlob(std::prev(m_GlobalCodes.end()));
                 }
             }
         }
@@ -430,19 +441,73 @@ void AutocodeManager::DoEvents(bool init)
         {
             m_Autocodes.push_back(m_CustomCodes.back());
             m_CustomCodes.pop_back();
-            addToIndex(&m_Autocodes.back());
+            addToIndex(std::prev(m_Autocodes.end()));
         }
 
         // Do each code
-        for(auto &m_Autocode : m_Autocodes)
-            m_Autocode.Do(init);
+        runCodes(m_autocodeRun, init);
     }
 
     if(m_GlobalEnabled)
     {
         // Do each global code
-        for(auto &m_GlobalCode : m_GlobalCodes)
-            m_GlobalCode.Do(init);
+        runCodes(m_globcodeRun, init);
+    }
+}
+
+static inline uint32_t s_seqAt(const std::vector<Autocode*> *codes, size_t i)
+{
+    return (codes && i < codes->size()) ? (*codes)[i]->m_seq : UINT32_MAX;
+}
+
+// RUN CODES -- Same as calling Do() of every code of the list, but only visits the codes that may run
+void AutocodeManager::runCodes(const RunIndex &run, bool init)
+{
+    Player_t *demo = PlayerF::Get(1);
+    if(!demo)
+        return; // Nothing would run
+
+    int cur_section = demo->Section;
+    const std::vector<Autocode*> *always = &run.always;
+    const std::vector<Autocode*> *inits = init ? &run.init : nullptr;
+    const std::vector<Autocode*> *sec = run.section(cur_section);
+    size_t a = 0, i = 0, s = 0;
+
+    // Merge the lists by the run order
+    while(true)
+    {
+        uint32_t seq_a = s_seqAt(always, a);
+        uint32_t seq_i = s_seqAt(inits, i);
+        uint32_t seq_s = s_seqAt(sec, s);
+
+        Autocode *code;
+
+        if(seq_a < seq_i && seq_a < seq_s)
+            code = (*always)[a++];
+        else if(seq_i < seq_s)
+            code = (*inits)[i++];
+        else if(seq_s != UINT32_MAX)
+            code = (*sec)[s++];
+        else
+            break;
+
+        code->Do(init);
+
+        // The code has moved the player into another section, the following codes of that section run at this pass
+        demo = PlayerF::Get(1);
+        if(demo && demo->Section != cur_section)
+        {
+            cur_section = demo->Section;
+            sec = run.section(cur_section);
+            s = 0;
+
+            if(sec)
+            {
+                uint32_t seq = code->m_seq;
+                s = std::upper_bound(sec->begin(), sec->end(), seq,
+                    [](uint32_t v, const Autocode *c) { return v < c->m_seq; }) - sec->begin();
+            }
+        }
     }
 }
 
@@ -474,55 +539,92 @@ void AutocodeManager::DeleteEvent(const std::string &ref_name)
     }
 }
 
+static bool s_isDead(const Autocode *code)
+{
+    return code->Expired || code->m_Type == AT_Invalid;
+}
+
 // CLEAN EXPIRED - Don't call this while iterating over codes
 void AutocodeManager::ClearExpired()
 {
     if(!m_hasExpired)
         return; // Nothing to do
 
+    m_hasExpired = false;
+
 // #define DEBUG_CLEAN_EXPIRED
 
 #ifdef DEBUG_CLEAN_EXPIRED
     int cleanedAutos = 0, cleanedGlobs = 0;
 #endif
 
-    //char* dbg = "CLEAN EXPIRED DBG";
-    auto iter = m_Autocodes.begin();
-    auto end  = m_Autocodes.end();
+    std::vector<Autocode*> dead;
+    std::vector<std::list<Autocode*>*> idx_lists;
+    std::vector<std::vector<Autocode*>*> run_lists;
 
-    while(iter != m_Autocodes.end())
+    for(Autocode *code : m_expiredQueue)
     {
-        //Autocode* ac = *iter;
-        if((*iter).Expired || (*iter).m_Type == AT_Invalid)
-        {
-            removeFromIndex(&*iter);
-//            delete(*iter);
-            iter = m_Autocodes.erase(iter);
-#ifdef DEBUG_CLEAN_EXPIRED
-            cleanedAutos++;
-#endif
-        }
-        else
-            ++iter;
+        code->m_expireQueued = false;
+
+        // Timers may get restarted after expiring
+        if(!s_isDead(code))
+            continue;
+
+        auto node = m_codeNodes.find(code);
+        if(node == m_codeNodes.end())
+            continue;
+
+        bool global = node->second.global;
+        auto &idx_sec = global ? m_globcodeIdxSection : m_autocodeIdxSection;
+        auto &idx_ref = global ? m_globcodeIdxRef : m_autocodeIdxRef;
+        auto *run_list = (global ? m_globcodeRun : m_autocodeRun).list(code);
+
+        idx_lists.push_back(&idx_sec[code->ActiveSection]);
+
+        if(!GetS(code->MyRef).empty())
+            idx_lists.push_back(&idx_ref[GetS(code->MyRef)]);
+
+        if(run_list)
+            run_lists.push_back(run_list);
+
+        dead.push_back(code);
     }
 
-    iter = m_GlobalCodes.begin();
-    end  = m_GlobalCodes.end();
+    m_expiredQueue.clear();
 
-    while(iter != m_GlobalCodes.end())
+    // Every expired code has been queued, so each touched list only needs a single pass
+    std::sort(idx_lists.begin(), idx_lists.end());
+    idx_lists.erase(std::unique(idx_lists.begin(), idx_lists.end()), idx_lists.end());
+
+    for(auto *l : idx_lists)
+        l->remove_if(s_isDead);
+
+    std::sort(run_lists.begin(), run_lists.end());
+    run_lists.erase(std::unique(run_lists.begin(), run_lists.end()), run_lists.end());
+
+    for(auto *l : run_lists)
+        l->erase(std::remove_if(l->begin(), l->end(), s_isDead), l->end());
+
+    for(Autocode *code : dead)
     {
-        //Autocode* ac = *iter;
-        if((*iter).Expired || (*iter).m_Type == AT_Invalid)
+        auto node = m_codeNodes.find(code);
+
+        if(node->second.global)
         {
-//            delete(*iter);
-            removeFromIndexGlob(&*iter);
-            iter = m_GlobalCodes.erase(iter);
+            m_GlobalCodes.erase(node->second.it);
 #ifdef DEBUG_CLEAN_EXPIRED
             cleanedGlobs++;
 #endif
         }
         else
-            ++iter;
+        {
+            m_Autocodes.erase(node->second.it);
+#ifdef DEBUG_CLEAN_EXPIRED
+            cleanedAutos++;
+#endif
+        }
+
+        m_codeNodes.erase(node);
     }
 
 #ifdef DEBUG_CLEAN_EXPIRED
@@ -532,8 +634,17 @@ void AutocodeManager::ClearExpired()
     if(cleanedGlobs > 0)
         D_pLogDebug("Autocode: Cleaned %d expired global autocodes", cleanedGlobs);
 #endif
+}
 
-    m_hasExpired = false;
+void AutocodeManager::queueExpired(Autocode *code)
+{
+    m_hasExpired = true;
+
+    if(code->m_expireQueued)
+        return;
+
+    code->m_expireQueued = true;
+    m_expiredQueue.push_back(code);
 }
 
 // ACTIVATE CUSTOM EVENTS
@@ -622,103 +733,148 @@ Autocode *AutocodeManager::FindMatching(int section, const std::string &soughtst
 bool AutocodeManager::VarOperation(const std::string &var_name, num_t value, OPTYPE operation_to_do)
 {
     if(var_name.length() > 0)
-    {
-        // Create var if doesn't exist
-        InitIfMissing(&gAutoMan.m_UserVars, var_name, 0);
+        return VarOperation(VarSlot(var_name), value, operation_to_do);
 
-        num_t var_val = m_UserVars[var_name];
+    return false;
+}
 
-        // Do the operation
-        OPTYPE oper = operation_to_do;
-        switch(oper)
-        {
-        case OP_Assign:
-            m_UserVars[var_name] = value;
-            return true;
-        case OP_Add:
-            m_UserVars[var_name] = var_val + value;
-            return true;
-        case OP_Sub:
-            m_UserVars[var_name] = var_val - value;
-            return true;
-        case OP_Mult:
-            m_UserVars[var_name] = var_val.times(value);
-            return true;
-        case OP_Div:
-            if(value == 0)
-                return false;
-            m_UserVars[var_name] = var_val.divided_by(value);
-            return true;
-        case OP_XOR:
-            m_UserVars[var_name] = (int)var_val ^ (int)value;
-            return true;
-        default:
-            return true;
-        }
+bool AutocodeManager::VarOperation(int slot, num_t value, OPTYPE operation_to_do)
+{
+    if(m_UserVarNames[slot].empty())
+        return false;
+
+    // Create var if doesn't exist
+    num_t &var_val = InitVar(slot);
+
+    // Do the operation
+    OPTYPE oper = operation_to_do;
+    switch(oper)
+    {
+    case OP_Assign:
+        var_val = value;
+        return true;
+    case OP_Add:
+        var_val = var_val + value;
+        return true;
+    case OP_Sub:
+        var_val = var_val - value;
+        return true;
+    case OP_Mult:
+        var_val = var_val.times(value);
+        return true;
+    case OP_Div:
+        if(value == 0)
+            return false;
+        var_val = var_val.divided_by(value);
+        return true;
+    case OP_XOR:
+        var_val = (int)var_val ^ (int)value;
+        return true;
+    default:
+        return true;
     }
-    return false;
 }
 
-void AutocodeManager::addToIndex(Autocode *code)
+void AutocodeManager::ImportVars(const std::map<std::string, num_t> &vars)
 {
-    m_autocodeIdxSection[code->ActiveSection].push_back(code);
-    if(!GetS(code->MyRef).empty())
-        m_autocodeIdxRef[GetS(code->MyRef)].push_back(code);
+    for(auto &it : vars)
+        InitVar(VarSlot(it.first)) = it.second;
 }
 
-void AutocodeManager::removeFromIndex(Autocode *code)
+int AutocodeManager::VarSlot(const std::string &var_name)
 {
-    auto &sec = m_autocodeIdxSection[code->ActiveSection];
-    for(auto it = sec.begin(); it != sec.end(); )
-    {
-        if(*it == code)
-            it = sec.erase(it);
-        else
-            ++it;
-    }
+    auto it = m_UserVarSlots.find(var_name);
+    if(it != m_UserVarSlots.end())
+        return it->second;
 
-    if(!GetS(code->MyRef).empty())
+    int slot = (int)m_UserVars.size();
+    m_UserVarSlots.insert({var_name, slot});
+    m_UserVarNames.push_back(var_name);
+    m_UserVars.emplace_back();
+
+    return slot;
+}
+
+num_t &AutocodeManager::InitVar(int slot)
+{
+    UserVar &var = m_UserVars[slot];
+
+    if(!var.exists)
     {
-        auto &ref = m_autocodeIdxRef[GetS(code->MyRef)];
-        for(auto it = ref.begin(); it != ref.end(); )
-        {
-            if(*it == code)
-                it = ref.erase(it);
-            else
-                ++it;
-        }
+        var.value = 0;
+        var.exists = true;
     }
+
+    return var.value;
 }
 
-void AutocodeManager::addToIndexGlob(Autocode *code)
+std::vector<Autocode*> *AutocodeManager::RunIndex::list(const Autocode *code)
 {
-    m_globcodeIdxSection[code->ActiveSection].push_back(code);
+    // Blueprints of custom events never run
+    if(!code->Activated)
+        return nullptr;
+
+    // Same checks as at Autocode::Do()
+    if((uint8_t)code->ActiveSection == (uint8_t)0xFF)
+        return &always;
+    else if((uint8_t)code->ActiveSection == (uint8_t)0xFE)
+        return &init;
+
+    return &sections[code->ActiveSection];
+}
+
+const std::vector<Autocode*> *AutocodeManager::RunIndex::section(int section) const
+{
+    auto s = sections.find(section);
+    if(s == sections.end() || s->second.empty())
+        return nullptr;
+
+    return &s->second;
+}
+
+void AutocodeManager::RunIndex::clear()
+{
+    always.clear();
+    init.clear();
+    sections.clear();
+}
+
+void AutocodeManager::addToIndex(std::list<Autocode>::iterator it)
+{
+    Autocode *code = &*it;
+
+    m_autocodeIdxSection[code->ActiveSection].push_back(code);
     if(!GetS(code->MyRef).empty())
-        m_globcodeIdxRef[GetS(code->MyRef)].push_back(code);
+        m_autocodeIdxRef[GetS(code->MyRef)].push_back(code);
+
+    code->m_seq = m_nextSeq++;
+    m_codeNodes[code] = {it, false};
+
+    auto *run_list = m_autocodeRun.list(code);
+    if(run_list)
+        run_list->push_back(code);
+
+    if(s_isDead(code))
+        queueExpired(code);
 }
 
-void AutocodeManager::removeFromIndexGlob(Autocode *code)
+void AutocodeManager::addToIndexGlob(std::list<Autocode>::iterator it)
 {
-    auto &sec = m_globcodeIdxSection[code->ActiveSection];
-    for(auto it = sec.begin(); it != sec.end(); )
-    {
-        if(*it == code)
-            it = sec.erase(it);
-        else
-            ++it;
-    }
+    Autocode *code = &*it;
 
+    m_globcodeIdxSection[code->ActiveSection].push_back(code);
     if(!GetS(code->MyRef).empty())
-    {
-        auto &ref = m_globcodeIdxRef[GetS(code->MyRef)];
-        for(auto it = ref.begin(); it != ref.end(); )
-        {
-            if(*it == code)
-                it = ref.erase(it);
-            else
-                ++it;
-        }
-    }
+        m_globcodeIdxRef[GetS(code->MyRef)].push_back(code);
+
+    code->m_seq = m_nextSeq++;
+    m_codeNodes[code] = {it, true};
+
+    auto *run_list = m_globcodeRun.list(code);
+    if(run_list)
+        run_list->push_back(code);
+
+    if(s_isDead(code))
+        queueExpired(code);
 }
 
 void AutocodeManager::addError(int lineNumber, const std::string &line, const std::string &msg)
@@ -775,14 +931,27 @@ void AutocodeManager::showErrors(const std::string &file)
 // VAR EXISTS
 bool AutocodeManager::VarExists(const std::string &var_name)
 {
-    return (m_UserVars.find(var_name) != m_UserVars.end());
+    auto it = m_UserVarSlots.find(var_name);
+    return it != m_UserVarSlots.end() && VarExists(it->second);
+}
+
+bool AutocodeManager::VarExists(int slot) const
+{
+    return m_UserVars[slot].exists;
 }
 
 // GET VAR
 num_t AutocodeManager::GetVar(const std::string &var_name)
 {
-    if(!VarExists(var_name))
+    auto it = m_UserVarSlots.find(var_name);
+    if(it == m_UserVarSlots.end())
         return 0;
 
-    return m_UserVars[var_name];
+    return GetVar(it->second);
+}
+
+num_t AutocodeManager::GetVar(int slot) const
+{
+    const UserVar &var = m_UserVars[slot];
+    return var.exists ? var.value : 0;
 }
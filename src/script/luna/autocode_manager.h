@@ -26,6 +26,7 @@
 #include <map>
 #include <unordered_map>
 #include <list>
+#include <vector>
 #include <SDL2/SDL_rwops.h>
 
 #include "autocode.h"
@@ -57,6 +58,7 @@ struct AutocodeManager
     void Clear();
     void ForceExpire(int section);
     void ClearExpired();
+    void queueExpired(Autocode *code);      // Schedule the removal of the expired code at the next ClearExpired()
     void DeleteEvent(const std::string &event_reference_name);     // Look up event with given name and expire it
     void DoEvents(bool init);
     void ActivateCustomEvents(int new_section, int eventcode);
@@ -67,6 +69,14 @@ struct AutocodeManager
     num_t GetVar(const std::string &var_name);        // returns 0 if var doesn't exist in bank
     bool VarExists(const std::string &var_name);
     bool VarOperation(const std::string &var_name, num_t value, OPTYPE operation_to_do);
+    void ImportVars(const std::map<std::string, num_t> &vars); // set all vars of the map
+
+    // Interned variable funcs, the codes resolve their names to slots once at load
+    int VarSlot(const std::string &var_name);           // slot of the name, allocated if new, never changes
+    num_t GetVar(int slot) const;                       // returns 0 if var doesn't exist in bank
+    bool VarExists(int slot) const;
+    num_t &InitVar(int slot);                           // creates var with 0 value if doesn't exist
+    bool VarOperation(int slot, num_t value, OPTYPE operation_to_do);
 
     // Members
     bool                    m_Enabled = false;          // Whether or not individual level scripts enabled
@@ -89,11 +99,46 @@ struct AutocodeManager
     //! Index table to find global autocodes by reference
     std::unordered_map<std::string, std::list<Autocode*>>  m_globcodeIdxRef;
 
-    void addToIndex(Autocode *code);
-    void removeFromIndex(Autocode *code);
+    /*
+     * Codes to run by DoEvents(), indexed by the section they are active in, in the order
+     * of their lists. Blueprints of custom events aren't listed, and the expired codes
+     * get removed together with their nodes at ClearExpired().
+     */
+    struct RunIndex
+    {
+        //! Codes active in any section
+        std::vector<Autocode*> always;
+        //! Codes that only run at the level start
+        std::vector<Autocode*> init;
+        //! Codes active in the given section
+        std::unordered_map<int, std::vector<Autocode*>> sections;
+
+        std::vector<Autocode*> *list(const Autocode *code);
+        const std::vector<Autocode*> *section(int section) const;
+        void clear();
+    };
+
+    //! Run index of the level codes
+    RunIndex                m_autocodeRun;
+    //! Run index of the global codes
+    RunIndex                m_globcodeRun;
 
-    void addToIndexGlob(Autocode *code);
-    void removeFromIndexGlob(Autocode *code);
+    struct CodeNode
+    {
+        std::list<Autocode>::iterator it;
+        bool global;
+    };
+
+    //! Nodes of the codes at m_Autocodes and m_GlobalCodes, to erase them without a scan
+    std::unordered_map<const Autocode*, CodeNode> m_codeNodes;
+    //! Codes that got expired since the last ClearExpired()
+    std::vector<Autocode*>  m_expiredQueue;
+    //! Run order of the next added code
+    uint32_t                m_nextSeq = 0;
+
+    void addToIndex(std::list<Autocode>::iterator code);
+    void addToIndexGlob(std::list<Autocode>::iterator code);
+    void runCodes(const RunIndex &run, bool init);
 
     struct ParseError
     {
@@ -106,7 +151,18 @@ struct AutocodeManager
     void addError(int lineNumber, const std::string &line, const std::string &msg);
     void showErrors(const std::string &file);
 
-    std::map<std::string, num_t> m_UserVars;
+    struct UserVar
+    {
+        num_t value = 0;
+        bool exists = false;
+    };
+
+    //! Slots of the user variables by name
+    std::unordered_map<std::string, int> m_UserVarSlots;
+    //! Names of the user variables by slot
+    std::vector<std::string> m_UserVarNames;
+    //! User variables by slot
+    std::vector<UserVar> m_UserVars;
 
     // Hearts manager stuff
     int m_Hearts = 2;
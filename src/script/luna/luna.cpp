@@ -89,7 +89,7 @@ void lunaLoad()
         gAutoMan.LoadFiles();
 
         // Init var bank
-        gSavedVarBank.CopyBank(&gAutoMan.m_UserVars);
+        gAutoMan.ImportVars(gSavedVarBank.m_VarBank);
 
         // Init some stuff
         if(g_config.luna_allow_level_codes)
@@ -101,6 +101,15 @@ void lunaLoad()
         gDeathCounter.Recount();
 }
 
+bool lunaLoopActive()
+{
+    if(LevelEditor || !g_config.luna_enable_engine || !lunaAllowed())
+        return false;
+
+    return gAutoMan.m_Enabled || gAutoMan.m_GlobalEnabled
+        || (g_config.luna_allow_level_codes && lunaLevelsActive());
+}
+
 void lunaLoop()
 {
     if(g_config.luna_enable_engine)
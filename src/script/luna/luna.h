@@ -39,6 +39,8 @@ extern bool gEnableDemoCounterByLC;
 extern void lunaReset();
 extern void lunaLoad();
 extern void lunaLoop();
+//! true if lunaLoop() runs any autocode or level code for the current level
+extern bool lunaLoopActive();
 extern void lunaRenderStart();
 extern void lunaRenderHud(int screenZ);
 extern void lunaRender(int screenZ);
@@ -22,6 +22,7 @@
 #include "collision.h"
 
 #include "main/trees.h"
+#include "main/block_type_index.h"
 
 #include "graphics/gfx_update.h" // invalidateDrawBlocks
 
@@ -37,36 +38,23 @@ int BlocksF::TestCollision(Player_t *pMobPOS, Block_t *pBlockPOS)
 
 void BlocksF::SetAll(int type1, int type2)
 {
-    for(int i = 1; i <= numBlock; i++)
-    {
-        if(Block[i].Type == type1)
-            Block[i].Type = type2;
-    }
+    BlockTypeIndex::setAll(type1, type2);
 }
 
 void BlocksF::SwapAll(int type1, int type2)
 {
-    for(int i = 1; i <= numBlock; i++)
-    {
-        if(Block[i].Type == type1)
-            Block[i].Type = type2;
-        else if(Block[i].Type == type2)
-            Block[i].Type = type1;
-    }
+    BlockTypeIndex::swapAll(type1, type2);
 }
 
 void BlocksF::ShowAll(int type)
 {
     bool any_change = false;
 
-    for(int i = 1; i <= numBlock; i++)
+    BlockTypeIndex::for_each(type, [&any_change](int i)
     {
-        if(Block[i].Type == type)
-        {
-            Block[i].Invis = false;
-            any_change = true;
-        }
-    }
+        Block[i].Invis = false;
+        any_change = true;
+    });
 
     if(any_change)
         invalidateDrawBlocks();
@@ -76,14 +64,11 @@ void BlocksF::HideAll(int type)
 {
     bool any_change = false;
 
-    for(int i = 1; i <= numBlock; i++)
+    BlockTypeIndex::for_each(type, [&any_change](int i)
     {
-        if(Block[i].Type == type)
-        {
-            Block[i].Invis = true;
-            any_change = true;
-        }
-    }
+        Block[i].Invis = true;
+        any_change = true;
+    });
 
     if(any_change)
         invalidateDrawBlocks();
@@ -36,6 +36,7 @@
 #include "core/render.h"
 #include "main/game_info.h"
 #include "main/menu_main.h"
+#include "main/run_ahead.h"
 
 
 DeathCounter gDeathCounter;
@@ -193,7 +194,7 @@ void DeathCounter::MarkDeath(bool write_save)
 {
     bool dcAllow = (gEnableDemoCounterByLC || g_config.enable_fails_tracking);
 
-    if(!dcAllow)
+    if(!dcAllow || RunAhead::hiddenFrame())
         return;
 
     AddDeath(FileNameFull, 1);
@@ -126,3 +126,8 @@ void lunaLevelsDo()
     if(levelCodeRun)
         levelCodeRun();
 }
+
+bool lunaLevelsActive()
+{
+    return levelCodeRun != nullptr;
+}
@@ -37,4 +37,9 @@ extern void lunaLevelsClear();
  */
 extern void lunaLevelsDo();
 
+/*!
+ * \brief Is a level custom code attached?
+ */
+extern bool lunaLevelsActive();
+
 #endif // LUNALEVELS_H
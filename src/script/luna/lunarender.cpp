@@ -28,8 +28,6 @@
 #include "game_main.h"
 #include <fmt_format_ne.h>
 
-#include <algorithm>
-
 
 PoolAllocator g_rAlloc(c_rAllocTotalSize, c_rAllocChunkSize);
 
@@ -123,6 +121,18 @@ LunaImage *Renderer::GetImageForResourceCode(int resource_code)
     return nullptr;
 }
 
+static inline int s_opPlane(const RenderOp &op)
+{
+    int plane = (int)op.m_renderPriority;
+
+    if(plane < 0)
+        return 0;
+    else if(plane >= c_renderPlanes)
+        return c_renderPlanes - 1;
+
+    return plane;
+}
+
 void Renderer::AddOp(RenderOp *op)
 {
     if(op->m_selectedCamera == 0)
@@ -132,7 +142,14 @@ void Renderer::AddOp(RenderOp *op)
         op->m_selectedCamera = m_queueState.m_curCamIdx;
     }
 
-    this->m_queueState.m_currentRenderOps.push_back(op);
+    int plane = s_opPlane(*op);
+
+    m_queueState.m_renderOps[plane].push_back(op);
+    m_queueState.m_renderOpsCount++;
+    m_queueState.m_renderOpsPending++;
+
+    if(plane < m_queueState.m_pendingPlane)
+        m_queueState.m_pendingPlane = plane;
 }
 
 void Renderer::DebugPrint(const std::string &message)
@@ -145,11 +162,6 @@ void Renderer::DebugPrint(const std::string &message, num_t val)
     this->m_queueState.m_debugMessages.push_back(fmt::format_ne("{0} {1}", message, (double)val));
 }
 
-static bool CompareRenderPriority(const RenderOp *lhs, const RenderOp *rhs)
-{
-    return lhs->m_renderPriority < rhs->m_renderPriority;
-}
-
 void Renderer::RenderBelowPriority(PLANE maxPriority)
 {
     if(!m_queueState.m_InFrameRender) return;
@@ -160,54 +172,29 @@ void Renderer::RenderBelowPriority(PLANE maxPriority)
     //        LunaLoadScreenKill();
     //    }
 
-    auto &ops = m_queueState.m_currentRenderOps;
-    if(ops.size() <= m_queueState.m_renderOpsProcessedCount) return;
+    if(m_queueState.m_renderOpsPending == 0) return;
 
     // Flush pending BltBlt
     //    g_BitBltEmulation.flushPendingBlt();
 
-    // Assume operations already processed were already sorted
-    if(m_queueState.m_renderOpsSortedCount == 0)
-    {
-        std::stable_sort(ops.begin(), ops.end(), CompareRenderPriority);
-        m_queueState.m_renderOpsSortedCount = ops.size();
-    }
-    else if(m_queueState.m_renderOpsSortedCount < ops.size())
-    {
-        // Sort the new operations
-        std::stable_sort(ops.begin() + m_queueState.m_renderOpsSortedCount, ops.end(), CompareRenderPriority);
+    // The operations are kept by priority, so the ones below the given priority
+    // that haven't been drawn yet are just the tails of the lower lists
+    int maxPlane = (int)maxPriority;
+    if(maxPlane > c_renderPlanes)
+        maxPlane = c_renderPlanes;
 
-        // Render things as many of the new items as we should before merging the sorted lists
-        PLANE maxPassPriority = maxPriority;
-        if(m_queueState.m_renderOpsSortedCount > m_queueState.m_renderOpsProcessedCount)
-        {
-            PLANE nextPriorityInOldList = ops[m_queueState.m_renderOpsProcessedCount]->m_renderPriority;
-            if(nextPriorityInOldList < maxPassPriority)
-                maxPassPriority = nextPriorityInOldList;
-        }
+    while(m_queueState.m_pendingPlane < maxPlane)
+    {
+        int plane = m_queueState.m_pendingPlane++;
+        auto &ops = m_queueState.m_renderOps[plane];
+        auto &drawn = m_queueState.m_renderOpsDrawn[plane];
 
-        for(auto iter = ops.cbegin() + m_queueState.m_renderOpsSortedCount, end = ops.cend(); iter != end; ++iter)
+        while(drawn < ops.size())
         {
-            RenderOp &op = **iter;
-            if(op.m_renderPriority >= maxPassPriority)
-                break;
+            RenderOp &op = *ops[drawn++];
+            m_queueState.m_renderOpsPending--;
             DrawOp(op);
-            m_queueState.m_renderOpsProcessedCount++;
         }
-
-        // Merge sorted list sections (note, std::inplace_merge is a stable sort)
-        std::inplace_merge(ops.begin(), ops.begin() + m_queueState.m_renderOpsSortedCount, ops.end(), CompareRenderPriority);
-        m_queueState.m_renderOpsSortedCount = ops.size();
-    }
-
-    // Render other operations
-    for(auto iter = ops.cbegin() + m_queueState.m_renderOpsProcessedCount, end = ops.cend(); iter != end; ++iter)
-    {
-        RenderOp &op = **iter;
-        if(op.m_renderPriority >= maxPriority)
-            break;
-        DrawOp(op);
-        m_queueState.m_renderOpsProcessedCount++;
     }
 
     if(maxPriority >= RENDEROP_PRIORITY_MAX)
@@ -246,7 +233,7 @@ void Renderer::ClearAllLoadedImages()
 void Renderer::StartCameraRender(int idx)
 {
     m_queueState.m_curCamIdx = idx;
-    m_queueState.m_renderOpsProcessedCount = 0;
+    ResetDrawnOps();
 }
 
 void Renderer::StoreCameraPosition(int idx)
@@ -263,35 +250,48 @@ void Renderer::StoreCameraPosition(int idx)
 
 void Renderer::StartRenderLogic()
 {
+    if(m_queueState.m_renderOpsCount == 0)
+        return;
+
     // Decrement life time counters
-    for(auto &m_currentRenderOp : m_queueState.m_currentRenderOps)
-        m_currentRenderOp->m_FramesLeft--;
+    for(auto &ops : m_queueState.m_renderOps)
+    {
+        for(RenderOp *op : ops)
+            op->m_FramesLeft--;
+    }
 }
 
 void Renderer::EndRenderLogic()
 {
-    // Remove cleared operations
-    std::vector<RenderOp *> nonExpiredOps;
-    for(auto &m_currentRenderOp : m_queueState.m_currentRenderOps)
+    if(m_queueState.m_renderOpsCount == 0)
+        return;
+
+    // Remove cleared operations, keeping the order of the remaining ones
+    for(auto &ops : m_queueState.m_renderOps)
     {
-        RenderOp *pOp = m_currentRenderOp;
-        if(pOp->m_FramesLeft <= 0)
+        auto out = ops.begin();
+
+        for(RenderOp *op : ops)
         {
-            m_currentRenderOp = nullptr;
-            delete pOp;
+            if(op->m_FramesLeft <= 0)
+            {
+                delete op;
+                m_queueState.m_renderOpsCount--;
+            }
+            else
+                *out++ = op;
         }
-        else
-            nonExpiredOps.push_back(pOp);
+
+        ops.erase(out, ops.end());
     }
 
-    m_queueState.m_currentRenderOps.swap(nonExpiredOps);
+    ResetDrawnOps();
 }
 
 void Renderer::StartFrameRender()
 {
     m_queueState.m_curCamIdx = 0;
     m_queueState.m_InFrameRender = true;
-    m_queueState.m_renderOpsSortedCount = m_queueState.m_currentRenderOps.size();
 }
 
 void Renderer::EndFrameRender()
@@ -300,22 +300,32 @@ void Renderer::EndFrameRender()
         return;
 
     m_queueState.m_curCamIdx = 0;
-    m_queueState.m_renderOpsProcessedCount = 0;
+    ResetDrawnOps();
     m_queueState.m_InFrameRender = false;
 }
 
 void Renderer::ClearQueue()
 {
     m_queueState.m_curCamIdx = 0;
-    for(auto &m_currentRenderOp : m_queueState.m_currentRenderOps)
-        delete m_currentRenderOp;
+    for(auto &ops : m_queueState.m_renderOps)
+    {
+        for(RenderOp *op : ops)
+            delete op;
+        ops.clear();
+    }
     g_rAlloc.Reset();
-    m_queueState.m_currentRenderOps.clear();
-    m_queueState.m_renderOpsProcessedCount = 0;
-    m_queueState.m_renderOpsSortedCount = 0;
+    m_queueState.m_renderOpsCount = 0;
+    ResetDrawnOps();
     m_queueState.m_InFrameRender = false;
 }
 
+void Renderer::ResetDrawnOps()
+{
+    m_queueState.m_renderOpsDrawn.fill(0);
+    m_queueState.m_renderOpsPending = m_queueState.m_renderOpsCount;
+    m_queueState.m_pendingPlane = 0;
+}
+
 void Renderer::DrawOp(RenderOp &op)
 {
     if((op.m_selectedCamera == 0 || op.m_selectedCamera == m_queueState.m_curCamIdx) && (op.m_FramesLeft >= 1 || GamePaused != PauseCode::None))
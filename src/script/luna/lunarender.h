@@ -25,6 +25,7 @@
 #include "numeric_types.h"
 
 #include <unordered_map>
+#include <array>
 #include <vector>
 #include <string>
 #include <list>
@@ -40,6 +41,9 @@ constexpr size_t c_rAllocChunkSize = 96;
 constexpr size_t c_rAllocTotalSize = c_rAllocChunkSize * 1000;
 extern PoolAllocator g_rAlloc;
 
+// Number of render priorities (draw planes), each one has its own list of render operations
+constexpr int c_renderPlanes = 256;
+
 struct Renderer
 {
     static Renderer &Get();
@@ -83,6 +87,7 @@ struct Renderer
     void ClearQueue();
 private:
     void DrawOp(RenderOp &render_operation);
+    void ResetDrawnOps();
 
 
     // Members //
@@ -93,9 +98,12 @@ public:
         bool m_InFrameRender;
         int m_curCamIdx; // Camera state
 
-        std::size_t m_renderOpsSortedCount;
-        std::size_t m_renderOpsProcessedCount;
-        std::vector<RenderOp *> m_currentRenderOps; // render operations to be performed
+        // render operations to be performed, by priority, in the order they were added
+        std::array<std::vector<RenderOp *>, c_renderPlanes> m_renderOps;
+        std::array<std::size_t, c_renderPlanes> m_renderOpsDrawn; // operations of each priority already drawn for the current camera
+        std::size_t m_renderOpsCount;
+        std::size_t m_renderOpsPending; // operations not drawn yet for the current camera
+        int m_pendingPlane; // lowest priority that may have operations not drawn yet
 
         std::list<std::string> m_debugMessages;    // Debug message to be printed
 
@@ -103,9 +111,11 @@ public:
         QueueState() :
             m_InFrameRender(false),
             m_curCamIdx(1),
-            m_renderOpsSortedCount(0),
-            m_renderOpsProcessedCount(0),
-            m_currentRenderOps(),
+            m_renderOps(),
+            m_renderOpsDrawn(),
+            m_renderOpsCount(0),
+            m_renderOpsPending(0),
+            m_pendingPlane(0),
             m_debugMessages()
         {}
     };
@@ -134,12 +144,7 @@ public:
         {
             m_savedState = m_renderer.m_queueState;
             // Don't use m_renderer.ClearQueue() for this because we're effectively moving things and ClearQueue frees some pointers
-            m_renderer.m_queueState.m_InFrameRender = false;
-            m_renderer.m_queueState.m_curCamIdx = 1;
-            m_renderer.m_queueState.m_renderOpsSortedCount = 0;
-            m_renderer.m_queueState.m_renderOpsProcessedCount = 0;
-            m_renderer.m_queueState.m_currentRenderOps.clear();
-            m_renderer.m_queueState.m_debugMessages.clear();
+            m_renderer.m_queueState = QueueState();
         }
 
         ~QueueStateStacker()
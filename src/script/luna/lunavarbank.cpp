@@ -128,19 +128,3 @@ void SavedVariableBank::SaveIfNeeded()
         WriteBank();
     }
 }
-
-//COPY BANK
-void SavedVariableBank::CopyBank(std::map<std::string, num_t> *target_map)
-{
-    if(!target_map)
-        return;
-
-    for(auto &it : m_VarBank)
-    {
-        auto n = (*target_map).find(it.first);
-        if(n == (*target_map).end())
-            (*target_map).insert(it);
-        else
-            n->second = it.second;
-    }
-}
@@ -67,12 +67,6 @@ public:
      */
     num_t GetVar(const std::string &key);
 
-    /*!
-     * \brief Copy all k,v pairs of variable bank to another map
-     * \param target Destination map of copy
-     */
-    void CopyBank(std::map<std::string, num_t> *target);
-
     void ClearBank();
 
     /*!
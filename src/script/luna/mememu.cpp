@@ -496,22 +496,16 @@ static const char *FieldtypeToStr(FIELDTYPE ftype)
 /*!
  * \brief Global memory emulator
  */
-class SMBXMemoryEmulator
+/*!
+ * \brief Field of the global memory emulator
+ */
+struct MemGlobalField
 {
-    std::unordered_map<size_t, num_t *> m_df;
-    std::unordered_map<size_t, numf_t *>  m_ff;
-    std::unordered_map<size_t, short *>  m_i16f;
-    std::unordered_map<size_t, int *>    m_i32f;
-    std::unordered_map<size_t, bool *>   m_bf;
-    std::unordered_map<size_t, std::string *>   m_sf;
-
     typedef std::function<num_t(FIELDTYPE)> Getter;
     typedef std::function<void(num_t,FIELDTYPE)> Setter;
-    std::unordered_map<size_t, std::pair<Getter, Setter>> m_lff;
 
     typedef std::function<std::string()> StrGetter;
     typedef std::function<void(const std::string&)> StrSetter;
-    std::unordered_map<size_t, std::pair<StrGetter, StrSetter>> m_sff;
 
     enum ValueType
     {
@@ -526,54 +520,103 @@ class SMBXMemoryEmulator
         VT_STRLAMBDA
     };
 
-    std::unordered_map<int, ValueType> m_type;
+    //! Type of field
+    ValueType type = VT_UNKNOWN;
+
+    union
+    {
+        //! Double-type field pointer
+        num_t       *d = nullptr;
+        //! Float-type field pointer
+        numf_t      *f;
+        //! Int-type field pointer
+        short       *i16;
+        //! Int-type field pointer
+        int         *i32;
+        //! Boolean type field pointer
+        bool        *b;
+        //! String-type field pointer
+        std::string *s;
+    } field;
+
+    //! Lambda-type field
+    std::pair<Getter, Setter> field_lf;
+    //! String lambda-type field
+    std::pair<StrGetter, StrSetter> field_sf;
+};
+
+class SMBXMemoryEmulator
+{
+    typedef MemGlobalField::Getter Getter;
+    typedef MemGlobalField::Setter Setter;
+    typedef MemGlobalField::StrGetter StrGetter;
+    typedef MemGlobalField::StrSetter StrSetter;
+
+    //! Fields by address, the nodes are never moved, so the resolved fields stay valid
+    std::unordered_map<size_t, MemGlobalField> m_fields;
 
     void insert(size_t address, short *field)
     {
-        m_i16f.insert({address, field});
-        m_type.insert({address, VT_INT16});
+        MemGlobalField v;
+        v.type = MemGlobalField::VT_INT16;
+        v.field.i16 = field;
+        m_fields.insert({address, std::move(v)});
     }
 
     void insert(size_t address, int *field)
     {
-        m_i32f.insert({address, field});
-        m_type.insert({address, VT_INT32});
+        MemGlobalField v;
+        v.type = MemGlobalField::VT_INT32;
+        v.field.i32 = field;
+        m_fields.insert({address, std::move(v)});
     }
 
     void insert(size_t address, num_t *field)
     {
-        m_df.insert({address, field});
-        m_type.insert({address, VT_DOUBLE});
+        MemGlobalField v;
+        v.type = MemGlobalField::VT_DOUBLE;
+        v.field.d = field;
+        m_fields.insert({address, std::move(v)});
     }
 
     void insert(size_t address, numf_t *field)
     {
-        m_ff.insert({address, field});
-        m_type.insert({address, VT_FLOAT});
+        MemGlobalField v;
+        v.type = MemGlobalField::VT_FLOAT;
+        v.field.f = field;
+        m_fields.insert({address, std::move(v)});
     }
 
     void insert(size_t address, bool *field)
     {
-        m_bf.insert({address, field});
-        m_type.insert({address, VT_BOOL});
+        MemGlobalField v;
+        v.type = MemGlobalField::VT_BOOL;
+        v.field.b = field;
+        m_fields.insert({address, std::move(v)});
     }
 
     void insert(size_t address, std::string *field)
     {
-        m_sf.insert({address, field});
-        m_type.insert({address, VT_STRING});
+        MemGlobalField v;
+        v.type = MemGlobalField::VT_STRING;
+        v.field.s = field;
+        m_fields.insert({address, std::move(v)});
     }
 
     void insert(size_t address, Getter g, Setter s)
     {
-        m_lff.insert({address, {g, s}});
-        m_type.insert({address, VT_LAMBDA});
+        MemGlobalField v;
+        v.type = MemGlobalField::VT_LAMBDA;
+        v.field_lf = {g, s};
+        m_fields.insert({address, std::move(v)});
     }
 
     void insert(size_t address, StrGetter g, StrSetter s)
     {
-        m_sff.insert({address, {g, s}});
-        m_type.insert({address, VT_STRLAMBDA});
+        MemGlobalField v;
+        v.type = MemGlobalField::VT_STRLAMBDA;
+        v.field_sf = {g, s};
+        m_fields.insert({address, std::move(v)});
     }
 
 public:
@@ -752,7 +795,21 @@ public:
         // insert(0x00B2D734, &noSound);
     }
 
+    const MemGlobalField *resolve(size_t address) const
+    {
+        auto ft = m_fields.find(address);
+        if(ft == m_fields.end())
+            return nullptr;
+
+        return &ft->second;
+    }
+
     num_t getValue(size_t address, FIELDTYPE ftype)
+    {
+        return getValue(resolve(address), address, ftype);
+    }
+
+    num_t getValue(const MemGlobalField *t, size_t address, FIELDTYPE ftype)
     {
         if(ftype == FT_INVALID)
         {
@@ -760,89 +817,45 @@ public:
             return 0;
         }
 
-        auto ft = m_type.find(address);
-        if(ft == m_type.end())
+        if(!t)
         {
             pLogWarning("MemEmu: Unknown %s address to read: <Global> 0x%x", FieldtypeToStr(ftype), static_cast<unsigned>(address));
             return 0;
         }
 
-        switch(ft->second)
-        {
-        case VT_DOUBLE:
+        switch(t->type)
         {
-            auto dres = m_df.find(address);
-            if(dres != m_df.end())
-            {
-                if(ftype != FT_DFLOAT)
-                    pLogWarning("MemEmu: Read type missmatched at 0x%x (Double expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
+        case MemGlobalField::VT_DOUBLE:
+            if(ftype != FT_DFLOAT)
+                pLogWarning("MemEmu: Read type missmatched at 0x%x (Double expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
 
-                return valueToMem(*dres->second, ftype);
-            }
-            break;
-        }
+            return valueToMem(*t->field.d, ftype);
 
-        case VT_FLOAT:
-        {
-            auto fres = m_ff.find(address);
-            if(fres != m_ff.end())
-            {
-                if(ftype != FT_FLOAT)
-                    pLogWarning("MemEmu: Read type missmatched at 0x%x (Float expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
+        case MemGlobalField::VT_FLOAT:
+            if(ftype != FT_FLOAT)
+                pLogWarning("MemEmu: Read type missmatched at 0x%x (Float expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
 
-                return valueToMem(*fres->second, ftype);
-            }
-            break;
-        }
+            return valueToMem(*t->field.f, ftype);
 
-        case VT_INT32:
-        {
-            auto ires = m_i32f.find(address);
-            if(ires != m_i32f.end())
-            {
-                if(ftype != FT_DWORD && ftype != FT_WORD)
-                    pLogWarning("MemEmu: Read type missmatched at 0x%x (SInt16 or SInt32 expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
+        case MemGlobalField::VT_INT32:
+            if(ftype != FT_DWORD && ftype != FT_WORD)
+                pLogWarning("MemEmu: Read type missmatched at 0x%x (SInt16 or SInt32 expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
 
-                return valueToMem(*ires->second, ftype);
-            }
-            break;
-        }
+            return valueToMem(*t->field.i32, ftype);
 
-        case VT_INT16:
-        {
-            auto ires = m_i16f.find(address);
-            if(ires != m_i16f.end())
-            {
-                if(ftype != FT_WORD)
-                    pLogWarning("MemEmu: Read type missmatched at 0x%x (SInt16 expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
+        case MemGlobalField::VT_INT16:
+            if(ftype != FT_WORD)
+                pLogWarning("MemEmu: Read type missmatched at 0x%x (SInt16 expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
 
-                return valueToMem(*ires->second, ftype);
-            }
-            break;
-        }
+            return valueToMem(*t->field.i16, ftype);
 
-        case VT_BOOL:
-        {
-            auto bres = m_bf.find(address);
-            if(bres != m_bf.end())
-            {
-                if(ftype != FT_WORD && ftype != FT_BYTE)
-                    pLogWarning("MemEmu: Read type missmatched at 0x%x (Sint16 or Uint8 as boolean expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
-                return *bres->second ? 0xffff : 0x0000;
-            }
-            break;
-        }
+        case MemGlobalField::VT_BOOL:
+            if(ftype != FT_WORD && ftype != FT_BYTE)
+                pLogWarning("MemEmu: Read type missmatched at 0x%x (Sint16 or Uint8 as boolean expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
+            return *t->field.b ? 0xffff : 0x0000;
 
-        case VT_LAMBDA:
-        {
-            auto lfres = m_lff.find(address);
-            if(lfres != m_lff.end())
-            {
-                auto &l = lfres->second;
-                return l.first(ftype);
-            }
-            break;
-        }
+        case MemGlobalField::VT_LAMBDA:
+            return t->field_lf.first(ftype);
 
         default:
             break;
@@ -852,6 +865,11 @@ public:
     }
 
     void setValue(size_t address, num_t value, FIELDTYPE ftype)
+    {
+        setValue(resolve(address), address, value, ftype);
+    }
+
+    void setValue(const MemGlobalField *t, size_t address, num_t value, FIELDTYPE ftype)
     {
         if(ftype == FT_INVALID)
         {
@@ -859,94 +877,51 @@ public:
             return;
         }
 
-        auto ft = m_type.find(address);
-        if(ft == m_type.end())
+        if(!t)
         {
             pLogWarning("MemEmu: Unknown %s address to write: 0x%x", FieldtypeToStr(ftype), static_cast<unsigned>(address));
             return;
         }
 
-        switch(ft->second)
+        switch(t->type)
         {
-        case VT_DOUBLE:
-        {
-            auto dres = m_df.find(address);
-            if(dres != m_df.end())
-            {
-                if(ftype != FT_DFLOAT)
-                    pLogWarning("MemEmu: Write type missmatched at 0x%x (Double expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
+        case MemGlobalField::VT_DOUBLE:
+            if(ftype != FT_DFLOAT)
+                pLogWarning("MemEmu: Write type missmatched at 0x%x (Double expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
 
-                memToValue(*dres->second, value, ftype);
-                return;
-            }
-            break;
-        }
+            memToValue(*t->field.d, value, ftype);
+            return;
 
-        case VT_FLOAT:
-        {
-            auto fres = m_ff.find(address);
-            if(fres != m_ff.end())
-            {
-                if(ftype != FT_FLOAT)
-                    pLogWarning("MemEmu: Write type missmatched at 0x%x (Float expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
+        case MemGlobalField::VT_FLOAT:
+            if(ftype != FT_FLOAT)
+                pLogWarning("MemEmu: Write type missmatched at 0x%x (Float expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
 
-                memToValue(*fres->second, value, ftype);
-                return;
-            }
-            break;
-        }
+            memToValue(*t->field.f, value, ftype);
+            return;
 
-        case VT_INT32:
-        {
-            auto ires = m_i32f.find(address);
-            if(ires != m_i32f.end())
-            {
-                if(ftype != FT_DWORD && ftype != FT_WORD)
-                    pLogWarning("MemEmu: Write type missmatched at 0x%x (SInt16 or SInt32 expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
+        case MemGlobalField::VT_INT32:
+            if(ftype != FT_DWORD && ftype != FT_WORD)
+                pLogWarning("MemEmu: Write type missmatched at 0x%x (SInt16 or SInt32 expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
 
-                memToValue(*ires->second, value, ftype);
-                return;
-            }
-            break;
-        }
+            memToValue(*t->field.i32, value, ftype);
+            return;
 
-        case VT_INT16:
-        {
-            auto ires = m_i16f.find(address);
-            if(ires != m_i16f.end())
-            {
-                if(ftype != FT_WORD)
-                    pLogWarning("MemEmu: Write type missmatched at 0x%x (SInt16 expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
+        case MemGlobalField::VT_INT16:
+            if(ftype != FT_WORD)
+                pLogWarning("MemEmu: Write type missmatched at 0x%x (SInt16 expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
 
-                memToValue(*ires->second, value, ftype);
-                return;
-            }
-            break;
-        }
+            memToValue(*t->field.i16, value, ftype);
+            return;
 
-        case VT_BOOL:
-        {
-            auto bres = m_bf.find(address);
-            if(bres != m_bf.end())
-            {
-                if(ftype != FT_WORD && ftype != FT_BYTE)
-                    pLogWarning("MemEmu: Write type missmatched at 0x%x (Sint16 or Uint8 as boolean expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
-                *bres->second = (value != 0);
-                return;
-            }
-            break;
-        }
+        case MemGlobalField::VT_BOOL:
+            if(ftype != FT_WORD && ftype != FT_BYTE)
+                pLogWarning("MemEmu: Write type missmatched at 0x%x (Sint16 or Uint8 as boolean expected, %s actually)", static_cast<unsigned>(address), FieldtypeToStr(ftype));
+            *t->field.b = (value != 0);
+            return;
 
-        case VT_LAMBDA:
-        {
-            auto lfres = m_lff.find(address);
-            if(lfres != m_lff.end())
-            {
-                auto &l = lfres->second;
-                l.second(value, ftype);
-            }
-            break;
-        }
+        case MemGlobalField::VT_LAMBDA:
+            t->field_lf.second(value, ftype);
+            return;
 
         default:
             break;
@@ -2318,24 +2293,38 @@ SDL_FORCE_INLINE void opXor(D &mem, size_t addr, num_t o2, FIELDTYPE ftype)
 }
 
 
-void MemAssign(size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype)
+/*!
+ * \brief Global memory bound to the field resolved for the address, to run the operations on
+ */
+struct GlobalFieldRef
 {
-    if((address < GM_BASE) || (address > GM_END))
+    const MemGlobalField *t;
+
+    num_t getValue(size_t address, FIELDTYPE ftype)
     {
-        pLogWarning("MemEmu: MemAssign Requested value of out-of-range global address: 0x%x", static_cast<unsigned>(address));
-        return;
+        return s_emu.getValue(t, address, ftype);
     }
 
+    void setValue(size_t address, num_t value, FIELDTYPE ftype)
+    {
+        s_emu.setValue(t, address, value, ftype);
+    }
+};
+
+static void s_memAssign(const MemGlobalField *field, size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype)
+{
     if(ftype == FT_INVALID)
         return;
 
     if(operation == OP_Div && value == 0)
         return;
 
+    GlobalFieldRef mem{field};
+
     switch(operation)
     {
     case OP_Assign:
-        s_emu.setValue(address, value, ftype);
+        mem.setValue(address, value, ftype);
         break;
 
     case OP_Add:
@@ -2344,26 +2333,26 @@ void MemAssign(size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype)
         {
         case FT_BYTE:
         {
-            opAdd<uint8_t>(s_emu, address, value, ftype);
+            opAdd<uint8_t>(mem, address, value, ftype);
             break;
         }
         case FT_WORD:
         {
-            opAdd<int16_t>(s_emu, address, value, ftype);
+            opAdd<int16_t>(mem, address, value, ftype);
             break;
         }
         case FT_DWORD:
         {
-            opAdd<int32_t>(s_emu, address, value, ftype);
+            opAdd<int32_t>(mem, address, value, ftype);
             break;
         }
         case FT_FLOAT:
         {
-            opAdd<numf_t>(s_emu, address, value, ftype);
+            opAdd<numf_t>(mem, address, value, ftype);
             break;
         }
         case FT_DFLOAT:
-            opAdd<num_t>(s_emu, address, value, ftype);
+            opAdd<num_t>(mem, address, value, ftype);
             break;
         default:
             break;
@@ -2377,26 +2366,26 @@ void MemAssign(size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype)
         {
         case FT_BYTE:
         {
-            opSub<uint8_t>(s_emu, address, value, ftype);
+            opSub<uint8_t>(mem, address, value, ftype);
             break;
         }
         case FT_WORD:
         {
-            opSub<int16_t>(s_emu, address, value, ftype);
+            opSub<int16_t>(mem, address, value, ftype);
             break;
         }
         case FT_DWORD:
         {
-            opSub<int32_t>(s_emu, address, value, ftype);
+            opSub<int32_t>(mem, address, value, ftype);
             break;
         }
         case FT_FLOAT:
         {
-            opSub<numf_t>(s_emu, address, value, ftype);
+            opSub<numf_t>(mem, address, value, ftype);
             break;
         }
         case FT_DFLOAT:
-            opSub<num_t>(s_emu, address, value, ftype);
+            opSub<num_t>(mem, address, value, ftype);
             break;
         default:
             break;
@@ -2410,26 +2399,26 @@ void MemAssign(size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype)
         {
         case FT_BYTE:
         {
-            opMul<uint8_t>(s_emu, address, value, ftype);
+            opMul<uint8_t>(mem, address, value, ftype);
             break;
         }
         case FT_WORD:
         {
-            opMul<int16_t>(s_emu, address, value, ftype);
+            opMul<int16_t>(mem, address, value, ftype);
             break;
         }
         case FT_DWORD:
         {
-            opMul<int32_t>(s_emu, address, value, ftype);
+            opMul<int32_t>(mem, address, value, ftype);
             break;
         }
         case FT_FLOAT:
         {
-            opMul_numf_t(s_emu, address, value, ftype);
+            opMul_numf_t(mem, address, value, ftype);
             break;
         }
         case FT_DFLOAT:
-            opMul_num_t(s_emu, address, value, ftype);
+            opMul_num_t(mem, address, value, ftype);
             break;
         default:
             break;
@@ -2443,26 +2432,26 @@ void MemAssign(size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype)
         {
         case FT_BYTE:
         {
-            opDiv<uint8_t>(s_emu, address, value, ftype);
+            opDiv<uint8_t>(mem, address, value, ftype);
             break;
         }
         case FT_WORD:
         {
-            opDiv<int16_t>(s_emu, address, value, ftype);
+            opDiv<int16_t>(mem, address, value, ftype);
             break;
         }
         case FT_DWORD:
         {
-            opDiv<int32_t>(s_emu, address, value, ftype);
+            opDiv<int32_t>(mem, address, value, ftype);
             break;
         }
         case FT_FLOAT:
         {
-            opDiv_numf_t(s_emu, address, value, ftype);
+            opDiv_numf_t(mem, address, value, ftype);
             break;
         }
         case FT_DFLOAT:
-            opDiv_num_t(s_emu, address, value, ftype);
+            opDiv_num_t(mem, address, value, ftype);
             break;
         default:
             break;
@@ -2476,17 +2465,17 @@ void MemAssign(size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype)
         {
         case FT_BYTE:
         {
-            opXor<uint8_t>(s_emu, address, value, ftype);
+            opXor<uint8_t>(mem, address, value, ftype);
             break;
         }
         case FT_WORD:
         {
-            opXor<int16_t>(s_emu, address, value, ftype);
+            opXor<int16_t>(mem, address, value, ftype);
             break;
         }
         case FT_DWORD:
         {
-            opXor<int32_t>(s_emu, address, value, ftype);
+            opXor<int32_t>(mem, address, value, ftype);
             break;
         }
         default:
@@ -2500,15 +2489,9 @@ void MemAssign(size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype)
     }// switch on op
 }
 
-bool CheckMem(size_t address, num_t value, COMPARETYPE ctype, FIELDTYPE ftype)
+static bool s_checkMem(const MemGlobalField *field, size_t address, num_t value, COMPARETYPE ctype, FIELDTYPE ftype)
 {
-    if((address < GM_BASE) || (address > GM_END))
-    {
-        pLogWarning("MemEmu: CheckMem Requested value of out-of-range global address: 0x%x", static_cast<unsigned>(address));
-        return false;
-    }
-
-    num_t cur = s_emu.getValue(address, ftype);
+    num_t cur = s_emu.getValue(field, address, ftype);
 
     switch(ctype)
     {
@@ -2584,15 +2567,9 @@ bool CheckMem(size_t address, num_t value, COMPARETYPE ctype, FIELDTYPE ftype)
     return false;
 }
 
-num_t GetMem(size_t addr, FIELDTYPE ftype)
+static num_t s_getMem(const MemGlobalField *field, size_t addr, FIELDTYPE ftype)
 {
-    if((addr < GM_BASE) || (addr > GM_END))
-    {
-        pLogWarning("MemEmu: GetMem Requested value of out-of-range global address: 0x%x", static_cast<unsigned>(addr));
-        return 0;
-    }
-
-    num_t cur = s_emu.getValue(addr, ftype);
+    num_t cur = s_emu.getValue(field, addr, ftype);
 
     switch(ftype)
     {
@@ -2610,6 +2587,76 @@ num_t GetMem(size_t addr, FIELDTYPE ftype)
     }
 }
 
+static inline bool s_globalInRange(size_t address)
+{
+    return address >= GM_BASE && address <= GM_END;
+}
+
+const MemGlobalField *MemResolve(size_t address)
+{
+    if(!s_globalInRange(address))
+        return nullptr;
+
+    return s_emu.resolve(address);
+}
+
+void MemAssign(size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype)
+{
+    if(!s_globalInRange(address))
+    {
+        pLogWarning("MemEmu: MemAssign Requested value of out-of-range global address: 0x%x", static_cast<unsigned>(address));
+        return;
+    }
+
+    s_memAssign(s_emu.resolve(address), address, value, operation, ftype);
+}
+
+bool CheckMem(size_t address, num_t value, COMPARETYPE ctype, FIELDTYPE ftype)
+{
+    if(!s_globalInRange(address))
+    {
+        pLogWarning("MemEmu: CheckMem Requested value of out-of-range global address: 0x%x", static_cast<unsigned>(address));
+        return false;
+    }
+
+    return s_checkMem(s_emu.resolve(address), address, value, ctype, ftype);
+}
+
+num_t GetMem(size_t addr, FIELDTYPE ftype)
+{
+    if(!s_globalInRange(addr))
+    {
+        pLogWarning("MemEmu: GetMem Requested value of out-of-range global address: 0x%x", static_cast<unsigned>(addr));
+        return 0;
+    }
+
+    return s_getMem(s_emu.resolve(addr), addr, ftype);
+}
+
+void MemAssign(const MemGlobalField *field, size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype)
+{
+    if(!field)
+        MemAssign(address, value, operation, ftype);
+    else
+        s_memAssign(field, address, value, operation, ftype);
+}
+
+bool CheckMem(const MemGlobalField *field, size_t address, num_t value, COMPARETYPE ctype, FIELDTYPE ftype)
+{
+    if(!field)
+        return CheckMem(address, value, ctype, ftype);
+
+    return s_checkMem(field, address, value, ctype, ftype);
+}
+
+num_t GetMem(const MemGlobalField *field, size_t addr, FIELDTYPE ftype)
+{
+    if(!field)
+        return GetMem(addr, ftype);
+
+    return s_getMem(field, addr, ftype);
+}
+
 
 template<typename T, class D, class U>
 SDL_FORCE_INLINE void opAdd(D &mem, U *obj, size_t addr, num_t o2, FIELDTYPE ftype)
@@ -26,6 +26,7 @@
 
 struct Player_t;
 struct NPC_t;
+struct MemGlobalField;
 
 #define GM_BASE             0x00B25000
 #define GM_END              0x00B2E000
@@ -35,6 +36,19 @@ void MemAssign(size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype);
 bool CheckMem(size_t address, num_t value, COMPARETYPE ctype, FIELDTYPE ftype);
 num_t GetMem(size_t addr, FIELDTYPE ftype);
 
+/*!
+ * \brief Resolve the global address once, to skip the address lookup on every access
+ * \param address Global address
+ * \return Field at the address, or nullptr if the address is out of range or unknown
+ *
+ * Passing the resolved field with the same address gives the same result as the plain calls,
+ * including the warnings: the nullptr field falls back to them.
+ */
+const MemGlobalField *MemResolve(size_t address);
+void MemAssign(const MemGlobalField *field, size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype);
+bool CheckMem(const MemGlobalField *field, size_t address, num_t value, COMPARETYPE ctype, FIELDTYPE ftype);
+num_t GetMem(const MemGlobalField *field, size_t addr, FIELDTYPE ftype);
+
 // Player relative
 void MemAssign(Player_t *obj, size_t address, num_t value, OPTYPE operation, FIELDTYPE ftype);
 bool CheckMem(Player_t *obj, size_t offset, num_t value, COMPARETYPE ctype, FIELDTYPE ftype);
@@ -23,6 +23,7 @@
 #include "npc_traits.h"
 
 #include <algorithm>
+#include <vector>
 
 // these are now used only when saving levels
 void qSortBlocksY(int min, int max)
@@ -621,50 +622,105 @@ void qSortSBlocks(int min, int max)
 }
 #endif
 
-void qSortNPCsY(int min, int max)
+struct NPCSortKey_t
+{
+    num_t Y;
+    int index;
+};
+
+// the original quicksort, running over the keys instead of NPC_t copies
+static void s_qSortNPCKeysY(NPCSortKey_t* keys, int min, int max)
 {
-    NPC_t medNPC;
+    NPCSortKey_t medNPC;
     int hi = 0;
     int lo = 0;
     int i = 0;
-    if(min >= max)
-        return;
-    i = (max + min) / 2;
-    medNPC = NPC[i];
-    NPC[i] = NPC[min];
-    lo = min;
-    hi = max;
-    do
+
+    while(min < max)
     {
-        while(NPC[hi].Location.Y < medNPC.Location.Y)
-        {
-            hi -= 1;
+        i = (max + min) / 2;
+        medNPC = keys[i];
+        keys[i] = keys[min];
+        lo = min;
+        hi = max;
+        do
+        {
+            while(keys[hi].Y < medNPC.Y)
+            {
+                hi -= 1;
+                if(hi <= lo)
+                    break;
+            }
             if(hi <= lo)
+            {
+                keys[lo] = medNPC;
                 break;
-        }
-        if(hi <= lo)
-        {
-            NPC[lo] = medNPC;
-            break;
-        }
-        NPC[lo] = NPC[hi];
-        lo += 1;
-        while(NPC[lo].Location.Y >= medNPC.Location.Y)
-        {
+            }
+            keys[lo] = keys[hi];
             lo += 1;
+            while(keys[lo].Y >= medNPC.Y)
+            {
+                lo += 1;
+                if(lo >= hi)
+                    break;
+            }
             if(lo >= hi)
+            {
+                lo = hi;
+                keys[hi] = medNPC;
                 break;
+            }
+            keys[hi] = keys[lo];
+        } while(true);
+
+        // both halves are independent: recurse into the smaller one to keep the stack shallow
+        if(lo - min < max - lo)
+        {
+            s_qSortNPCKeysY(keys, min, lo - 1);
+            min = lo + 1;
         }
-        if(lo >= hi)
+        else
         {
-            lo = hi;
-            NPC[hi] = medNPC;
-            break;
+            s_qSortNPCKeysY(keys, lo + 1, max);
+            max = lo - 1;
         }
-        NPC[hi] = NPC[lo];
-    } while(true);
-    qSortNPCsY(min, lo - 1);
-    qSortNPCsY(lo + 1, max);
+    }
+}
+
+void qSortNPCsY(int min, int max)
+{
+    if(min >= max)
+        return;
+
+    std::vector<NPCSortKey_t> keys(max - min + 1);
+
+    for(int i = min; i <= max; i++)
+        keys[i - min] = {NPC[i].Location.Y, i};
+
+    // the pivot choice doesn't depend on the offset of the range
+    s_qSortNPCKeysY(keys.data(), 0, max - min);
+
+    // apply the permutation following its cycles, so every NPC is moved only once
+    for(int i = min; i <= max; i++)
+    {
+        int src = keys[i - min].index;
+        if(src == i || src < 0)
+            continue;
+
+        NPC_t tmp = std::move(NPC[i]);
+        int dst = i;
+
+        while(src != i)
+        {
+            NPC[dst] = std::move(NPC[src]);
+            keys[dst - min].index = -1;
+            dst = src;
+            src = keys[dst - min].index;
+        }
+
+        NPC[dst] = std::move(tmp);
+        keys[dst - min].index = -1;
+    }
 }
 
 void UpdateBackgrounds()
@@ -24,6 +24,10 @@
 #include "sdl_proxy/sdl_timer.h"
 #include "sdl_proxy/mixer.h"
 
+#ifndef PGE_NO_THREADING
+#include <SDL2/SDL_thread.h>
+#endif
+
 #include "globals.h"
 #include "config.h"
 #include "global_dirs.h"
@@ -33,6 +37,7 @@
 #include "load_gfx.h"
 #include "core/msgbox.h"
 #include "main/screen_progress.h"
+#include "main/run_ahead.h"
 
 #include "sound.h"
 #include "sound_thread.h"
@@ -244,15 +249,204 @@ static const char *audio_format_to_string(SDL_AudioFormat f)
 }
 #endif
 
+/*
+ * Decoded SFX are shared through a bank keyed by the file content: a custom
+ * sound that is a copy of the default one (or of one used by another level)
+ * is decoded once and used by all sound slots. Chunks nobody references
+ * anymore stay in the bank while it fits the `audio-sfx-cache` budget, so
+ * the next level using them doesn't decode them again; past the budget,
+ * the least recently used idle chunks are freed first.
+ */
+struct SfxBankEntry_t
+{
+    Mix_Chunk  *chunk = nullptr;
+    size_t      bytes = 0;
+    int         refs = 0;
+    uint64_t    lastUse = 0;
+};
+
+static std::unordered_map<uint64_t, SfxBankEntry_t> s_sfxBank;
+static std::unordered_map<Mix_Chunk*, uint64_t>     s_sfxBankKeys;
+static size_t   s_sfxBankBytes = 0;
+static uint64_t s_sfxBankClock = 0;
+
+static uint64_t s_sfxContentHash(const unsigned char *data, size_t size)
+{
+    // FNV-1a, mixed with the size to make collisions of different-length files even less likely
+    uint64_t hash = 14695981039346656037ULL;
+
+    for(size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash ^ ((uint64_t)size * 0x9E3779B97F4A7C15ULL);
+}
+
+//! Memory taken by the decoded chunk; custom mixers don't expose it, the file size is used for them instead
+static size_t s_sfxChunkBytes(Mix_Chunk *chunk, size_t fileSize)
+{
+#ifndef CUSTOM_AUDIO
+    UNUSED(fileSize);
+    return chunk ? (size_t)chunk->alen : 0;
+#else
+    UNUSED(chunk);
+    return fileSize;
+#endif
+}
+
+static void s_sfxBankTrim()
+{
+    const size_t budget = (size_t)g_config.audio_sfx_cache * 1024 * 1024;
+
+    while(s_sfxBankBytes > budget)
+    {
+        auto victim = s_sfxBank.end();
+
+        for(auto it = s_sfxBank.begin(); it != s_sfxBank.end(); ++it)
+        {
+            if(it->second.refs == 0 && (victim == s_sfxBank.end() || it->second.lastUse < victim->second.lastUse))
+                victim = it;
+        }
+
+        if(victim == s_sfxBank.end())
+            break; // Everything left is in use
+
+        s_sfxBankBytes -= victim->second.bytes;
+        s_sfxBankKeys.erase(victim->second.chunk);
+        Mix_FreeChunk(victim->second.chunk);
+        s_sfxBank.erase(victim);
+    }
+}
+
+static Mix_Chunk *s_sfxBankAcquire(uint64_t key)
+{
+    auto it = s_sfxBank.find(key);
+    if(it == s_sfxBank.end())
+        return nullptr;
+
+    it->second.refs++;
+    it->second.lastUse = ++s_sfxBankClock;
+    return it->second.chunk;
+}
+
+static void s_sfxBankInsert(uint64_t key, Mix_Chunk *chunk, size_t fileSize)
+{
+    SfxBankEntry_t &e = s_sfxBank[key];
+    e.chunk = chunk;
+    e.bytes = s_sfxChunkBytes(chunk, fileSize);
+    e.refs = 1;
+    e.lastUse = ++s_sfxBankClock;
+
+    s_sfxBankKeys[chunk] = key;
+    s_sfxBankBytes += e.bytes;
+
+    s_sfxBankTrim();
+}
+
+static void s_sfxBankRelease(Mix_Chunk *chunk)
+{
+    if(!chunk)
+        return;
+
+    auto k = s_sfxBankKeys.find(chunk);
+    if(k == s_sfxBankKeys.end())
+    {
+        Mix_FreeChunk(chunk); // Not owned by the bank
+        return;
+    }
+
+    auto &e = s_sfxBank[k->second];
+    SDL_assert_release(e.refs > 0);
+
+    if(--e.refs == 0)
+    {
+        e.lastUse = ++s_sfxBankClock;
+        s_sfxBankTrim();
+    }
+}
+
+//! Frees all idle chunks, must be called after all sound slots were released
+static void s_sfxBankClear()
+{
+    for(auto &it : s_sfxBank)
+    {
+        if(it.second.refs > 0)
+            pLogWarning("SFX bank: a chunk is still in use (%d references) while clearing", it.second.refs);
+
+        Mix_FreeChunk(it.second.chunk);
+    }
+
+    s_sfxBank.clear();
+    s_sfxBankKeys.clear();
+    s_sfxBankBytes = 0;
+}
+
+/*!
+ * \brief Load an SFX file either as a chunk (shared through the bank), or as a multi-music if it's long
+ * \param path Full path to the file
+ * \param chunk [out] loaded chunk, or nullptr
+ * \param music [out] loaded multi-music, or nullptr
+ */
+static void s_loadSfxFile(const std::string &path, Mix_Chunk *&chunk, Mix_Music *&music)
+{
+    chunk = nullptr;
+    music = nullptr;
+
+    Files::Data data = Files::load_file(path);
+    if(!data.valid() || data.empty())
+    {
+        // Let the mixer report the error
+        chunk = Mix_LoadWAV(path.c_str());
+        return;
+    }
+
+    uint64_t key = s_sfxContentHash(data.begin(), data.size());
+
+    chunk = s_sfxBankAcquire(key);
+    if(chunk)
+    {
+        pLogDebug("SFX bank: reusing decoded data for '%s'", path.c_str());
+        return;
+    }
+
+    music = Mix_LoadMUS(path.c_str());
+    if(music)
+    {
+        // check, if short enough, load it as a chunk instead
+        double duration = Mix_MusicDuration(music);
+        if(duration >= 0 && duration < c_max_chunk_duration)
+        {
+            Mix_FreeMusic(music);
+            music = nullptr;
+        }
+        else
+        {
+            pLogInfo("Will load SFX %s as a multi-music", path.c_str());
+            return;
+        }
+    }
+
+#ifndef CUSTOM_AUDIO
+    // The file is already in memory, don't read it again
+    SDL_RWops *src = SDL_RWFromConstMem(data.begin(), (int)data.size());
+    chunk = src ? Mix_LoadWAV_RW(src, 1) : nullptr;
+#else
+    chunk = Mix_LoadWAV(path.c_str());
+#endif
+
+    if(chunk)
+        s_sfxBankInsert(key, chunk, data.size());
+}
+
 static void clear_sfx(SFX_t &s)
 {
-    if(s.chunk)
-        Mix_FreeChunk(s.chunk);
+    s_sfxBankRelease(s.chunk);
 
     s.chunk = nullptr;
 
-    if(s.chunkOrig)
-        Mix_FreeChunk(s.chunkOrig);
+    s_sfxBankRelease(s.chunkOrig);
 
     s.chunkOrig = nullptr;
 
@@ -419,6 +613,9 @@ void RestartMixerX()
         StartMusic(recent_music);
 }
 
+// defined below, together with PrefetchSectionMusic()
+static void s_musicPrefetchReset();
+
 void QuitMixerX()
 {
     if(!g_mixerLoaded)
@@ -428,6 +625,8 @@ void QuitMixerX()
 
     UnloadExtSounds();
 
+    s_musicPrefetchReset();
+
     if(g_curMusic)
         Mix_FreeMusic(g_curMusic);
 
@@ -442,6 +641,7 @@ void QuitMixerX()
 
     sound.clear();
     music.clear();
+    s_sfxBankClear();
 
     Mix_CloseAudio();
     Mix_Quit();
@@ -488,8 +688,7 @@ static void RestoreSfx(SFX_t &u)
 {
     if(u.isCustom)
     {
-        if(u.chunk)
-            Mix_FreeChunk(u.chunk);
+        s_sfxBankRelease(u.chunk);
 
         if(u.music)
             Mix_FreeMusic(u.music);
@@ -555,24 +754,7 @@ static void AddSfx(SoundScope root,
                 m.isSilent = false;
 
                 if(!isSilent)
-                {
-                    m.music = Mix_LoadMUS((newPath).c_str());
-                    if(m.music)
-                    {
-                        // check, if short enough, load it as a chunk instead
-                        double duration = Mix_MusicDuration(m.music);
-                        if(duration >= 0 && duration < c_max_chunk_duration)
-                        {
-                            Mix_FreeMusic(m.music);
-                            m.music = nullptr;
-                        }
-                        else
-                            pLogInfo("Will load SFX %s as a multi-music", newPath.c_str());
-                    }
-
-                    if(!m.music)
-                        m.chunk = Mix_LoadWAV((newPath).c_str());
-                }
+                    s_loadSfxFile(newPath, m.chunk, m.music);
 
                 if(m.chunk || m.music || isSilent)
                 {
@@ -584,8 +766,7 @@ static void AddSfx(SoundScope root,
                     }
                     else
                     {
-                        if(backup_chunk)
-                            Mix_FreeChunk(backup_chunk);
+                        s_sfxBankRelease(backup_chunk);
 
                         if(backup_music)
                             Mix_FreeMusic(backup_music);
@@ -617,24 +798,7 @@ static void AddSfx(SoundScope root,
             m.isSilent = isSilent;
             pLogDebug("Adding SFX [sound%d] '%s'", alias, isSilent ? "<silence>" : m.path.c_str());
             if(!isSilent)
-            {
-                m.music = Mix_LoadMUS((m.path).c_str());
-                if(m.music)
-                {
-                    // check, if short enough, load it as a chunk instead
-                    double duration = Mix_MusicDuration(m.music);
-                    if(duration >= 0 && duration < c_max_chunk_duration)
-                    {
-                        Mix_FreeMusic(m.music);
-                        m.music = nullptr;
-                    }
-                    else
-                        pLogInfo("Will load SFX %s as a multi-music", m.path.c_str());
-                }
-
-                if(!m.music)
-                    m.chunk = Mix_LoadWAV((m.path).c_str());
-            }
+                s_loadSfxFile(m.path, m.chunk, m.music);
 
             if(m.chunk || m.music || isSilent)
             {
@@ -686,6 +850,10 @@ void SoundResumeAll()
     if(!g_mixerLoaded)
         return;
 
+    // NEW: the sound stays muted in the fast-forward mode
+    if(fastForwardActive())
+        return;
+
     pLogDebug("Resume all sound");
     Mix_PauseAudio(0);
 }
@@ -695,6 +863,9 @@ void SoundPauseEngine(int paused)
     if(!g_mixerLoaded)
         return;
 
+    if(fastForwardActive())
+        paused = 1;
+
     Mix_PauseAudio(paused);
 }
 
@@ -727,6 +898,150 @@ static void processPathArgs(std::string &path,
     path = p[0] + "|" + p[1];
 }
 
+#ifndef PGE_NO_THREADING
+// music of an upcoming section, opened on a background thread by PrefetchSectionMusic()
+struct MusicPrefetch_t
+{
+    //! processed path that was passed into Mix_LoadMUS()
+    std::string path;
+    //! opened music, only valid after the thread has been joined
+    Mix_Music *music = nullptr;
+    SDL_Thread *thread = nullptr;
+};
+
+static MusicPrefetch_t s_musicPrefetch;
+
+static int s_musicPrefetchThread(void *)
+{
+    s_musicPrefetch.music = Mix_LoadMUS(s_musicPrefetch.path.c_str());
+    return 0;
+}
+
+static void s_musicPrefetchJoin()
+{
+    if(s_musicPrefetch.thread)
+    {
+        SDL_WaitThread(s_musicPrefetch.thread, nullptr);
+        s_musicPrefetch.thread = nullptr;
+    }
+}
+
+static void s_musicPrefetchReset()
+{
+    s_musicPrefetchJoin();
+
+    if(s_musicPrefetch.music)
+        Mix_FreeMusic(s_musicPrefetch.music);
+
+    s_musicPrefetch.music = nullptr;
+    s_musicPrefetch.path.clear();
+}
+
+// returns the prefetched music if it matches the path (waiting for it if still opening), otherwise opens it directly
+static Mix_Music *s_loadMusic(const std::string &path)
+{
+    if(!s_musicPrefetch.path.empty() && s_musicPrefetch.path == path)
+    {
+        s_musicPrefetchJoin();
+
+        Mix_Music *ret = s_musicPrefetch.music;
+        s_musicPrefetch.music = nullptr;
+        s_musicPrefetch.path.clear();
+
+        if(ret)
+        {
+            D_pLogDebug("Using prefetched music [%s]", path.c_str());
+            return ret;
+        }
+    }
+
+    return Mix_LoadMUS(path.c_str());
+}
+#else
+static inline void s_musicPrefetchReset() {}
+
+static inline Mix_Music *s_loadMusic(const std::string &path)
+{
+    return Mix_LoadMUS(path.c_str());
+}
+#endif
+
+// processed path of the level music of section A, empty if it's not known
+static std::string s_sectionMusicPath(int A, int *yoshiModeTrack = nullptr)
+{
+    if(bgMusic[A] == g_customLvlMusicId)
+    {
+        std::string p = FileNamePath + CustomMusic[A];
+        processPathArgs(p, FileNamePath, FileName + "/", yoshiModeTrack);
+        return p;
+    }
+
+    auto mus = music.find(fmt::format_ne("music{0}", bgMusic[A]));
+    if(mus == music.end())
+        return std::string();
+
+    std::string p = mus->second.path;
+    processPathArgs(p, FileNamePath + "/", FileName + "/");
+    return p;
+}
+
+// extensions of the MIDI-like sequenced music formats, played through a synthesizer
+static const char *const s_sequencedMusicFormats[] =
+{
+    ".mid", ".midi", ".rmi", ".mus", ".kar", ".xmi", ".cmf"
+};
+
+void PrefetchSectionMusic(int section)
+{
+#ifndef PGE_NO_THREADING
+    if(!g_mixerLoaded || (int)g_config.audio_mus_volume == 0 || XMessage::GetStatus() == XMessage::Status::replay)
+        return;
+
+    if(section < 0 || section > maxSections || bgMusic[section] <= 0)
+        return;
+
+    // P-Switch music will keep playing
+    if(PSwitchTime != 0 || PSwitchStop != 0)
+        return;
+
+    // the section plays the same music as the current one, it won't be restarted
+    if(g_curMusic && curMusic == bgMusic[section])
+    {
+        if(curMusic != g_customLvlMusicId || s_recentMusicA == section)
+            return;
+
+        if(s_recentMusicA >= 0 && s_recentMusicA <= maxSections && CustomMusic[s_recentMusicA] == CustomMusic[section])
+            return;
+    }
+
+    std::string p = s_sectionMusicPath(section);
+
+    if(p.empty() || p == s_musicPrefetch.path)
+        return;
+
+    // MIDI synthesizers may share global state between streams, keep opening them at the main thread
+    std::string file = Files::basename(p.substr(0, p.find('|')));
+
+    for(const char *ext : s_sequencedMusicFormats)
+    {
+        if(Files::hasSuffix(file, ext))
+            return;
+    }
+
+    s_musicPrefetchReset();
+
+    s_musicPrefetch.path = std::move(p);
+    s_musicPrefetch.thread = SDL_CreateThread(s_musicPrefetchThread, "MusicPrefetch", nullptr);
+
+    if(!s_musicPrefetch.thread)
+        s_musicPrefetch.path.clear();
+    else
+        D_pLogDebug("Prefetching music of section %d [%s]", section, s_musicPrefetch.path.c_str());
+#else
+    UNUSED(section);
+#endif
+}
+
 void PlayMusic(const std::string &Alias, int fadeInMs)
 {
     if(!g_mixerLoaded)
@@ -747,7 +1062,7 @@ void PlayMusic(const std::string &Alias, int fadeInMs)
         auto &m = mus->second;
         std::string p = m.path;
         processPathArgs(p, FileNamePath + "/", FileName + "/");
-        g_curMusic = Mix_LoadMUS(p.c_str());
+        g_curMusic = s_loadMusic(p);
 
         if(!g_curMusic)
             pLogWarning("Music '%s' opening error: %s", m.path.c_str(), Mix_GetError());
@@ -819,6 +1134,9 @@ void PlaySfx_Blocking(int Alias, int loops, int volume, uint8_t left, uint8_t ri
 
 void StopSfx(int Alias)
 {
+    if(RunAhead::hiddenFrame())
+        return;
+
     auto sfx = sound.find(Alias);
     if(sfx != sound.end())
     {
@@ -868,6 +1186,9 @@ void delayedMusicReset()
 
 void StartMusic(int A, int fadeInMs)
 {
+    if(RunAhead::hiddenFrame())
+        return;
+
     if(s_delayMusic)
     {
         s_delayedMusicA = A;
@@ -958,10 +1279,9 @@ void StartMusic(int A, int fadeInMs)
             pLogDebug("Starting custom music [%s%s]", FileNamePath.c_str(), CustomMusic[A].c_str());
             if(g_curMusic)
                 Mix_FreeMusic(g_curMusic);
-            std::string p = FileNamePath + CustomMusic[A];
             s_musicYoshiTrackNumber = -1;
-            processPathArgs(p, FileNamePath, FileName + "/", &s_musicYoshiTrackNumber);
-            g_curMusic = Mix_LoadMUS(p.c_str());
+            std::string p = s_sectionMusicPath(A, &s_musicYoshiTrackNumber);
+            g_curMusic = s_loadMusic(p);
             if(!g_curMusic)
                 pLogWarning("Failed to open the music [%s]: %s", p.c_str(), Mix_GetError());
             else
@@ -1016,7 +1336,7 @@ void StartMusicIfOnscreen(int section)
 
 void PauseMusic()
 {
-    if(!musicPlaying || !g_mixerLoaded)
+    if(!musicPlaying || !g_mixerLoaded || RunAhead::hiddenFrame())
         return;
 
     if(g_curMusic && Mix_PlayingMusicStream(g_curMusic))
@@ -1025,7 +1345,7 @@ void PauseMusic()
 
 void ResumeMusic()
 {
-    if(!musicPlaying || !g_mixerLoaded)
+    if(!musicPlaying || !g_mixerLoaded || RunAhead::hiddenFrame())
         return;
 
     if(g_curMusic && Mix_PausedMusicStream(g_curMusic))
@@ -1034,7 +1354,7 @@ void ResumeMusic()
 
 void StopMusic()
 {
-    if(!musicPlaying || !g_mixerLoaded)
+    if(!musicPlaying || !g_mixerLoaded || RunAhead::hiddenFrame())
         return;
 
     pLogDebug("Stopping music");
@@ -1053,7 +1373,7 @@ void StopMusic()
 
 void FadeOutMusic(int ms)
 {
-    if(!musicPlaying || !g_mixerLoaded)
+    if(!musicPlaying || !g_mixerLoaded || RunAhead::hiddenFrame())
         return;
 
     pLogDebug("Fading out music");
@@ -1403,7 +1723,8 @@ void InitSound()
             statSfxDump++;
     }
 
-    pLogInfo("Loaded sound effects: dumped=%d; as music=%d", statSfxDump, statSfxAsMusic);
+    pLogInfo("Loaded sound effects: dumped=%d; as music=%d; unique decoded=%d (%lu KiB)",
+             statSfxDump, statSfxAsMusic, (int)s_sfxBank.size(), (unsigned long)(s_sfxBankBytes / 1024));
 }
 
 void UnloadSound()
@@ -1426,6 +1747,7 @@ void UnloadSound()
 
     sound.clear();
     music.clear();
+    s_sfxBankClear();
 }
 
 static const std::unordered_map<int, int> s_soundDelays =
@@ -1496,7 +1818,7 @@ static int getFallbackSfx(int A)
 
 void PlaySound(int A, int loops, int volume)
 {
-    if(!g_mixerLoaded)
+    if(!g_mixerLoaded || RunAhead::hiddenFrame())
         return;
 
     if(g_totalSounds == 0)
@@ -1530,7 +1852,7 @@ void PlaySound(int A, int loops, int volume)
 
 void PlaySoundSpatial(int A, int l, int t, int r, int b, int loops, int volume)
 {
-    if(!g_mixerLoaded)
+    if(!g_mixerLoaded || RunAhead::hiddenFrame())
         return;
 
     if(GameMenu || GameOutro) // || A == 26 || A == 27 || A == 29)
@@ -1568,7 +1890,7 @@ bool HasSound(int A)
 
 void PlaySoundMenu(int A, int loops)
 {
-    if(SoundPause[A] > 0) // if the sound wasn't just played
+    if(SoundPause[A] > 0 || RunAhead::hiddenFrame()) // if the sound wasn't just played
         return;
 
     if(g_totalSounds == 0 || A > (int)g_totalSounds)
@@ -1662,6 +1984,8 @@ void UnloadCustomSound()
     if(!g_mixerLoaded)
         return;
 
+    s_musicPrefetchReset();
+
     loadMusicIni(SoundScope::global, musicIni, true);
     restoreDefaultSfx();
     g_customMusicInDataFolder = false;
@@ -1672,7 +1996,7 @@ void UnloadCustomSound()
 
 void UpdateYoshiMusic()
 {
-    if(!s_musicHasYoshiMode || !g_mixerLoaded)
+    if(!s_musicHasYoshiMode || !g_mixerLoaded || RunAhead::hiddenFrame())
         return;
 
     bool hasYoshi = false;
@@ -1975,7 +2299,7 @@ void UpdateSoundFX(int recentSection)
 #ifndef THEXTECH_ENABLE_AUDIO_FX
     UNUSED(recentSection);
 #else
-    if(!g_mixerLoaded || LevelSelect)
+    if(!g_mixerLoaded || LevelSelect || RunAhead::hiddenFrame())
         return;
 
     SDL_assert_release(recentSection >= 0 && recentSection <= maxSections);
@@ -196,6 +196,8 @@ bool delayMusicIsSet();
 // play music
 void StartMusic(int A, int fadeInMs = 0);
 void StartMusicIfOnscreen(int section);
+// NEW: open the music of a section the player is about to enter in background, so that StartMusic() won't stall
+void PrefetchSectionMusic(int section);
 // Public Sub StopMusic() 'stop playing music
 void PauseMusic();
 void ResumeMusic();
@@ -0,0 +1,108 @@
+/*
+ * SIMD helpers for the sound effects
+ *
+ * Copyright (c) 2022-2026 Vitaly Novichkov <admin@wohlnet.ru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FX_SIMD_HPP
+#define FX_SIMD_HPP
+
+#include <stdint.h>
+
+/*
+ * Minimal 4-lane float vector wrapper used by the effect kernels.
+ * Define FX_NO_SIMD to force the plain scalar code paths.
+ *
+ * All loads and stores are unaligned: effect contexts are allocated by
+ * plain `new`, which doesn't guarantee 16-byte alignment on every target.
+ */
+
+#if !defined(FX_NO_SIMD)
+#   if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define FX_SIMD_SSE2
+#       include <emmintrin.h>
+#   elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#       define FX_SIMD_NEON
+#       include <arm_neon.h>
+#   endif
+#endif
+
+#if defined(FX_SIMD_SSE2) || defined(FX_SIMD_NEON)
+#   define FX_SIMD
+
+#   if defined(FX_SIMD_SSE2)
+typedef __m128 fx_v4;
+
+static inline fx_v4 fx_v4_load(const float *p)          { return _mm_loadu_ps(p); }
+static inline void  fx_v4_store(float *p, fx_v4 v)      { _mm_storeu_ps(p, v); }
+static inline fx_v4 fx_v4_set1(float v)                 { return _mm_set1_ps(v); }
+static inline fx_v4 fx_v4_zero()                        { return _mm_setzero_ps(); }
+static inline fx_v4 fx_v4_add(fx_v4 a, fx_v4 b)         { return _mm_add_ps(a, b); }
+static inline fx_v4 fx_v4_sub(fx_v4 a, fx_v4 b)         { return _mm_sub_ps(a, b); }
+static inline fx_v4 fx_v4_mul(fx_v4 a, fx_v4 b)         { return _mm_mul_ps(a, b); }
+
+//! [a, b, c, d] -> [0, a, b, c]
+static inline fx_v4 fx_v4_shift1(fx_v4 v)               { return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)); }
+//! [a, b, c, d] -> [0, 0, a, b]
+static inline fx_v4 fx_v4_shift2(fx_v4 v)               { return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)); }
+//! [a, b, c, d] -> [d, d, d, d]
+static inline fx_v4 fx_v4_splat3(fx_v4 v)               { return _mm_shuffle_ps(v, v, 0xFF); }
+static inline float fx_v4_lane0(fx_v4 v)                { return _mm_cvtss_f32(v); }
+
+//! Vector counterpart of `undenormalise()`: zero every lane whose exponent is zero
+static inline fx_v4 fx_v4_undenormalise(fx_v4 v)
+{
+    __m128i e = _mm_and_si128(_mm_castps_si128(v), _mm_set1_epi32(0x7f800000));
+    __m128i denormal = _mm_cmpeq_epi32(e, _mm_setzero_si128());
+    return _mm_andnot_ps(_mm_castsi128_ps(denormal), v);
+}
+
+#   else // FX_SIMD_NEON
+typedef float32x4_t fx_v4;
+
+static inline fx_v4 fx_v4_load(const float *p)          { return vld1q_f32(p); }
+static inline void  fx_v4_store(float *p, fx_v4 v)      { vst1q_f32(p, v); }
+static inline fx_v4 fx_v4_set1(float v)                 { return vdupq_n_f32(v); }
+static inline fx_v4 fx_v4_zero()                        { return vdupq_n_f32(0.0f); }
+static inline fx_v4 fx_v4_add(fx_v4 a, fx_v4 b)         { return vaddq_f32(a, b); }
+static inline fx_v4 fx_v4_sub(fx_v4 a, fx_v4 b)         { return vsubq_f32(a, b); }
+static inline fx_v4 fx_v4_mul(fx_v4 a, fx_v4 b)         { return vmulq_f32(a, b); }
+
+//! [a, b, c, d] -> [0, a, b, c]
+static inline fx_v4 fx_v4_shift1(fx_v4 v)               { return vextq_f32(vdupq_n_f32(0.0f), v, 3); }
+//! [a, b, c, d] -> [0, 0, a, b]
+static inline fx_v4 fx_v4_shift2(fx_v4 v)               { return vextq_f32(vdupq_n_f32(0.0f), v, 2); }
+//! [a, b, c, d] -> [d, d, d, d]
+static inline fx_v4 fx_v4_splat3(fx_v4 v)               { return vdupq_lane_f32(vget_high_f32(v), 1); }
+static inline float fx_v4_lane0(fx_v4 v)                { return vgetq_lane_f32(v, 0); }
+
+//! Vector counterpart of `undenormalise()`: zero every lane whose exponent is zero
+static inline fx_v4 fx_v4_undenormalise(fx_v4 v)
+{
+    uint32x4_t bits = vreinterpretq_u32_f32(v);
+    uint32x4_t denormal = vceqq_u32(vandq_u32(bits, vdupq_n_u32(0x7f800000)), vdupq_n_u32(0));
+    return vreinterpretq_f32_u32(vbicq_u32(bits, denormal));
+}
+#   endif
+
+#endif // FX_SIMD_SSE2 || FX_SIMD_NEON
+
+#endif // FX_SIMD_HPP
@@ -23,12 +23,14 @@
  */
 
 #include <cstddef>
+#include <algorithm>
 #include <vector>
 #include <deque>
 #include <cmath>
 #include <tgmath.h>
 #include "reverb.h"
 #include "fx_common.hpp"
+#include "fx_simd.hpp"
 
 
 // Code was taken from FreeVerb: https://github.com/sinshu/freeverb (Public Domain)
@@ -54,6 +56,8 @@ const float initialwidth    = 1;
 const float initialmode     = 0;
 const float freezemode      = 0.5f;
 const int   stereospread    = 23;
+// Filters are run over blocks of at most this many samples
+const int   maxblocksize    = 256;
 
 // These values assume 44.1KHz sample rate
 // they will probably be OK for 48KHz sample rate
@@ -106,6 +110,8 @@ public:
     {
         buffer = buf;
         bufsize = size;
+        if(bufidx >= bufsize)
+            bufidx = 0;
     }
 
     // Big to inline - but crucial for speed
@@ -126,6 +132,27 @@ public:
         return output;
     }
 
+#ifdef FX_SIMD
+    // Process a block of samples and add the comb output to the accumulator.
+    // The block must not be longer than the buffer: every sample read here
+    // must have been written before the block.
+    inline void processblock(const float* input, float* accum, int numsamples)
+    {
+        while(numsamples > 0)
+        {
+            int run = bufsize - bufidx;
+            if(run > numsamples)
+                run = numsamples;
+
+            processrun(input, accum, run);
+
+            input += run;
+            accum += run;
+            numsamples -= run;
+        }
+    }
+#endif
+
     void mute()
     {
         for(int i = 0; i < bufsize; i++)
@@ -153,7 +180,51 @@ public:
         return feedback;
     }
 
+    int getbufsize()
+    {
+        return bufsize;
+    }
+
 private:
+#ifdef FX_SIMD
+    inline void processrun(const float* input, float* accum, int numsamples)
+    {
+        // The one-pole lowpass is computed four samples at once as a prefix sum:
+        // fs[n] = x[n] + d*x[n-1] + d^2*x[n-2] + d^3*x[n-3] + d^4*fs[n-4]
+        const float dpow[4] = {damp1, damp1 * damp1, damp1 * damp1 * damp1, damp1 * damp1 * damp1 * damp1};
+        const fx_v4 vdamp1 = fx_v4_set1(damp1);
+        const fx_v4 vdamp1sq = fx_v4_set1(dpow[1]);
+        const fx_v4 vdamp2 = fx_v4_set1(damp2);
+        const fx_v4 vdpow = fx_v4_load(dpow);
+        const fx_v4 vfeedback = fx_v4_set1(feedback);
+        fx_v4 vstore = fx_v4_set1(filterstore);
+        float* buf = buffer + bufidx;
+        int i = 0;
+
+        for(; i + 4 <= numsamples; i += 4)
+        {
+            fx_v4 output = fx_v4_undenormalise(fx_v4_load(buf + i));
+            fx_v4 x = fx_v4_mul(output, vdamp2);
+            x = fx_v4_add(x, fx_v4_mul(fx_v4_shift1(x), vdamp1));
+            x = fx_v4_add(x, fx_v4_mul(fx_v4_shift2(x), vdamp1sq));
+            x = fx_v4_undenormalise(fx_v4_add(x, fx_v4_mul(vstore, vdpow)));
+            vstore = fx_v4_splat3(x);
+
+            fx_v4_store(buf + i, fx_v4_add(fx_v4_load(input + i), fx_v4_mul(x, vfeedback)));
+            fx_v4_store(accum + i, fx_v4_add(fx_v4_load(accum + i), output));
+        }
+
+        filterstore = fx_v4_lane0(vstore);
+
+        bufidx += i;
+        if(bufidx >= bufsize)
+            bufidx = 0;
+
+        for(; i < numsamples; i++)
+            accum[i] += process(input[i]);
+    }
+#endif
+
     float   feedback = 0.f;
     float   filterstore = 0.f;
     float   damp1 = 0.f;
@@ -176,24 +247,24 @@ public:
     {
         buffer = buf;
         bufsize = size;
+        if(bufidx >= bufsize)
+            bufidx = 0;
     }
 
-    // Big to inline - but crucial for speed
-    inline float process(float input)
+    // Process a block of samples in place, same length limit as for the comb
+    inline void processblock(float* io, int numsamples)
     {
-        float output;
-        float bufout;
-
-        bufout = buffer[bufidx];
-        undenormalise(bufout);
-
-        output = -input + bufout;
-        buffer[bufidx] = input + (bufout * feedback);
+        while(numsamples > 0)
+        {
+            int run = bufsize - bufidx;
+            if(run > numsamples)
+                run = numsamples;
 
-        if(++bufidx >= bufsize)
-            bufidx = 0;
+            processrun(io, run);
 
-        return output;
+            io += run;
+            numsamples -= run;
+        }
     }
 
     void mute()
@@ -212,7 +283,42 @@ public:
         return feedback;
     }
 
-    // private:
+private:
+    // Big to inline - but crucial for speed
+    inline void processrun(float* io, int numsamples)
+    {
+        float* buf = buffer + bufidx;
+        int i = 0;
+
+#ifdef FX_SIMD
+        const fx_v4 vfeedback = fx_v4_set1(feedback);
+
+        for(; i + 4 <= numsamples; i += 4)
+        {
+            fx_v4 input = fx_v4_load(io + i);
+            fx_v4 bufout = fx_v4_undenormalise(fx_v4_load(buf + i));
+
+            fx_v4_store(io + i, fx_v4_sub(bufout, input));
+            fx_v4_store(buf + i, fx_v4_add(input, fx_v4_mul(bufout, vfeedback)));
+        }
+#endif
+
+        for(; i < numsamples; i++)
+        {
+            float input = io[i];
+            float bufout = buf[i];
+            undenormalise(bufout);
+
+            io[i] = -input + bufout;
+            buf[i] = input + (bufout * feedback);
+        }
+
+        bufidx += numsamples;
+        if(bufidx >= bufsize)
+            bufidx = 0;
+    }
+
+public:
     float   feedback = 0.f;
     float*  buffer = nullptr;
     int     bufsize = 0;
@@ -223,6 +329,7 @@ public:
 class revmodel
 {
     double rateScale = 1.0;
+    int    blocksize = 1;
 
 public:
     void setSampleRate(int rate)
@@ -279,6 +386,23 @@ public:
         allpassR[2].setbuffer(bufallpassR3.data(), static_cast<int>(bufallpassR3.size()));
         allpassL[3].setbuffer(bufallpassL4.data(), static_cast<int>(bufallpassL4.size()));
         allpassR[3].setbuffer(bufallpassR4.data(), static_cast<int>(bufallpassR4.size()));
+
+        // The shortest delay line limits the block length
+        blocksize = maxblocksize;
+        for(int i = 0; i < numcombs; i++)
+        {
+            blocksize = std::min(blocksize, combL[i].getbufsize());
+            blocksize = std::min(blocksize, combR[i].getbufsize());
+        }
+
+        for(int i = 0; i < numallpasses; i++)
+        {
+            blocksize = std::min(blocksize, allpassL[i].bufsize);
+            blocksize = std::min(blocksize, allpassR[i].bufsize);
+        }
+
+        if(blocksize < 1)
+            blocksize = 1;
     }
 
     revmodel()
@@ -323,72 +447,12 @@ public:
 
     void processmix(float* inputL, float* inputR, float* outputL, float* outputR, long numsamples, int skip)
     {
-        float outL, outR, input;
-
-        while(numsamples-- > 0)
-        {
-            outL = outR = 0;
-            input = (*inputL + *inputR) * gain;
-
-            // Accumulate comb filters in parallel
-            for(int i = 0; i < numcombs; i++)
-            {
-                outL += combL[i].process(input);
-                outR += combR[i].process(input);
-            }
-
-            // Feed through allpasses in series
-            for(int i = 0; i < numallpasses; i++)
-            {
-                outL = allpassL[i].process(outL);
-                outR = allpassR[i].process(outR);
-            }
-
-            // Calculate output MIXING with anything already there
-            *outputL += outL * wet1 + outR * wet2 + *inputL * dry;
-            *outputR += outR * wet1 + outL * wet2 + *inputR * dry;
-
-            // Increment sample pointers, allowing for interleave (if any)
-            inputL += skip;
-            inputR += skip;
-            outputL += skip;
-            outputR += skip;
-        }
+        process(inputL, inputR, outputL, outputR, numsamples, skip, true);
     }
 
     void processreplace(float* inputL, float* inputR, float* outputL, float* outputR, long numsamples, int skip)
     {
-        float outL, outR, input;
-
-        while(numsamples-- > 0)
-        {
-            outL = outR = 0;
-            input = (*inputL + *inputR) * gain;
-
-            // Accumulate comb filters in parallel
-            for(int i = 0; i < numcombs; i++)
-            {
-                outL += combL[i].process(input);
-                outR += combR[i].process(input);
-            }
-
-            // Feed through allpasses in series
-            for(int i = 0; i < numallpasses; i++)
-            {
-                outL = allpassL[i].process(outL);
-                outR = allpassR[i].process(outR);
-            }
-
-            // Calculate output REPLACING anything already there
-            *outputL = outL * wet1 + outR * wet2 + *inputL * dry;
-            *outputR = outR * wet1 + outL * wet2 + *inputR * dry;
-
-            // Increment sample pointers, allowing for interleave (if any)
-            inputL += skip;
-            inputR += skip;
-            outputL += skip;
-            outputR += skip;
-        }
+        process(inputL, inputR, outputL, outputR, numsamples, skip, false);
     }
 
 
@@ -466,6 +530,77 @@ public:
     }
 
 private:
+    void process(float* inputL, float* inputR, float* outputL, float* outputR, long numsamples, int skip, bool mix)
+    {
+        float input[maxblocksize];
+        float outL[maxblocksize];
+        float outR[maxblocksize];
+
+        while(numsamples > 0)
+        {
+            int n = numsamples < blocksize ? static_cast<int>(numsamples) : blocksize;
+
+            for(int i = 0; i < n; i++)
+            {
+                input[i] = (inputL[i * skip] + inputR[i * skip]) * gain;
+                outL[i] = outR[i] = 0;
+            }
+
+            // Accumulate comb filters in parallel
+#ifdef FX_SIMD
+            for(int i = 0; i < numcombs; i++)
+            {
+                combL[i].processblock(input, outL, n);
+                combR[i].processblock(input, outR, n);
+            }
+#else
+            // Sample by sample: the filter state of a comb is a serial dependency,
+            // going through all combs at every sample keeps them running in parallel
+            for(int j = 0; j < n; j++)
+            {
+                for(int i = 0; i < numcombs; i++)
+                {
+                    outL[j] += combL[i].process(input[j]);
+                    outR[j] += combR[i].process(input[j]);
+                }
+            }
+#endif
+
+            // Feed through allpasses in series
+            for(int i = 0; i < numallpasses; i++)
+            {
+                allpassL[i].processblock(outL, n);
+                allpassR[i].processblock(outR, n);
+            }
+
+            for(int i = 0; i < n; i++)
+            {
+                float l = outL[i] * wet1 + outR[i] * wet2 + *inputL * dry;
+                float r = outR[i] * wet1 + outL[i] * wet2 + *inputR * dry;
+
+                // Calculate output MIXING with anything already there or REPLACING it
+                if(mix)
+                {
+                    *outputL += l;
+                    *outputR += r;
+                }
+                else
+                {
+                    *outputL = l;
+                    *outputR = r;
+                }
+
+                // Increment sample pointers, allowing for interleave (if any)
+                inputL += skip;
+                inputR += skip;
+                outputL += skip;
+                outputR += skip;
+            }
+
+            numsamples -= n;
+        }
+    }
+
     void update()
     {
         // Recalculate internal values after parameter change
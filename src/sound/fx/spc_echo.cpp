@@ -75,9 +75,10 @@ typedef struct SpcEcho
     int is_valid = 0;
     float echo_ram[ECHO_BUFFER_SIZE];
 
-    // Echo history keeps most recent 8 samples (twice the size to simplify wrap handling)
-    float echo_hist[ECHO_HIST_SIZE * 2 * MAX_CHANNELS][MAX_CHANNELS];
-    float (*echo_hist_pos)[MAX_CHANNELS] = echo_hist; // &echo_hist [0 to 7]
+    // Echo history keeps most recent 8 samples per channel (twice the size to simplify wrap handling),
+    // the 8 FIR taps of a channel are always contiguous starting from echo_hist[c][echo_hist_pos + 1]
+    float echo_hist[MAX_CHANNELS][ECHO_HIST_SIZE * 2];
+    int   echo_hist_pos = 0; // [0 to 7]
 
     //! offset from ESA in echo buffer
     int echo_offset = 0;
@@ -108,6 +109,8 @@ typedef struct SpcEcho
     //! $xf rw FFCx - Echo FIR Filter Coefficient (FFC) X
     int8_t reg_fir[8] = {0, 0, 0, 0, 0, 0, 0, 0};
     int8_t reg_fir_resampled[8];
+    //! Resampled FIR coefficients converted to float for the filter kernel
+    float fir_coef[8] = {0, 0, 0, 0, 0, 0, 0, 0};
 
     void recomputeFirResampled()
     {
@@ -117,6 +120,31 @@ typedef struct SpcEcho
         {
             double newFactor = y_factor2 + ((y_factor1 - y_factor2) / (0.0 - 7.0)) * (i - 7.0);
             reg_fir_resampled[i] = (int8_t)(reg_fir[i] * (1.0 + ((newFactor - 1.0) / 100.0)));
+            fir_coef[i] = (float)reg_fir_resampled[i];
+        }
+    }
+
+    //! Store the new echo samples into the history and apply the 8-tap FIR to every channel
+    inline void firFilter(float *echo_in)
+    {
+        int c;
+        float *echohist;
+
+        for(c = 0; c < channels; c++)
+        {
+            echohist = echo_hist[c];
+            echohist[echo_hist_pos] = echohist[echo_hist_pos + ECHO_HIST_SIZE] = echo_in[c];
+        }
+
+        // Taps 0...6 are the previous samples, tap 7 is the sample just stored.
+        // Contiguous taps let the compiler vectorize or pipeline this loop on its own:
+        // an explicit SSE2 dot product with a horizontal sum per channel measured slower.
+        for(c = 0; c < channels; c++)
+        {
+            echohist = echo_hist[c] + echo_hist_pos + 1;
+            echo_in[c] = echohist[7] * fir_coef[7];
+            for(int f = 0; f <= 6; ++f)
+                echo_in[c] += echohist[f] * fir_coef[f];
         }
     }
 
@@ -165,6 +193,7 @@ typedef struct SpcEcho
 
         memset(echo_ram, 0, sizeof(echo_ram));
         memset(echo_hist, 0, sizeof(echo_hist));
+        echo_hist_pos = 0;
         memset(reg_fir_resampled, 0, sizeof(reg_fir_resampled));
 
         if(!initFormat(readSample, writeSample, sample_size, format))
@@ -190,13 +219,12 @@ typedef struct SpcEcho
         int c;
         float ov;
 
-        int f, e_offset;
+        int e_offset;
         float v;
 
         float mvoll[2] = {(float)reg_mvoll, (float)reg_mvolr};
         float evoll[2] = {(float)reg_evoll, (float)reg_evolr};
 
-        float (*echohist_pos)[MAX_CHANNELS];
         float *echo_ptr;
 
         memset(main_out, 0, sizeof(main_out));
@@ -231,23 +259,11 @@ typedef struct SpcEcho
             for(c = 0; c < channels; c++)
                 echo_in[c] = echo_ptr[c];
 
-            echohist_pos = echo_hist_pos;
-            if(++echohist_pos >= &echo_hist[ECHO_HIST_SIZE])
-                echohist_pos = echo_hist;
-            echo_hist_pos = echohist_pos;
+            if(++echo_hist_pos >= ECHO_HIST_SIZE)
+                echo_hist_pos = 0;
 
             /* --------------- FIR filter-------------- */
-            for(c = 0; c < channels; c++)
-                echohist_pos[0][c] = echohist_pos[8][c] = echo_in[c];
-
-            for(c = 0; c < channels; ++c)
-                echo_in[c] *= reg_fir_resampled[7];
-
-            for(f = 0; f <= 6; ++f)
-            {
-                for(c = 0; c < channels; ++c)
-                    echo_in[c] += echo_hist_pos[f + 1][c] * reg_fir_resampled[f];
-            }
+            firFilter(echo_in);
             /* ---------------------------------------- */
 
             /* Echo out */
@@ -18,12 +18,11 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <vector>
 #include <cstdint>
-#include <exception>
 
 #include <SDL2/SDL_thread.h>
 #include <SDL2/SDL_mutex.h>
+#include <SDL2/SDL_atomic.h>
 
 #include "sound.h"
 #include "config.h"
@@ -39,45 +38,103 @@ struct EnqueuedSfx_t
     uint8_t right;
 };
 
-static std::vector<EnqueuedSfx_t> s_sfx_queue;
+//! capacity of the ring between the game thread and the SFX thread, must be a power of two
+static constexpr unsigned c_sfx_ring_size = 256;
+static constexpr unsigned c_sfx_ring_mask = c_sfx_ring_size - 1;
+//! ring positions are free-running counters wrapped at this mask
+static constexpr unsigned c_sfx_pos_mask = 0x3FFFFFFF;
+//! maximum number of distinct sounds in one frame before the batch gets flushed early
+static constexpr int c_sfx_batch_size = 64;
+
+// single-producer / single-consumer ring: the game thread only writes the head, the SFX thread only writes the tail
+static EnqueuedSfx_t s_sfx_ring[c_sfx_ring_size];
+static SDL_atomic_t  s_sfx_ring_head = {};
+static SDL_atomic_t  s_sfx_ring_tail = {};
+
+// sounds of the current frame, coalesced before being published to the ring (game thread only)
+static EnqueuedSfx_t s_sfx_batch[c_sfx_batch_size];
+static int           s_sfx_batch_count = 0;
+static bool          s_sfx_batching = false;
+
+static SfxQueueStats_t s_sfx_stats;
 
 static SDL_Thread* s_sound_thread = nullptr;
-static SDL_mutex*  s_sound_thread_mutex = nullptr;
-static SDL_cond*   s_sound_thread_cond = nullptr;
+static SDL_sem*    s_sound_thread_sem = nullptr;
 
-static bool        s_sound_thread_quit = false;
+static SDL_atomic_t s_sound_thread_quit = {};
 
-static int s_sound_thread_main(void*)
+static inline unsigned s_ring_depth(unsigned head, unsigned tail)
 {
-    static std::vector<EnqueuedSfx_t> s_sfx_queue_pop;
-    s_sfx_queue_pop.clear();
+    return (head - tail) & c_sfx_pos_mask;
+}
 
+static int s_sound_thread_main(void*)
+{
     while(true)
     {
-        // load state from the main thread
-        SDL_LockMutex(s_sound_thread_mutex);
+        SDL_SemWait(s_sound_thread_sem);
 
-        if(!s_sound_thread_quit && s_sfx_queue.empty())
-            SDL_CondWait(s_sound_thread_cond, s_sound_thread_mutex);
+        if(SDL_AtomicGet(&s_sound_thread_quit))
+            break;
 
-        bool quit = s_sound_thread_quit;
-        std::swap(s_sfx_queue, s_sfx_queue_pop);
+        unsigned tail = (unsigned)SDL_AtomicGet(&s_sfx_ring_tail);
+        unsigned head = (unsigned)SDL_AtomicGet(&s_sfx_ring_head);
 
-        SDL_UnlockMutex(s_sound_thread_mutex);
+        // execute SFX queue
+        while(tail != head)
+        {
+            EnqueuedSfx_t sfx = s_sfx_ring[tail & c_sfx_ring_mask];
+            tail = (tail + 1) & c_sfx_pos_mask;
 
-        if(quit)
-            break;
+            // release the slot before playing, the mixer may take a while
+            SDL_AtomicSet(&s_sfx_ring_tail, (int)tail);
 
-        // execute SFX queue
-        for(const EnqueuedSfx_t& sfx : s_sfx_queue_pop)
             PlaySfx_Blocking(sfx.Alias, sfx.loops, sfx.volume, sfx.left, sfx.right);
-
-        s_sfx_queue_pop.clear();
+        }
     }
 
     return 0;
 }
 
+void BeginSfxBatch()
+{
+    s_sfx_batching = true;
+}
+
+void FlushSfx()
+{
+    s_sfx_batching = false;
+
+    if(!s_sound_thread || s_sfx_batch_count == 0)
+        return;
+
+    unsigned head = (unsigned)SDL_AtomicGet(&s_sfx_ring_head);
+    unsigned tail = (unsigned)SDL_AtomicGet(&s_sfx_ring_tail);
+    unsigned depth = s_ring_depth(head, tail);
+
+    for(int i = 0; i < s_sfx_batch_count; i++)
+    {
+        if(depth >= c_sfx_ring_size)
+        {
+            s_sfx_stats.dropped += s_sfx_batch_count - i;
+            break;
+        }
+
+        s_sfx_ring[head & c_sfx_ring_mask] = s_sfx_batch[i];
+        head = (head + 1) & c_sfx_pos_mask;
+        depth++;
+    }
+
+    s_sfx_batch_count = 0;
+
+    if((int)depth > s_sfx_stats.peak_depth)
+        s_sfx_stats.peak_depth = (int)depth;
+
+    // publish the whole batch at once and wake the SFX thread
+    SDL_AtomicSet(&s_sfx_ring_head, (int)head);
+    SDL_SemPost(s_sound_thread_sem);
+}
+
 void PlaySfx(int Alias, int loops, int volume, uint8_t left, uint8_t right)
 {
     if((int)g_config.audio_sfx_volume == 0 || XMessage::GetStatus() == XMessage::Status::replay)
@@ -89,37 +146,61 @@ void PlaySfx(int Alias, int loops, int volume, uint8_t left, uint8_t right)
         return;
     }
 
-    SDL_LockMutex(s_sound_thread_mutex);
-
-    try
+    // one-shot sounds played several times in the same frame are merged into a single louder one
+    if(loops == 0)
     {
-        s_sfx_queue.push_back(EnqueuedSfx_t{Alias, (uint8_t)loops, (uint8_t)volume, left, right});
+        for(int i = 0; i < s_sfx_batch_count; i++)
+        {
+            EnqueuedSfx_t& e = s_sfx_batch[i];
+
+            if(e.Alias != Alias || e.loops != 0)
+                continue;
+
+            int v = e.volume + volume;
+            e.volume = (uint8_t)((v > 128) ? 128 : v);
+
+            if(left > e.left)
+                e.left = left;
+            if(right > e.right)
+                e.right = right;
+
+            s_sfx_stats.coalesced++;
+            return;
+        }
     }
-    catch(...)
+
+    if(s_sfx_batch_count == c_sfx_batch_size)
     {
-        SDL_UnlockMutex(s_sound_thread_mutex);
+        FlushSfx();
+        s_sfx_batching = true;
+    }
 
-        std::exception_ptr e = std::current_exception();
+    s_sfx_batch[s_sfx_batch_count++] = EnqueuedSfx_t{Alias, (uint8_t)loops, (uint8_t)volume, left, right};
 
-        if(e)
-            std::rethrow_exception(e);
-    }
+    // outside of a frame, pass the sound immediately
+    if(!s_sfx_batching)
+        FlushSfx();
+}
 
-    SDL_UnlockMutex(s_sound_thread_mutex);
-    SDL_CondSignal(s_sound_thread_cond);
+void GetSfxQueueStats(SfxQueueStats_t& out)
+{
+    out = s_sfx_stats;
+    out.depth = (int)s_ring_depth((unsigned)SDL_AtomicGet(&s_sfx_ring_head), (unsigned)SDL_AtomicGet(&s_sfx_ring_tail));
 }
 
 void StartSfxThread()
 {
     EndSfxThread();
 
-    s_sound_thread_mutex = SDL_CreateMutex();
-    if(!s_sound_thread_mutex)
+    s_sound_thread_sem = SDL_CreateSemaphore(0);
+    if(!s_sound_thread_sem)
         return;
 
-    s_sound_thread_cond = SDL_CreateCond();
-    if(!s_sound_thread_cond)
-        return;
+    SDL_AtomicSet(&s_sfx_ring_head, 0);
+    SDL_AtomicSet(&s_sfx_ring_tail, 0);
+    SDL_AtomicSet(&s_sound_thread_quit, 0);
+    s_sfx_batch_count = 0;
+    s_sfx_stats = SfxQueueStats_t();
 
     s_sound_thread = SDL_CreateThread(s_sound_thread_main, "SFX thread", nullptr);
 }
@@ -128,25 +209,23 @@ void EndSfxThread()
 {
     if(s_sound_thread)
     {
-        SDL_LockMutex(s_sound_thread_mutex);
-        s_sound_thread_quit = true;
-        SDL_UnlockMutex(s_sound_thread_mutex);
-        SDL_CondSignal(s_sound_thread_cond);
+        // play whatever is left of the current frame
+        FlushSfx();
+
+        SDL_AtomicSet(&s_sound_thread_quit, 1);
+        SDL_SemPost(s_sound_thread_sem);
 
         SDL_WaitThread(s_sound_thread, nullptr);
         s_sound_thread = nullptr;
-        s_sound_thread_quit = false;
+        SDL_AtomicSet(&s_sound_thread_quit, 0);
     }
 
-    if(s_sound_thread_cond)
-    {
-        SDL_DestroyCond(s_sound_thread_cond);
-        s_sound_thread_cond = nullptr;
-    }
+    s_sfx_batch_count = 0;
+    s_sfx_batching = false;
 
-    if(s_sound_thread_mutex)
+    if(s_sound_thread_sem)
     {
-        SDL_DestroyMutex(s_sound_thread_mutex);
-        s_sound_thread_mutex = nullptr;
+        SDL_DestroySemaphore(s_sound_thread_sem);
+        s_sound_thread_sem = nullptr;
     }
 }
@@ -24,10 +24,25 @@
 
 #include <stdint.h>
 
+struct SfxQueueStats_t
+{
+    //! sounds currently waiting for the SFX thread
+    int depth = 0;
+    //! maximum number of waiting sounds since the thread start
+    int peak_depth = 0;
+    //! sounds dropped because the queue was full
+    uint32_t dropped = 0;
+    //! sounds merged into the same sound played earlier in the same frame
+    uint32_t coalesced = 0;
+};
+
 #ifndef THEXTECH_NO_SDL_BUILD
 
 /**
- * @brief Enqueues the SFX but does not block
+ * @brief Adds the SFX to the batch of the current frame but does not block
+ *
+ * Must only be called from the game thread. Between BeginSfxBatch() and FlushSfx() the sounds
+ * are collected into a batch, otherwise they are passed to the SFX thread immediately
  * @param Alias The alias of the sound
  * @param loops Number loops to play (n-1 value. When -1 - loop forever)
  * @param volume The volume level between 0 and 128
@@ -36,6 +51,22 @@
  */
 void PlaySfx(int Alias, int loops = 0, int volume = 128, uint8_t left = 255, uint8_t right = 255);
 
+/**
+ * @brief Starts collecting the sounds of the current frame into a single batch
+ */
+void BeginSfxBatch();
+
+/**
+ * @brief Passes the sounds batched during the current frame to the SFX thread and ends the batch
+ */
+void FlushSfx();
+
+/**
+ * @brief Retrieves the SFX queue counters
+ * @param out Counters
+ */
+void GetSfxQueueStats(SfxQueueStats_t& out);
+
 /**
  * @brief Starts sound thread
  */
@@ -51,6 +82,9 @@ void EndSfxThread();
 // fallback: just call directly
 #define PlaySfx PlaySfx_Blocking
 
+static inline void BeginSfxBatch() {}
+static inline void FlushSfx() {}
+static inline void GetSfxQueueStats(SfxQueueStats_t& out) { out = SfxQueueStats_t(); }
 static inline void StartSfxThread() {}
 static inline void EndSfxThread() {}
 
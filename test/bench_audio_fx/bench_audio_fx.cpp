@@ -0,0 +1,221 @@
+/*
+ * Benchmark of the real-time audio effects
+ *
+ * Runs the reverb and the SPC echo over a synthetic stereo F32 stream and
+ * reports the throughput. The processed output can be dumped into a file
+ * and compared against another build (for example, scalar vs. vectorized).
+ *
+ * Usage: BenchAudioFx [--seconds N] [--rate HZ] [--repeat N] [--dump FILE] [--compare FILE] [--tolerance T]
+ *
+ * The best time of all repeats is reported.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <vector>
+
+#include "sound/fx/reverb.h"
+#include "sound/fx/spc_echo.h"
+
+static const int s_channels = 2;
+static const int s_blockFrames = 1024;
+
+struct FxBench_t
+{
+    const char *name;
+    void *(*init)(int rate);
+    void (*process)(void *ctx, float *block, int len);
+    void (*free)(void *ctx);
+};
+
+static void *s_reverbInit(int rate)
+{
+    return reverbEffectInit(rate, AUDIO_F32, s_channels);
+}
+
+static void s_reverbProcess(void *ctx, float *block, int len)
+{
+    reverbEffect(0, block, len, ctx);
+}
+
+static void s_reverbFree(void *ctx)
+{
+    reverbEffectFree(reinterpret_cast<FxReverb *>(ctx));
+}
+
+static void *s_echoInit(int rate)
+{
+    return echoEffectInit(rate, AUDIO_F32, s_channels);
+}
+
+static void s_echoProcess(void *ctx, float *block, int len)
+{
+    spcEchoEffect(0, block, len, ctx);
+}
+
+static void s_echoFree(void *ctx)
+{
+    echoEffectFree(reinterpret_cast<SpcEcho *>(ctx));
+}
+
+static const FxBench_t s_effects[] =
+{
+    {"reverb", s_reverbInit, s_reverbProcess, s_reverbFree},
+    {"spc-echo", s_echoInit, s_echoProcess, s_echoFree},
+};
+
+// A couple of tones with some deterministic noise and silent gaps (to exercise denormals)
+static void s_fillSignal(std::vector<float> &out, int rate, int frames)
+{
+    const double pi = 3.14159265358979323846;
+    uint32_t seed = 0x12345678;
+
+    out.resize((size_t)frames * s_channels);
+
+    for(int i = 0; i < frames; ++i)
+    {
+        bool silent = (i / rate) % 4 == 3;
+        double t = (double)i / rate;
+
+        seed = seed * 1664525u + 1013904223u;
+        float noise = ((float)(seed >> 8) / (float)(1 << 24) - 0.5f) * 0.05f;
+
+        float l = (float)(0.3 * std::sin(2.0 * pi * 440.0 * t) + 0.1 * std::sin(2.0 * pi * 1320.0 * t)) + noise;
+        float r = (float)(0.3 * std::sin(2.0 * pi * 660.0 * t) + 0.1 * std::sin(2.0 * pi * 110.0 * t)) - noise;
+
+        out[(size_t)i * 2 + 0] = silent ? 0.0f : l;
+        out[(size_t)i * 2 + 1] = silent ? 0.0f : r;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 10.0;
+    int rate = 44100;
+    int repeat = 3;
+    double tolerance = 1e-4;
+    const char *dumpPath = nullptr;
+    const char *comparePath = nullptr;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+
+        if(!std::strcmp(argv[i], "--seconds") && hasValue)
+            seconds = std::atof(argv[++i]);
+        else if(!std::strcmp(argv[i], "--rate") && hasValue)
+            rate = std::atoi(argv[++i]);
+        else if(!std::strcmp(argv[i], "--repeat") && hasValue)
+            repeat = std::atoi(argv[++i]);
+        else if(!std::strcmp(argv[i], "--tolerance") && hasValue)
+            tolerance = std::atof(argv[++i]);
+        else if(!std::strcmp(argv[i], "--dump") && hasValue)
+            dumpPath = argv[++i];
+        else if(!std::strcmp(argv[i], "--compare") && hasValue)
+            comparePath = argv[++i];
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--seconds N] [--rate HZ] [--repeat N] [--dump FILE] [--compare FILE] [--tolerance T]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    int frames = (int)(seconds * rate);
+    if(frames < s_blockFrames)
+        frames = s_blockFrames;
+    frames -= frames % s_blockFrames;
+
+    if(repeat < 1)
+        repeat = 1;
+
+    std::vector<float> input;
+    s_fillSignal(input, rate, frames);
+
+    const size_t numEffects = sizeof(s_effects) / sizeof(s_effects[0]);
+    std::vector<float> output;
+    output.reserve(input.size() * numEffects);
+
+    for(size_t e = 0; e < numEffects; ++e)
+    {
+        const FxBench_t &fx = s_effects[e];
+        const int blockLen = s_blockFrames * s_channels * (int)sizeof(float);
+        std::vector<float> stream;
+        double elapsed = 0.0;
+
+        // Every repeat starts from a fresh context, so the output is the same each time
+        for(int r = 0; r < repeat; ++r)
+        {
+            stream = input;
+            void *ctx = fx.init(rate);
+
+            auto start = std::chrono::steady_clock::now();
+
+            for(int f = 0; f < frames; f += s_blockFrames)
+                fx.process(ctx, stream.data() + (size_t)f * s_channels, blockLen);
+
+            auto end = std::chrono::steady_clock::now();
+            fx.free(ctx);
+
+            double t = std::chrono::duration<double>(end - start).count();
+            if(r == 0 || t < elapsed)
+                elapsed = t;
+        }
+
+        if(elapsed <= 0.0)
+            elapsed = 1e-9;
+
+        std::printf("%-10s %12.0f samples/sec  (%.1fx realtime)\n",
+                    fx.name,
+                    (double)frames * s_channels / elapsed,
+                    (double)frames / rate / elapsed);
+
+        output.insert(output.end(), stream.begin(), stream.end());
+    }
+
+    if(dumpPath)
+    {
+        FILE *f = std::fopen(dumpPath, "wb");
+        if(!f || std::fwrite(output.data(), sizeof(float), output.size(), f) != output.size())
+        {
+            std::fprintf(stderr, "Failed to write %s\n", dumpPath);
+            if(f)
+                std::fclose(f);
+            return 1;
+        }
+
+        std::fclose(f);
+    }
+
+    if(comparePath)
+    {
+        std::vector<float> reference(output.size());
+        FILE *f = std::fopen(comparePath, "rb");
+        size_t got = f ? std::fread(reference.data(), sizeof(float), reference.size(), f) : 0;
+        if(f)
+            std::fclose(f);
+
+        if(got != reference.size())
+        {
+            std::fprintf(stderr, "Reference %s is missing or has a different length\n", comparePath);
+            return 1;
+        }
+
+        double maxDiff = 0.0;
+        for(size_t i = 0; i < output.size(); ++i)
+        {
+            double d = std::fabs((double)output[i] - (double)reference[i]);
+            if(d > maxDiff)
+                maxDiff = d;
+        }
+
+        std::printf("max difference from the reference: %g (tolerance %g)\n", maxDiff, tolerance);
+
+        if(maxDiff > tolerance)
+            return 1;
+    }
+
+    return 0;
+}